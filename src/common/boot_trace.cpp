@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/boot_trace.h"
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+
+namespace Common::BootTrace {
+
+namespace {
+
+struct Event {
+    const char* name;
+    char phase;
+    s64 timestamp_us;
+    s64 duration_us;
+    u32 thread_id;
+};
+
+struct State {
+    std::mutex mutex;
+    std::atomic_bool is_active{false};
+    std::chrono::steady_clock::time_point origin;
+    std::filesystem::path output_path;
+    std::vector<Event> events;
+};
+
+State& GetState() {
+    static State state;
+    return state;
+}
+
+s64 GetTimestampUs(const State& state) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                 state.origin)
+        .count();
+}
+
+// Small sequential ids read better in trace viewers than native thread handles
+u32 GetThreadId() {
+    static std::atomic<u32> next_thread_id{1};
+    thread_local const u32 thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+    return thread_id;
+}
+
+void AddEvent(const Event& event) {
+    auto& state = GetState();
+    std::scoped_lock lk{state.mutex};
+    if (state.is_active) {
+        state.events.push_back(event);
+    }
+}
+
+} // Anonymous namespace
+
+void Start(const std::filesystem::path& output_path) {
+    auto& state = GetState();
+    std::scoped_lock lk{state.mutex};
+    if (state.is_active) {
+        return;
+    }
+    state.origin = std::chrono::steady_clock::now();
+    state.output_path = output_path;
+    state.events.clear();
+    state.is_active = true;
+}
+
+void Finish() {
+    auto& state = GetState();
+    std::vector<Event> events;
+    std::filesystem::path output_path;
+    {
+        std::scoped_lock lk{state.mutex};
+        if (!state.is_active) {
+            return;
+        }
+        state.is_active = false;
+        events = std::move(state.events);
+        output_path = std::move(state.output_path);
+    }
+
+    std::string trace = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event& event = events[i];
+        trace += fmt::format("{}{{\"name\":\"{}\",\"cat\":\"boot\",\"ph\":\"{}\",\"ts\":{},"
+                             "\"pid\":1,\"tid\":{}",
+                             i == 0 ? "" : ",", event.name, event.phase, event.timestamp_us,
+                             event.thread_id);
+        if (event.phase == 'X') {
+            trace += fmt::format(",\"dur\":{}}}", event.duration_us);
+        } else {
+            trace += ",\"s\":\"g\"}";
+        }
+    }
+    trace += "]}\n";
+
+    if (FS::WriteStringToFile(output_path, FS::FileType::TextFile, trace) != trace.size()) {
+        LOG_ERROR(Common, "Failed to write boot trace to {}", FS::PathToUTF8String(output_path));
+        return;
+    }
+    LOG_INFO(Common, "Wrote boot trace with {} events to {}", events.size(),
+             FS::PathToUTF8String(output_path));
+}
+
+bool IsActive() {
+    return GetState().is_active.load(std::memory_order_relaxed);
+}
+
+void Mark(const char* name) {
+    if (!IsActive()) {
+        return;
+    }
+    AddEvent(Event{
+        .name = name,
+        .phase = 'i',
+        .timestamp_us = GetTimestampUs(GetState()),
+        .duration_us = 0,
+        .thread_id = GetThreadId(),
+    });
+}
+
+Scope::Scope(const char* name_)
+    : name{IsActive() ? name_ : nullptr}, start_us{name ? GetTimestampUs(GetState()) : 0} {}
+
+Scope::~Scope() {
+    if (name == nullptr || !IsActive()) {
+        return;
+    }
+    AddEvent(Event{
+        .name = name,
+        .phase = 'X',
+        .timestamp_us = start_us,
+        .duration_us = GetTimestampUs(GetState()) - start_us,
+        .thread_id = GetThreadId(),
+    });
+}
+
+} // namespace Common::BootTrace
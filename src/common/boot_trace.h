@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+/**
+ * Records the phases of booting a title as a Chrome trace (chrome://tracing, Perfetto).
+ *
+ * Phases are recorded from any thread with a Scope. Recording is a no-op until Start is called,
+ * and the trace is written out once Finish is called, normally when the first frame is presented.
+ */
+namespace Common::BootTrace {
+
+/// Starts recording boot phases, does nothing if a trace is already being recorded
+void Start(const std::filesystem::path& output_path);
+
+/// Writes the recorded phases to the output path and stops recording
+void Finish();
+
+/// Returns true while boot phases are being recorded
+[[nodiscard]] bool IsActive();
+
+/// Records an instant event, name must outlive the trace
+void Mark(const char* name);
+
+/// Records the lifetime of the scope as a boot phase, name must outlive the trace
+class Scope {
+public:
+    explicit Scope(const char* name_);
+    ~Scope();
+
+    SUYU_NON_COPYABLE(Scope);
+    SUYU_NON_MOVEABLE(Scope);
+
+private:
+    const char* name;
+    s64 start_us;
+};
+
+} // namespace Common::BootTrace
@@ -5,19 +5,26 @@
 
 #include "common/assert.h"
 #include "common/fiber.h"
-#include "common/virtual_buffer.h"
+#include "common/fiber_stack_pool.h"
 
 #include <boost/context/detail/fcontext.hpp>
 
 namespace Common {
 
-constexpr std::size_t default_stack_size = 512 * 1024;
+constexpr std::size_t default_stack_size = FiberStackPool::StackSize;
 
 struct Fiber::FiberImpl {
-    FiberImpl() : stack{default_stack_size}, rewind_stack{default_stack_size} {}
+    FiberImpl() = default;
 
-    VirtualBuffer<u8> stack;
-    VirtualBuffer<u8> rewind_stack;
+    ~FiberImpl() {
+        FiberStackPool& pool = FiberStackPool::Instance();
+        pool.Release(stack);
+        pool.Release(rewind_stack);
+    }
+
+    // Thread fibers run on the host thread's stack, and only rewound fibers need a rewind stack
+    u8* stack{};
+    u8* rewind_stack{};
 
     std::mutex guard;
     std::function<void()> entry_point;
@@ -34,6 +41,10 @@ struct Fiber::FiberImpl {
 
 void Fiber::SetRewindPoint(std::function<void()>&& rewind_func) {
     impl->rewind_point = std::move(rewind_func);
+    if (!impl->rewind_stack) {
+        impl->rewind_stack = FiberStackPool::Instance().Acquire();
+        impl->rewind_stack_limit = impl->rewind_stack;
+    }
 }
 
 void Fiber::Start(boost::context::detail::transfer_t& transfer) {
@@ -68,11 +79,11 @@ void Fiber::RewindStartFunc(boost::context::detail::transfer_t transfer) {
 
 Fiber::Fiber(std::function<void()>&& entry_point_func) : impl{std::make_unique<FiberImpl>()} {
     impl->entry_point = std::move(entry_point_func);
-    impl->stack_limit = impl->stack.data();
-    impl->rewind_stack_limit = impl->rewind_stack.data();
+    impl->stack = FiberStackPool::Instance().Acquire();
+    impl->stack_limit = impl->stack;
     u8* stack_base = impl->stack_limit + default_stack_size;
     impl->context =
-        boost::context::detail::make_fcontext(stack_base, impl->stack.size(), FiberStartFunc);
+        boost::context::detail::make_fcontext(stack_base, default_stack_size, FiberStartFunc);
 }
 
 Fiber::Fiber() : impl{std::make_unique<FiberImpl>()} {}
@@ -103,7 +114,7 @@ void Fiber::Rewind() {
     ASSERT(impl->rewind_context == nullptr);
     u8* stack_base = impl->rewind_stack_limit + default_stack_size;
     impl->rewind_context =
-        boost::context::detail::make_fcontext(stack_base, impl->stack.size(), RewindStartFunc);
+        boost::context::detail::make_fcontext(stack_base, default_stack_size, RewindStartFunc);
     boost::context::detail::jump_fcontext(impl->rewind_context, this);
 }
 
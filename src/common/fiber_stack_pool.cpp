@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "common/assert.h"
+#include "common/fiber_stack_pool.h"
+
+namespace Common {
+
+namespace {
+
+// Stacks kept around for reuse, anything past this is returned to the host
+constexpr std::size_t MaxFreeStacks = 128;
+
+// Top part of a released stack that is kept resident, this is where almost all frames live
+constexpr std::size_t RetainedSize = 64 * 1024;
+
+constexpr std::size_t RegionSize = FiberStackPool::GuardSize + FiberStackPool::StackSize;
+
+u8* MapStack() {
+#ifdef _WIN32
+    // Committing only reserves backing store, pages are still materialized on first touch
+    void* const base{VirtualAlloc(nullptr, RegionSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE)};
+    ASSERT(base);
+    DWORD old_protect{};
+    ASSERT(VirtualProtect(base, FiberStackPool::GuardSize, PAGE_NOACCESS, &old_protect));
+#else
+    int flags{MAP_ANON | MAP_PRIVATE};
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void* base{mmap(nullptr, RegionSize, PROT_READ | PROT_WRITE, flags, -1, 0)};
+    ASSERT(base != MAP_FAILED);
+    ASSERT(mprotect(base, FiberStackPool::GuardSize, PROT_NONE) == 0);
+#endif
+    return static_cast<u8*>(base) + FiberStackPool::GuardSize;
+}
+
+void UnmapStack(u8* stack) noexcept {
+    u8* const base{stack - FiberStackPool::GuardSize};
+#ifdef _WIN32
+    ASSERT(VirtualFree(base, 0, MEM_RELEASE));
+#else
+    ASSERT(munmap(base, RegionSize) == 0);
+#endif
+}
+
+void DiscardColdPages(u8* stack) noexcept {
+    // Stacks grow down, the cold pages are the ones at the lowest addresses
+    constexpr std::size_t cold_size = FiberStackPool::StackSize - RetainedSize;
+#ifdef _WIN32
+    VirtualAlloc(stack, cold_size, MEM_RESET, PAGE_READWRITE);
+#elif defined(MADV_FREE)
+    madvise(stack, cold_size, MADV_FREE);
+#else
+    madvise(stack, cold_size, MADV_DONTNEED);
+#endif
+}
+
+} // Anonymous namespace
+
+FiberStackPool::FiberStackPool() {
+    // Releasing a stack never allocates
+    free_stacks.reserve(MaxFreeStacks);
+}
+
+FiberStackPool::~FiberStackPool() {
+    for (u8* const stack : free_stacks) {
+        UnmapStack(stack);
+    }
+}
+
+FiberStackPool& FiberStackPool::Instance() {
+    // Never destroyed, fibers owned by static objects may still release their stacks at exit
+    static FiberStackPool* const instance = new FiberStackPool;
+    return *instance;
+}
+
+u8* FiberStackPool::Acquire() {
+    {
+        std::scoped_lock lk{mutex};
+        if (!free_stacks.empty()) {
+            u8* const stack{free_stacks.back()};
+            free_stacks.pop_back();
+            ++num_reused;
+            return stack;
+        }
+        ++num_allocated;
+    }
+    return MapStack();
+}
+
+void FiberStackPool::Release(u8* stack) noexcept {
+    if (!stack) {
+        return;
+    }
+    // Done before the stack can be handed out again
+    DiscardColdPages(stack);
+    {
+        std::scoped_lock lk{mutex};
+        if (free_stacks.size() < MaxFreeStacks) {
+            free_stacks.push_back(stack);
+            return;
+        }
+    }
+    UnmapStack(stack);
+}
+
+FiberStackPool::Statistics FiberStackPool::GetStatistics() const {
+    std::scoped_lock lk{mutex};
+    return {
+        .allocated = num_allocated,
+        .reused = num_reused,
+        .num_free = free_stacks.size(),
+    };
+}
+
+} // namespace Common
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Process-wide pool of fiber stacks.
+ *
+ * Every guest thread runs on a fiber, and titles that spawn short-lived worker threads would
+ * otherwise map and unmap a stack on every thread creation. Released stacks are kept for reuse,
+ * with the pages past their most recently used part handed back to the host.
+ * Stacks are committed lazily by the host and have an inaccessible guard region below them, so an
+ * overflow faults instead of silently corrupting a neighbouring allocation.
+ */
+class FiberStackPool {
+public:
+    /// Usable size of every stack
+    static constexpr std::size_t StackSize = 512 * 1024;
+
+    /// Size of the inaccessible region below every stack, a multiple of any host page size
+    static constexpr std::size_t GuardSize = 64 * 1024;
+
+    struct Statistics {
+        u64 allocated; ///< Stacks mapped from the host
+        u64 reused;    ///< Stacks handed out again from the pool
+        u64 num_free;  ///< Stacks currently waiting in the pool
+    };
+
+    [[nodiscard]] static FiberStackPool& Instance();
+
+    ~FiberStackPool();
+
+    FiberStackPool(const FiberStackPool&) = delete;
+    FiberStackPool& operator=(const FiberStackPool&) = delete;
+
+    /// Returns the lowest usable address of a stack, it grows down from the address + StackSize
+    [[nodiscard]] u8* Acquire();
+
+    /// Returns a stack acquired from this pool
+    void Release(u8* stack) noexcept;
+
+    [[nodiscard]] Statistics GetStatistics() const;
+
+private:
+    FiberStackPool();
+
+    mutable std::mutex mutex;
+    std::vector<u8*> free_stacks;
+    u64 num_allocated{};
+    u64 num_reused{};
+};
+
+} // namespace Common
@@ -1,8 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "common/page_table.h"
-#include "common/scope_exit.h"
 
 namespace Common {
 
@@ -10,6 +11,33 @@ PageTable::PageTable() = default;
 
 PageTable::~PageTable() noexcept = default;
 
+void PageTable::MapRange(u64 base_page, u64 num_pages, uintptr_t host_pointer, u64 phys_addr,
+                         PageType type) {
+    // Entries are relative to the address of their page, so a contiguous range stores the same
+    // values in every page.
+    const u64 base_addr = base_page * page_size;
+    const uintptr_t pointer = host_pointer - base_addr;
+    for (u64 page = base_page; page < base_page + num_pages; ++page) {
+        pointers[page].StoreRelaxed(pointer, type);
+    }
+    std::fill_n(backing_addr.data() + base_page, num_pages, phys_addr - base_addr);
+    std::fill_n(blocks.data() + base_page, num_pages, base_addr);
+
+    // Publish the whole range at once.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void PageTable::UnmapRange(u64 base_page, u64 num_pages, PageType type) {
+    for (u64 page = base_page; page < base_page + num_pages; ++page) {
+        pointers[page].StoreRelaxed(0, type);
+    }
+    std::fill_n(backing_addr.data() + base_page, num_pages, u64{0});
+    std::fill_n(blocks.data() + base_page, num_pages, u64{0});
+
+    // Publish the whole range at once.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
 bool PageTable::BeginTraversal(TraversalEntry* out_entry, TraversalContext* out_context,
                                Common::ProcessAddress address) const {
     out_context->next_offset = GetInteger(address);
@@ -23,26 +51,51 @@ bool PageTable::ContinueTraversal(TraversalEntry* out_entry, TraversalContext* c
     out_entry->phys_addr = 0;
     out_entry->block_size = page_size;
 
-    // Regardless of whether the page was mapped, advance on exit.
-    SCOPE_EXIT {
-        context->next_page += 1;
-        context->next_offset += page_size;
-    };
-
-    // Validate that we can read the actual entry.
+    // Validate that we can read the actual entry, and that it is mapped.
     const auto page = context->next_page;
-    if (page >= backing_addr.size()) {
+    if (page >= backing_addr.size() || backing_addr[page] == 0) {
+        context->next_page += 1;
+        context->next_offset = context->next_page * page_size;
         return false;
     }
 
-    // Validate that the entry is mapped.
-    const auto phys_addr = backing_addr[page];
-    if (phys_addr == 0) {
-        return false;
+    // Like a block mapping of a hardware page table, grow the entry while it stays naturally
+    // aligned and physically contiguous, so that callers walk ranges instead of pages. Pages are
+    // contiguous exactly when they share their backing offset.
+    const u64 backing = backing_addr[page];
+    const u64 max_block_pages = std::max<u64>(MaxTraversalBlockSize / page_size, 1);
+    u64 block_pages = 1;
+    u64 block_first_page = page;
+    while (block_pages < max_block_pages) {
+        const u64 next_block_pages = block_pages * 2;
+        const u64 next_first_page = page & ~(next_block_pages - 1);
+        if (next_first_page + next_block_pages > backing_addr.size() ||
+            ((backing + next_first_page * page_size) & (next_block_pages * page_size - 1)) != 0) {
+            break;
+        }
+
+        // Only the other half of the grown block has to be checked.
+        const u64 buddy_first_page = block_first_page ^ block_pages;
+        bool is_contiguous = true;
+        for (u64 i = 0; i < block_pages; ++i) {
+            if (backing_addr[buddy_first_page + i] != backing) {
+                is_contiguous = false;
+                break;
+            }
+        }
+        if (!is_contiguous) {
+            break;
+        }
+
+        block_pages = next_block_pages;
+        block_first_page = next_first_page;
     }
 
-    // Populate the results.
-    out_entry->phys_addr = phys_addr + context->next_offset;
+    // Populate the results, continuing at the start of the next block.
+    out_entry->phys_addr = backing + context->next_offset;
+    out_entry->block_size = block_pages * page_size;
+    context->next_page = block_first_page + block_pages;
+    context->next_offset = context->next_page * page_size;
 
     return true;
 }
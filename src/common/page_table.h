@@ -39,6 +39,9 @@ struct PageTable {
         u64 next_offset{};
     };
 
+    /// Largest block returned by a traversal step, physically contiguous pages are merged up to it
+    static constexpr std::size_t MaxTraversalBlockSize = 64 * 1024;
+
     /// Number of bits reserved for attribute tagging.
     /// This can be at most the guaranteed alignment of the pointers in the page table.
     static constexpr int ATTRIBUTE_BITS = 2;
@@ -78,6 +81,12 @@ struct PageTable {
             raw.store(pointer | static_cast<uintptr_t>(type));
         }
 
+        /// Write a page pointer and type pair atomically, without ordering other memory accesses.
+        /// Range updates use this and publish all pages with a single fence.
+        void StoreRelaxed(uintptr_t pointer, PageType type) noexcept {
+            raw.store(pointer | static_cast<uintptr_t>(type), std::memory_order_relaxed);
+        }
+
         /// Unpack a pointer from a page info raw representation
         [[nodiscard]] static uintptr_t ExtractPointer(uintptr_t raw) noexcept {
             return raw & (~uintptr_t{0} << ATTRIBUTE_BITS);
@@ -101,6 +110,21 @@ struct PageTable {
     PageTable(PageTable&&) noexcept = default;
     PageTable& operator=(PageTable&&) noexcept = default;
 
+    /**
+     * Maps a range of pages to contiguous memory, filling all entries of the range at once.
+     *
+     * @param base_page    The first page to map.
+     * @param num_pages    The number of pages to map.
+     * @param host_pointer The host pointer of the memory backing the first page.
+     * @param phys_addr    The physical address of the memory backing the first page.
+     * @param type         The page type to map the memory as.
+     */
+    void MapRange(u64 base_page, u64 num_pages, uintptr_t host_pointer, u64 phys_addr,
+                  PageType type);
+
+    /// Clears the entries of a range of pages, leaving them with the given type and no backing.
+    void UnmapRange(u64 base_page, u64 num_pages, PageType type);
+
     bool BeginTraversal(TraversalEntry* out_entry, TraversalContext* out_context,
                         Common::ProcessAddress address) const;
     bool ContinueTraversal(TraversalEntry* out_entry, TraversalContext* context) const;
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Single writer, multiple reader sequence lock
+/// Readers never block the writer and never observe a torn value, they retry instead.
+/// Writers must be serialized externally.
+/// @tparam T  Value type, must be trivially copyable
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(std::is_default_constructible_v<T>);
+    static_assert(std::atomic<u64>::is_always_lock_free);
+
+    // The payload is kept in relaxed atomic words so a racing read is not a data race.
+    static constexpr std::size_t word_count = (sizeof(T) + sizeof(u64) - 1) / sizeof(u64);
+
+public:
+    SeqLock() {
+        Write(T{});
+    }
+
+    /// Publishes a new value
+    void Write(const T& value) {
+        std::array<u64, word_count> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const u32 sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < word_count; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /// Returns the most recently published value
+    [[nodiscard]] T Read() const {
+        T value;
+        while (!TryRead(value)) {
+        }
+        return value;
+    }
+
+    /// Attempts a single read, returns false if it raced with a write
+    [[nodiscard]] bool TryRead(T& out_value) const {
+        std::array<u64, word_count> words;
+        const u32 sequence = m_sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) != 0) {
+            return false;
+        }
+        for (std::size_t i = 0; i < word_count; ++i) {
+            words[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) != sequence) {
+            return false;
+        }
+        std::memcpy(&out_value, words.data(), sizeof(T));
+        return true;
+    }
+
+    /// Number of values published so far, including the initial one
+    [[nodiscard]] u32 Generation() const {
+        return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    alignas(64) std::atomic<u32> m_sequence{};
+    std::array<std::atomic<u64>, word_count> m_words{};
+};
+
+} // namespace Common
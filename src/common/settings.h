@@ -62,6 +62,7 @@ SWITCHABLE(AntiAliasing, false);
 SWITCHABLE(AspectRatio, true);
 SWITCHABLE(AstcDecodeMode, true);
 SWITCHABLE(AstcRecompression, true);
+SWITCHABLE(AstcRecompressionQuality, true);
 SWITCHABLE(AudioMode, true);
 SWITCHABLE(CpuBackend, true);
 SWITCHABLE(CpuAccuracy, true);
@@ -382,9 +383,20 @@ struct Values {
     SwitchableSetting<AstcRecompression, true> astc_recompression{linkage,
                                                                   AstcRecompression::Uncompressed,
                                                                   AstcRecompression::Uncompressed,
-                                                                  AstcRecompression::Bc3,
+                                                                  AstcRecompression::Bc7,
                                                                   "astc_recompression",
                                                                   Category::RendererAdvanced};
+    SwitchableSetting<AstcRecompressionQuality, true> astc_recompression_quality{
+        linkage,
+        AstcRecompressionQuality::Balanced,
+        AstcRecompressionQuality::Fast,
+        AstcRecompressionQuality::High,
+        "astc_recompression_quality",
+        Category::RendererAdvanced};
+    SwitchableSetting<bool> use_disk_texture_cache{linkage, false, "use_disk_texture_cache",
+                                                   Category::RendererAdvanced};
+    Setting<u32, true> disk_texture_cache_size{linkage, 1024, 64, 65536, "disk_texture_cache_size",
+                                               Category::RendererAdvanced};
     SwitchableSetting<VramUsageMode, true> vram_usage_mode{linkage,
                                                            VramUsageMode::Conservative,
                                                            VramUsageMode::Conservative,
@@ -410,6 +422,10 @@ struct Values {
                                                   Category::RendererAdvanced};
     SwitchableSetting<bool> use_asynchronous_shaders{linkage, false, "use_asynchronous_shaders",
                                                      Category::RendererAdvanced};
+    SwitchableSetting<bool> nvdec_frame_threading{linkage, false, "nvdec_frame_threading",
+                                                  Category::RendererAdvanced};
+    SwitchableSetting<bool> use_parallel_command_recording{
+        linkage, false, "use_parallel_command_recording", Category::RendererAdvanced};
     SwitchableSetting<bool> use_fast_gpu_time{
         linkage, true, "use_fast_gpu_time", Category::RendererAdvanced, Specialization::Default,
         true,    true};
@@ -420,6 +436,8 @@ struct Values {
                                                              Specialization::Default,
                                                              true,
                                                              true};
+    SwitchableSetting<bool> use_graphics_pipeline_library{
+        linkage, false, "use_graphics_pipeline_library", Category::RendererAdvanced};
     SwitchableSetting<bool> enable_compute_pipelines{linkage, false, "enable_compute_pipelines",
                                                      Category::RendererAdvanced};
     SwitchableSetting<bool> use_video_framerate{linkage, false, "use_video_framerate",
@@ -476,6 +494,13 @@ struct Values {
 
     Setting<s32> current_user{linkage, 0, "current_user", Category::System};
 
+    // Album captures are encoded as PNG with this zlib level, or as JPEG with this quality
+    Setting<bool> album_use_jpeg{linkage, false, "album_use_jpeg", Category::System};
+    Setting<u8, true> album_png_compression_level{
+        linkage, 6, 0, 9, "album_png_compression_level", Category::System};
+    Setting<u8, true> album_jpeg_quality{linkage, 90, 1, 100, "album_jpeg_quality",
+                                         Category::System};
+
     SwitchableSetting<ConsoleMode> use_docked_mode{linkage,
 #ifdef ANDROID
                                                    ConsoleMode::Handheld,
@@ -506,6 +531,7 @@ struct Values {
     Setting<bool> controller_navigation{linkage, true, "controller_navigation", Category::Controls};
     Setting<bool> enable_joycon_driver{linkage, true, "enable_joycon_driver", Category::Controls};
     Setting<bool> enable_procon_driver{linkage, false, "enable_procon_driver", Category::Controls};
+    Setting<bool> hid_jit_sampling{linkage, false, "hid_jit_sampling", Category::Controls};
 
     SwitchableSetting<bool> vibration_enabled{linkage, true, "vibration_enabled",
                                               Category::Controls};
@@ -571,6 +597,7 @@ struct Values {
                                         Category::DataStorage};
     Setting<std::string> gamecard_path{linkage, std::string(), "gamecard_path",
                                        Category::DataStorage};
+    Setting<bool> romfs_read_ahead{linkage, true, "romfs_read_ahead", Category::DataStorage};
 
     // Debugging
     bool record_frame_times;
@@ -585,6 +612,11 @@ struct Values {
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
+    Setting<bool> enable_boot_trace{linkage, false, "enable_boot_trace", Category::Debugging};
+    Setting<bool> enable_scheduler_trace{linkage, false, "enable_scheduler_trace",
+                                         Category::Debugging};
+    Setting<bool> enable_svc_statistics{linkage, false, "enable_svc_statistics",
+                                        Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
     Setting<bool> quest_flag{linkage, false, "quest_flag", Category::Debugging};
@@ -118,7 +118,9 @@ ENUM(AnisotropyMode, Automatic, Default, X2, X4, X8, X16);
 
 ENUM(AstcDecodeMode, Cpu, Gpu, CpuAsynchronous);
 
-ENUM(AstcRecompression, Uncompressed, Bc1, Bc3);
+ENUM(AstcRecompression, Uncompressed, Bc1, Bc3, Bc7);
+
+ENUM(AstcRecompressionQuality, Fast, Balanced, High);
 
 ENUM(VSyncMode, Immediate, Mailbox, Fifo, FifoRelaxed);
 
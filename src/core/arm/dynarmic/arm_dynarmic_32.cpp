@@ -348,20 +348,20 @@ u32 ArmDynarmic32::GetSvcNumber() const {
     return m_svc_swi;
 }
 
-void ArmDynarmic32::GetSvcArguments(std::span<uint64_t, 8> args) const {
+void ArmDynarmic32::GetSvcArguments(std::span<uint64_t> args) const {
     Dynarmic::A32::Jit& j = *m_jit;
     auto& gpr = j.Regs();
 
-    for (size_t i = 0; i < 8; i++) {
+    for (size_t i = 0; i < args.size(); i++) {
         args[i] = gpr[i];
     }
 }
 
-void ArmDynarmic32::SetSvcArguments(std::span<const uint64_t, 8> args) {
+void ArmDynarmic32::SetSvcArguments(std::span<const uint64_t> args) {
     Dynarmic::A32::Jit& j = *m_jit;
     auto& gpr = j.Regs();
 
-    for (size_t i = 0; i < 8; i++) {
+    for (size_t i = 0; i < args.size(); i++) {
         gpr[i] = static_cast<u32>(args[i]);
     }
 }
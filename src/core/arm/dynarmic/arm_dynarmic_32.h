@@ -37,8 +37,8 @@ public:
     void SetContext(const Kernel::Svc::ThreadContext& ctx) override;
     void SetTpidrroEl0(u64 value) override;
 
-    void GetSvcArguments(std::span<uint64_t, 8> args) const override;
-    void SetSvcArguments(std::span<const uint64_t, 8> args) override;
+    void GetSvcArguments(std::span<uint64_t> args) const override;
+    void SetSvcArguments(std::span<const uint64_t> args) override;
     u32 GetSvcNumber() const override;
 
     void SignalInterrupt(Kernel::KThread* thread) override;
@@ -379,18 +379,18 @@ u32 ArmDynarmic64::GetSvcNumber() const {
     return m_svc;
 }
 
-void ArmDynarmic64::GetSvcArguments(std::span<uint64_t, 8> args) const {
+void ArmDynarmic64::GetSvcArguments(std::span<uint64_t> args) const {
     Dynarmic::A64::Jit& j = *m_jit;
 
-    for (size_t i = 0; i < 8; i++) {
+    for (size_t i = 0; i < args.size(); i++) {
         args[i] = j.GetRegister(i);
     }
 }
 
-void ArmDynarmic64::SetSvcArguments(std::span<const uint64_t, 8> args) {
+void ArmDynarmic64::SetSvcArguments(std::span<const uint64_t> args) {
     Dynarmic::A64::Jit& j = *m_jit;
 
-    for (size_t i = 0; i < 8; i++) {
+    for (size_t i = 0; i < args.size(); i++) {
         j.SetRegister(i, args[i]);
     }
 }
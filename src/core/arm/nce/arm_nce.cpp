@@ -236,14 +236,14 @@ u32 ArmNce::GetSvcNumber() const {
     return m_guest_ctx.svc;
 }
 
-void ArmNce::GetSvcArguments(std::span<uint64_t, 8> args) const {
-    for (size_t i = 0; i < 8; i++) {
+void ArmNce::GetSvcArguments(std::span<uint64_t> args) const {
+    for (size_t i = 0; i < args.size(); i++) {
         args[i] = m_guest_ctx.cpu_registers[i];
     }
 }
 
-void ArmNce::SetSvcArguments(std::span<const uint64_t, 8> args) {
-    for (size_t i = 0; i < 8; i++) {
+void ArmNce::SetSvcArguments(std::span<const uint64_t> args) {
+    for (size_t i = 0; i < args.size(); i++) {
         m_guest_ctx.cpu_registers[i] = args[i];
     }
 }
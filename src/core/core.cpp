@@ -3,11 +3,14 @@
 
 #include <array>
 #include <atomic>
+#include <future>
 #include <memory>
 #include <utility>
 
 #include "audio_core/audio_core.h"
+#include "common/boot_trace.h"
 #include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
@@ -25,6 +28,7 @@
 #include "core/file_sys/romfs_factory.h"
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/vfs/vfs_concat.h"
+#include "core/file_sys/vfs/vfs_prefetch.h"
 #include "core/file_sys/vfs/vfs_real.h"
 #include "core/gpu_dirty_memory_manager.h"
 #include "core/hle/kernel/k_memory_manager.h"
@@ -54,10 +58,12 @@
 #include "core/memory.h"
 #include "core/memory/cheat_engine.h"
 #include "core/perf_stats.h"
+#include "core/replay.h"
 #include "core/reporter.h"
 #include "core/tools/freezer.h"
 #include "core/tools/renderdoc.h"
 #include "hid_core/hid_core.h"
+#include "hid_core/input_read_tracker.h"
 #include "network/network.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/renderer_base.h"
@@ -199,8 +205,8 @@ struct System::Impl {
         }
 
         const auto posix_time = std::chrono::system_clock::now().time_since_epoch();
-        const u64 current_time =
-            +std::chrono::duration_cast<std::chrono::seconds>(posix_time).count();
+        u64 current_time = +std::chrono::duration_cast<std::chrono::seconds>(posix_time).count();
+        system.GetReplaySession().Process(ReplaySession::Channel::Clock, current_time);
         const u64 new_time = current_time + time_offset;
 
         Service::PSC::Time::SystemClockContext context{};
@@ -261,6 +267,7 @@ struct System::Impl {
     }
 
     void InitializeKernel(System& system) {
+        Common::BootTrace::Scope scope{"InitializeKernel"};
         LOG_DEBUG(Core, "initialized OK");
 
         // Setting changes may require a full system reinitialization (e.g., disabling multicore).
@@ -270,18 +277,28 @@ struct System::Impl {
         cpu_manager.Initialize();
     }
 
-    SystemResultStatus SetupForApplicationProcess(System& system, Frontend::EmuWindow& emu_window) {
+    void CreateGPU(System& system, Frontend::EmuWindow& emu_window) {
+        Common::BootTrace::Scope scope{"CreateRenderer"};
         host1x_core = std::make_unique<Tegra::Host1x::Host1x>(system);
         gpu_core = VideoCore::CreateGPU(emu_window, system);
+    }
+
+    SystemResultStatus SetupForApplicationProcess(System& system) {
         if (!gpu_core) {
             return SystemResultStatus::ErrorVideoCore;
         }
 
-        audio_core = std::make_unique<AudioCore::AudioCore>(system);
+        {
+            Common::BootTrace::Scope scope{"CreateAudioCore"};
+            audio_core = std::make_unique<AudioCore::AudioCore>(system);
+        }
 
-        service_manager = std::make_shared<Service::SM::ServiceManager>(kernel);
-        services =
-            std::make_unique<Service::Services>(service_manager, system, stop_event.get_token());
+        {
+            Common::BootTrace::Scope scope{"StartServices"};
+            service_manager = std::make_shared<Service::SM::ServiceManager>(kernel);
+            services = std::make_unique<Service::Services>(service_manager, system,
+                                                           stop_event.get_token());
+        }
 
         is_powered_on = true;
         exit_locked = false;
@@ -304,16 +321,36 @@ struct System::Impl {
     SystemResultStatus Load(System& system, Frontend::EmuWindow& emu_window,
                             const std::string& filepath,
                             Service::AM::FrontendAppletParameters& params) {
+        system.StartBootTrace();
+        Common::BootTrace::Scope scope{"Load"};
+
         InitializeKernel(system);
 
+        // The renderer does not depend on the application, so its device is created while the
+        // application is loaded. OpenGL has to make its context current on this thread instead.
+        std::future<void> gpu_creation;
+        if (Settings::values.renderer_backend.GetValue() != Settings::RendererBackend::OpenGL) {
+            gpu_creation = std::async(std::launch::async, [&] { CreateGPU(system, emu_window); });
+        }
+
         const auto file = GetGameFileFromPath(virtual_filesystem, filepath);
 
         // Create the application process
         Loader::ResultStatus load_result{};
         std::vector<u8> control;
-        auto process =
-            Service::AM::CreateApplicationProcess(control, app_loader, load_result, system, file,
-                                                  params.program_id, params.program_index);
+        std::unique_ptr<Service::Process> process;
+        {
+            Common::BootTrace::Scope load_scope{"LoadApplication"};
+            process = Service::AM::CreateApplicationProcess(control, app_loader, load_result,
+                                                            system, file, params.program_id,
+                                                            params.program_index);
+        }
+
+        if (gpu_creation.valid()) {
+            gpu_creation.get();
+        } else {
+            CreateGPU(system, emu_window);
+        }
 
         if (load_result != Loader::ResultStatus::Success) {
             LOG_CRITICAL(Core, "Failed to load ROM (Error {})!", load_result);
@@ -343,7 +380,7 @@ struct System::Impl {
         kernel.MakeApplicationProcess(process->GetHandle());
 
         // Set up the rest of the system.
-        SystemResultStatus init_result{SetupForApplicationProcess(system, emu_window)};
+        SystemResultStatus init_result{SetupForApplicationProcess(system)};
         if (init_result != SystemResultStatus::Success) {
             LOG_CRITICAL(Core, "Failed to initialize system (Error {})!",
                          static_cast<int>(init_result));
@@ -396,6 +433,9 @@ struct System::Impl {
     void ShutdownMainProcess() {
         SetShuttingDown(true);
 
+        // Write out the boot trace if the title never presented a frame
+        Common::BootTrace::Finish();
+
         is_powered_on = false;
         exit_locked = false;
         exit_requested = false;
@@ -459,7 +499,23 @@ struct System::Impl {
     }
 
     PerfStatsResults GetAndResetPerfStats() {
-        return perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs());
+        auto results = perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs());
+        const auto latency = hid_core.GetInputReadTracker().GetAndResetLatencyStats();
+        if (latency.samples != 0) {
+            results.input_latency = static_cast<double>(latency.total_ns) /
+                                    static_cast<double>(latency.samples) / 1'000'000'000.0;
+        }
+        const auto prefetch = FileSys::GetAndResetGlobalPrefetchStatistics();
+        results.romfs_prefetch_hit_rate = prefetch.HitRate();
+        results.romfs_bytes_prefetched = prefetch.bytes_prefetched;
+        if (gpu_core) {
+            const auto shaders =
+                gpu_core->Renderer().ReadRasterizer()->GetAndResetShaderCacheStatistics();
+            results.shader_lookups = shaders.lookups;
+            results.shader_invalidations = shaders.invalidations;
+            results.shader_false_invalidations = shaders.false_invalidations;
+        }
+        return results;
     }
 
     mutable std::mutex suspend_guard;
@@ -524,6 +580,7 @@ struct System::Impl {
 
     std::unique_ptr<Core::PerfStats> perf_stats;
     Core::SpeedLimiter speed_limiter;
+    Core::ReplaySession replay_session;
 
     bool is_multicore{};
     bool is_async_gpu{};
@@ -608,6 +665,13 @@ void System::InitializeDebugger() {
     impl->InitializeDebugger(*this, Settings::values.gdbstub_port.GetValue());
 }
 
+void System::StartBootTrace() {
+    if (Settings::values.enable_boot_trace) {
+        Common::BootTrace::Start(Common::FS::GetSuyuPath(Common::FS::SuyuPath::LogDir) /
+                                 "boot_trace.json");
+    }
+}
+
 SystemResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::string& filepath,
                                 Service::AM::FrontendAppletParameters& params) {
     return impl->Load(*this, emu_window, filepath, params);
@@ -639,6 +703,14 @@ PerfStatsResults System::GetAndResetPerfStats() {
     return impl->GetAndResetPerfStats();
 }
 
+std::vector<Kernel::SvcStatistics::Entry> System::GetSvcStatistics() const {
+    const auto& svc_statistics = impl->kernel.SvcStatistics();
+    if (!svc_statistics.IsEnabled()) {
+        return {};
+    }
+    return svc_statistics.Collect();
+}
+
 Kernel::PhysicalCore& System::CurrentPhysicalCore() {
     return impl->kernel.CurrentPhysicalCore();
 }
@@ -745,6 +817,14 @@ const Core::PerfStats& System::GetPerfStats() const {
     return *impl->perf_stats;
 }
 
+Core::ReplaySession& System::GetReplaySession() {
+    return impl->replay_session;
+}
+
+const Core::ReplaySession& System::GetReplaySession() const {
+    return impl->replay_session;
+}
+
 Core::SpeedLimiter& System::SpeedLimiter() {
     return impl->speed_limiter;
 }
@@ -14,6 +14,7 @@
 
 #include "common/common_types.h"
 #include "core/file_sys/vfs/vfs_types.h"
+#include "core/hle/kernel/svc_statistics.h"
 
 namespace Core::Frontend {
 class EmuWindow;
@@ -120,6 +121,7 @@ class DeviceMemory;
 class ExclusiveMonitor;
 class GPUDirtyMemoryManager;
 class PerfStats;
+class ReplaySession;
 class Reporter;
 class SpeedLimiter;
 
@@ -198,6 +200,12 @@ public:
      */
     void InitializeDebugger();
 
+    /**
+     * Starts recording the boot phases into a Chrome trace when enable_boot_trace is set.
+     * Load starts it as well, frontends may call this earlier to include their own startup.
+     */
+    void StartBootTrace();
+
     /**
      * Load an executable application.
      * @param emu_window Reference to the host-system window used for video output and keyboard
@@ -229,6 +237,9 @@ public:
     /// Gets and resets core performance statistics
     [[nodiscard]] PerfStatsResults GetAndResetPerfStats();
 
+    /// Gets the host time spent in each SVC so far, empty unless SVC statistics are enabled
+    [[nodiscard]] std::vector<Kernel::SvcStatistics::Entry> GetSvcStatistics() const;
+
     /// Gets the physical core for the CPU core that is currently running
     [[nodiscard]] Kernel::PhysicalCore& CurrentPhysicalCore();
 
@@ -313,6 +324,12 @@ public:
     /// Provides a constant reference to the internal PerfStats instance.
     [[nodiscard]] const Core::PerfStats& GetPerfStats() const;
 
+    /// Provides a reference to the input record/replay session.
+    [[nodiscard]] Core::ReplaySession& GetReplaySession();
+
+    /// Provides a constant reference to the input record/replay session.
+    [[nodiscard]] const Core::ReplaySession& GetReplaySession() const;
+
     /// Provides a reference to the speed limiter;
     [[nodiscard]] Core::SpeedLimiter& SpeedLimiter();
 
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include "common/alignment.h"
 #include "core/crypto/xts_encryption_layer.h"
 
 namespace Core::Crypto {
@@ -19,10 +20,17 @@ std::size_t XTSEncryptionLayer::Read(u8* data, std::size_t length, std::size_t o
     const auto sector_offset = offset & 0x3FFF;
     if (sector_offset == 0) {
         if (length % XTS_SECTOR_SIZE == 0) {
-            std::vector<u8> raw = base->ReadBytes(length, offset);
-            cipher.XTSTranscode(raw.data(), raw.size(), data, offset / XTS_SECTOR_SIZE,
+            // Decrypt in place, data may be guest memory the read lands in directly
+            const std::size_t read = base->Read(data, length, offset);
+            const std::size_t aligned_read = Common::AlignDown(read, XTS_SECTOR_SIZE);
+            cipher.XTSTranscode(data, aligned_read, data, offset / XTS_SECTOR_SIZE,
                                 XTS_SECTOR_SIZE, Op::Decrypt);
-            return raw.size();
+            if (aligned_read != read) {
+                // The file ended within a sector, decrypt the remainder padded
+                return aligned_read + Read(data + aligned_read, read - aligned_read,
+                                           offset + aligned_read);
+            }
+            return read;
         }
         if (length > XTS_SECTOR_SIZE) {
             const auto rem = length % XTS_SECTOR_SIZE;
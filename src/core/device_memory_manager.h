@@ -14,6 +14,7 @@
 #include "common/range_mutex.h"
 #include "common/scratch_buffer.h"
 #include "common/virtual_buffer.h"
+#include "core/device_reverse_map.h"
 
 namespace Core {
 
@@ -70,17 +71,7 @@ public:
 
     template <typename Func>
     void ApplyOpOnPAddr(PAddr address, Common::ScratchBuffer<u32>& buffer, Func&& operation) {
-        DAddr subbits = static_cast<DAddr>(address & page_mask);
-        const u32 base = compressed_device_addr[(address >> page_bits)];
-        if ((base >> MULTI_FLAG_BITS) == 0) [[likely]] {
-            const DAddr d_address = (static_cast<DAddr>(base) << page_bits) + subbits;
-            operation(d_address);
-            return;
-        }
-        InnerGatherDeviceAddresses(buffer, address);
-        for (u32 value : buffer) {
-            operation((static_cast<DAddr>(value) << page_bits) + subbits);
-        }
+        reverse_map.ForEach(address, buffer, operation);
     }
 
     template <typename Func>
@@ -89,6 +80,21 @@ public:
         ApplyOpOnPAddr(address, buffer, operation);
     }
 
+    /// Calls operation(device_address, size) for the device ranges backing a physical range,
+    /// merging pages that are contiguous on the device
+    template <typename Func>
+    void ApplyOpOnPAddrRange(PAddr address, size_t size, Common::ScratchBuffer<u32>& buffer,
+                             Func&& operation) {
+        reverse_map.ForEachRange(address, size, buffer, operation);
+    }
+
+    template <typename Func>
+    void ApplyOpOnPointerRange(const u8* p, size_t size, Common::ScratchBuffer<u32>& buffer,
+                               Func&& operation) {
+        PAddr address = GetRawPhysicalAddr<u8>(p);
+        ApplyOpOnPAddrRange(address, size, buffer, operation);
+    }
+
     PAddr GetPhysicalRawAddressFromDAddr(DAddr address) const {
         PAddr subbits = static_cast<PAddr>(address & page_mask);
         auto paddr = compressed_physical_ptr[(address >> page_bits)];
@@ -128,9 +134,7 @@ private:
     static constexpr size_t page_size = 1ULL << page_bits;
     static constexpr size_t page_mask = page_size - 1ULL;
     static constexpr u32 physical_address_base = 1U << page_bits;
-    static constexpr u32 MULTI_FLAG_BITS = 31;
-    static constexpr u32 MULTI_FLAG = 1U << MULTI_FLAG_BITS;
-    static constexpr u32 MULTI_MASK = ~MULTI_FLAG;
+    static_assert(page_bits == DeviceReverseMap::PAGE_BITS);
 
     template <typename T>
     T* GetPointerFromRaw(PAddr addr) {
@@ -150,14 +154,12 @@ private:
     void WalkBlock(const DAddr addr, const std::size_t size, auto on_unmapped, auto on_memory,
                    auto increment);
 
-    void InnerGatherDeviceAddresses(Common::ScratchBuffer<u32>& buffer, PAddr address);
-
     std::unique_ptr<DeviceMemoryManagerAllocator<Traits>> impl;
 
     const uintptr_t physical_base;
     DeviceInterface* device_inter;
     Common::VirtualBuffer<u32> compressed_physical_ptr;
-    Common::VirtualBuffer<u32> compressed_device_addr;
+    DeviceReverseMap reverse_map;
     Common::VirtualBuffer<u32> continuity_tracker;
 
     // Process memory interfaces
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "core/device_reverse_map.h"
+
+namespace Core {
+
+DeviceReverseMap::DeviceReverseMap(size_t num_physical_pages) : entries(num_physical_pages) {
+    std::fill_n(entries.data(), num_physical_pages, 0U);
+}
+
+DeviceReverseMap::~DeviceReverseMap() = default;
+
+void DeviceReverseMap::Map(size_t physical_page, u32 device_page) {
+    const u32 entry = entries[physical_page];
+    if (entry == 0) [[likely]] {
+        entries[physical_page] = device_page;
+        return;
+    }
+    std::scoped_lock lock{links_mutex};
+    const u32 head = IsAliased(entry) ? entry & ALIAS_MASK : NewLink(entry, 0);
+    entries[physical_page] = ALIAS_FLAG | NewLink(device_page, head);
+}
+
+void DeviceReverseMap::Unmap(size_t physical_page, u32 device_page) {
+    const u32 entry = entries[physical_page];
+    if (!IsAliased(entry)) [[likely]] {
+        entries[physical_page] = 0;
+        return;
+    }
+    std::scoped_lock lock{links_mutex};
+    u32 head = entry & ALIAS_MASK;
+    u32 previous = 0;
+    for (u32 current = head; current != 0; current = links[current - 1].next) {
+        if (links[current - 1].device_page != device_page) {
+            previous = current;
+            continue;
+        }
+        const u32 next = links[current - 1].next;
+        if (previous == 0) {
+            head = next;
+        } else {
+            links[previous - 1].next = next;
+        }
+        free_links.push_back(current);
+        break;
+    }
+    if (head == 0) {
+        entries[physical_page] = 0;
+        return;
+    }
+    // Collapse lists with a single link left back into a direct entry
+    const Link& first = links[head - 1];
+    if (first.next == 0) {
+        entries[physical_page] = first.device_page;
+        free_links.push_back(head);
+        return;
+    }
+    entries[physical_page] = ALIAS_FLAG | head;
+}
+
+void DeviceReverseMap::Gather(size_t physical_page, Common::ScratchBuffer<u32>& buffer) const {
+    std::scoped_lock lock{links_mutex};
+    const u32 entry = entries[physical_page];
+    if (!IsAliased(entry)) {
+        buffer.resize_destructive(entry != 0 ? 1 : 0);
+        if (entry != 0) {
+            buffer[0] = entry;
+        }
+        return;
+    }
+    size_t count = 0;
+    for (u32 current = entry & ALIAS_MASK; current != 0; current = links[current - 1].next) {
+        buffer.resize(count + 1);
+        buffer[count++] = links[current - 1].device_page;
+    }
+}
+
+u32 DeviceReverseMap::NewLink(u32 device_page, u32 next) {
+    if (!free_links.empty()) {
+        const u32 index = free_links.front();
+        free_links.pop_front();
+        links[index - 1] = Link{.next = next, .device_page = device_page};
+        return index;
+    }
+    links.push_back(Link{.next = next, .device_page = device_page});
+    return static_cast<u32>(links.size());
+}
+
+} // namespace Core
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/scratch_buffer.h"
+#include "common/virtual_buffer.h"
+
+namespace Core {
+
+/**
+ * Reverse mapping from physical pages to the device pages that map them.
+ *
+ * Every physical page has one flat entry. A page mapped by a single device page, by far the common
+ * case, stores that device page directly and is looked up in O(1) without locking. A page aliased
+ * by several device pages points to a list of links instead, which is walked under a lock.
+ *
+ * Map and Unmap must be serialized by the caller, lookups may run concurrently with them.
+ */
+class DeviceReverseMap {
+public:
+    static constexpr size_t PAGE_BITS = 12;
+    static constexpr size_t PAGE_SIZE = 1ULL << PAGE_BITS;
+    static constexpr size_t PAGE_MASK = PAGE_SIZE - 1;
+
+    explicit DeviceReverseMap(size_t num_physical_pages);
+    ~DeviceReverseMap();
+
+    SUYU_NON_COPYABLE(DeviceReverseMap);
+    SUYU_NON_MOVEABLE(DeviceReverseMap);
+
+    /// Records that a device page maps a physical page
+    void Map(size_t physical_page, u32 device_page);
+
+    /// Removes a device page previously mapped to a physical page
+    void Unmap(size_t physical_page, u32 device_page);
+
+    /// Calls func(device_address) for every device address mapping a physical address
+    template <typename Func>
+    void ForEach(PAddr address, Common::ScratchBuffer<u32>& buffer, Func&& func) const {
+        const u64 subbits = address & PAGE_MASK;
+        const u32 entry = entries[address >> PAGE_BITS];
+        if (!IsAliased(entry)) [[likely]] {
+            if (entry != 0) {
+                func((static_cast<u64>(entry) << PAGE_BITS) + subbits);
+            }
+            return;
+        }
+        Gather(address >> PAGE_BITS, buffer);
+        for (const u32 device_page : buffer) {
+            func((static_cast<u64>(device_page) << PAGE_BITS) + subbits);
+        }
+    }
+
+    /**
+     * Calls func(device_address, size) for the device ranges mapping a physical range.
+     * Consecutive pages mapped once and contiguous on the device are merged into one call.
+     */
+    template <typename Func>
+    void ForEachRange(PAddr address, size_t size, Common::ScratchBuffer<u32>& buffer,
+                      Func&& func) const {
+        const PAddr end = address + size;
+        const size_t last_page = static_cast<size_t>((end - 1) >> PAGE_BITS);
+        while (address < end) {
+            const size_t page = static_cast<size_t>(address >> PAGE_BITS);
+            const u64 subbits = address & PAGE_MASK;
+            const u32 entry = entries[page];
+            size_t next_page = page + 1;
+            if (IsAliased(entry)) [[unlikely]] {
+                const PAddr page_end = std::min<PAddr>(PAddr{next_page} << PAGE_BITS, end);
+                Gather(page, buffer);
+                for (const u32 device_page : buffer) {
+                    func((static_cast<u64>(device_page) << PAGE_BITS) + subbits,
+                         static_cast<size_t>(page_end - address));
+                }
+                address = page_end;
+                continue;
+            }
+            // Extend the run over the following pages continuing it, unmapped pages are skipped
+            const u32 step = entry != 0 ? 1 : 0;
+            u32 expected = entry + step;
+            while (next_page <= last_page && entries[next_page] == expected) {
+                ++next_page;
+                expected += step;
+            }
+            const PAddr run_end = std::min<PAddr>(PAddr{next_page} << PAGE_BITS, end);
+            if (entry != 0) {
+                func((static_cast<u64>(entry) << PAGE_BITS) + subbits,
+                     static_cast<size_t>(run_end - address));
+            }
+            address = run_end;
+        }
+    }
+
+    /// Returns the device page mapping a physical page once, or zero when unmapped or aliased
+    [[nodiscard]] u32 SingleMapping(size_t physical_page) const noexcept {
+        const u32 entry = entries[physical_page];
+        return IsAliased(entry) ? 0 : entry;
+    }
+
+    /// Fills buffer with every device page mapping a physical page
+    void Gather(size_t physical_page, Common::ScratchBuffer<u32>& buffer) const;
+
+private:
+    static constexpr u32 ALIAS_FLAG = 1U << 31;
+    static constexpr u32 ALIAS_MASK = ~ALIAS_FLAG;
+
+    struct Link {
+        u32 next{}; ///< One based index of the next link, zero ends the list
+        u32 device_page{};
+    };
+
+    [[nodiscard]] static constexpr bool IsAliased(u32 entry) noexcept {
+        return (entry & ALIAS_FLAG) != 0;
+    }
+
+    u32 NewLink(u32 device_page, u32 next);
+
+    Common::VirtualBuffer<u32> entries;
+    std::deque<Link> links;
+    std::deque<u32> free_links;
+    mutable std::mutex links_mutex;
+};
+
+} // namespace Core
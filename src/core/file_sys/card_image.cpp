@@ -287,12 +287,14 @@ Loader::ResultStatus XCI::AddNCAFromPartition(XCIPartition part) {
         return Loader::ResultStatus::ErrorXCIMissingPartition;
     }
 
-    for (const VirtualFile& partition_file : partition->GetFiles()) {
-        if (partition_file->GetExtension() != "nca") {
-            continue;
+    std::vector<VirtualFile> nca_files;
+    for (VirtualFile& partition_file : partition->GetFiles()) {
+        if (partition_file->GetExtension() == "nca") {
+            nca_files.push_back(std::move(partition_file));
         }
+    }
 
-        auto nca = std::make_shared<NCA>(partition_file);
+    for (auto& nca : OpenNCAs(nca_files)) {
         if (nca->IsUpdate()) {
             continue;
         }
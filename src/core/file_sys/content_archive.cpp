@@ -2,8 +2,10 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <optional>
+#include <thread>
 #include <utility>
 
 #include "common/logging/log.h"
@@ -196,4 +198,29 @@ VirtualDir NCA::GetLogoPartition() const {
     return logo;
 }
 
+std::vector<std::shared_ptr<NCA>> OpenNCAs(const std::vector<VirtualFile>& files) {
+    // Reads of the underlying host file are serialized by the filesystem, but the crypto and
+    // bucket tree parsing of each archive can overlap. Installs can hold hundreds of archives,
+    // so a few threads take them in turn instead of one thread per archive.
+    std::vector<std::shared_ptr<NCA>> ncas(files.size());
+    std::atomic<std::size_t> next_index{};
+    const auto open_next = [&] {
+        for (std::size_t i = next_index++; i < files.size(); i = next_index++) {
+            ncas[i] = std::make_shared<NCA>(files[i]);
+        }
+    };
+
+    const std::size_t num_threads =
+        std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1U), files.size());
+    std::vector<std::jthread> threads;
+    threads.reserve(num_threads);
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(open_next);
+    }
+    open_next();
+    // Joins the other threads once they ran out of archives
+    threads.clear();
+    return ncas;
+}
+
 } // namespace FileSys
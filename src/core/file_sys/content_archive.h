@@ -105,4 +105,8 @@ private:
     std::shared_ptr<NcaReader> reader;
 };
 
+// Opens each file as an NCA. The headers and sections of the archives are decrypted and parsed in
+// parallel, the returned archives are in the same order as files.
+std::vector<std::shared_ptr<NCA>> OpenNCAs(const std::vector<VirtualFile>& files);
+
 } // namespace FileSys
@@ -3,7 +3,9 @@
 
 #include "core/file_sys/fssystem/fssystem_aes_xts_storage.h"
 #include "core/file_sys/fssystem/fssystem_nca_file_system_driver.h"
+#include "core/file_sys/nca_header_index.h"
 #include "core/file_sys/vfs/vfs_offset.h"
+#include "core/file_sys/vfs/vfs_vector.h"
 
 namespace FileSys {
 
@@ -50,51 +52,64 @@ Result NcaReader::Initialize(VirtualFile base_storage, const NcaCryptoConfigurat
     // We need to be able to generate keys.
     R_UNLESS(crypto_cfg.generate_key != nullptr, ResultInvalidArgument);
 
-    // Generate keys for header.
-    using AesXtsStorageForNcaHeader = AesXtsStorage;
+    // Reuse the header decrypted when this archive was opened on an earlier boot.
+    auto& header_index = NcaHeaderIndex::Instance();
+    const auto indexed_header = header_index.Find(base_storage);
+    if (indexed_header) {
+        std::memcpy(std::addressof(m_header), indexed_header->header.data(), sizeof(NcaHeader));
+        work_header_storage = std::make_shared<VectorVfsFile>(
+            std::vector<u8>(indexed_header->header.begin(), indexed_header->header.end()));
+        if (indexed_header->is_plaintext) {
+            m_header_encryption_type = NcaHeader::EncryptionType::None;
+        }
+    } else {
+        // Generate keys for header.
+        using AesXtsStorageForNcaHeader = AesXtsStorage;
+
+        constexpr std::array<s32, NcaCryptoConfiguration::HeaderEncryptionKeyCount>
+            HeaderKeyTypeValues = {
+                static_cast<s32>(KeyType::NcaHeaderKey1),
+                static_cast<s32>(KeyType::NcaHeaderKey2),
+            };
+
+        std::array<std::array<u8, NcaCryptoConfiguration::Aes128KeySize>,
+                   NcaCryptoConfiguration::HeaderEncryptionKeyCount>
+            header_decryption_keys;
+        for (size_t i = 0; i < NcaCryptoConfiguration::HeaderEncryptionKeyCount; i++) {
+            crypto_cfg.generate_key(header_decryption_keys[i].data(),
+                                    AesXtsStorageForNcaHeader::KeySize,
+                                    crypto_cfg.header_encrypted_encryption_keys[i].data(),
+                                    AesXtsStorageForNcaHeader::KeySize, HeaderKeyTypeValues[i]);
+        }
 
-    constexpr std::array<s32, NcaCryptoConfiguration::HeaderEncryptionKeyCount>
-        HeaderKeyTypeValues = {
-            static_cast<s32>(KeyType::NcaHeaderKey1),
-            static_cast<s32>(KeyType::NcaHeaderKey2),
-        };
+        // Create the header storage.
+        std::array<u8, AesXtsStorageForNcaHeader::IvSize> header_iv = {};
+        work_header_storage = std::make_unique<AesXtsStorageForNcaHeader>(
+            base_storage, header_decryption_keys[0].data(), header_decryption_keys[1].data(),
+            AesXtsStorageForNcaHeader::KeySize, header_iv.data(),
+            AesXtsStorageForNcaHeader::IvSize, NcaHeader::XtsBlockSize);
 
-    std::array<std::array<u8, NcaCryptoConfiguration::Aes128KeySize>,
-               NcaCryptoConfiguration::HeaderEncryptionKeyCount>
-        header_decryption_keys;
-    for (size_t i = 0; i < NcaCryptoConfiguration::HeaderEncryptionKeyCount; i++) {
-        crypto_cfg.generate_key(header_decryption_keys[i].data(),
-                                AesXtsStorageForNcaHeader::KeySize,
-                                crypto_cfg.header_encrypted_encryption_keys[i].data(),
-                                AesXtsStorageForNcaHeader::KeySize, HeaderKeyTypeValues[i]);
-    }
-
-    // Create the header storage.
-    std::array<u8, AesXtsStorageForNcaHeader::IvSize> header_iv = {};
-    work_header_storage = std::make_unique<AesXtsStorageForNcaHeader>(
-        base_storage, header_decryption_keys[0].data(), header_decryption_keys[1].data(),
-        AesXtsStorageForNcaHeader::KeySize, header_iv.data(), AesXtsStorageForNcaHeader::IvSize,
-        NcaHeader::XtsBlockSize);
+        // Check that we successfully created the storage.
+        R_UNLESS(work_header_storage != nullptr, ResultAllocationMemoryFailedInNcaReaderA);
 
-    // Check that we successfully created the storage.
-    R_UNLESS(work_header_storage != nullptr, ResultAllocationMemoryFailedInNcaReaderA);
+        // Read the header.
+        work_header_storage->ReadObject(std::addressof(m_header), 0);
 
-    // Read the header.
-    work_header_storage->ReadObject(std::addressof(m_header), 0);
+        // Validate the magic.
+        if (const Result magic_result = CheckNcaMagic(m_header.magic); R_FAILED(magic_result)) {
+            // Try to use a plaintext header.
+            base_storage->ReadObject(std::addressof(m_header), 0);
+            R_UNLESS(R_SUCCEEDED(CheckNcaMagic(m_header.magic)), magic_result);
 
-    // Validate the magic.
-    if (const Result magic_result = CheckNcaMagic(m_header.magic); R_FAILED(magic_result)) {
-        // Try to use a plaintext header.
-        base_storage->ReadObject(std::addressof(m_header), 0);
-        R_UNLESS(R_SUCCEEDED(CheckNcaMagic(m_header.magic)), magic_result);
+            // Configure to use the plaintext header.
+            auto base_storage_size = base_storage->GetSize();
+            work_header_storage =
+                std::make_shared<OffsetVfsFile>(base_storage, base_storage_size, 0);
+            R_UNLESS(work_header_storage != nullptr, ResultAllocationMemoryFailedInNcaReaderA);
 
-        // Configure to use the plaintext header.
-        auto base_storage_size = base_storage->GetSize();
-        work_header_storage = std::make_shared<OffsetVfsFile>(base_storage, base_storage_size, 0);
-        R_UNLESS(work_header_storage != nullptr, ResultAllocationMemoryFailedInNcaReaderA);
-
-        // Set encryption type as plaintext.
-        m_header_encryption_type = NcaHeader::EncryptionType::None;
+            // Set encryption type as plaintext.
+            m_header_encryption_type = NcaHeader::EncryptionType::None;
+        }
     }
 
     // Verify the header sign1.
@@ -159,6 +174,15 @@ Result NcaReader::Initialize(VirtualFile base_storage, const NcaCryptoConfigurat
     // Set our decompressor function getter.
     m_get_decompressor = compression_cfg.get_decompressor;
 
+    if (!indexed_header) {
+        NcaHeaderIndex::Entry entry{
+            .header{},
+            .is_plaintext = m_header_encryption_type == NcaHeader::EncryptionType::None,
+        };
+        work_header_storage->Read(entry.header.data(), entry.header.size(), 0);
+        header_index.Insert(base_storage, entry);
+    }
+
     // Set our storages.
     m_header_storage = std::move(work_header_storage);
     m_body_storage = std::move(base_storage);
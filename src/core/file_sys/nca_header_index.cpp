@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+#include "common/common_funcs.h"
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/hex_util.h"
+#include "common/logging/log.h"
+#include "core/file_sys/nca_header_index.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+namespace {
+
+constexpr u32 IndexMagic = Common::MakeMagic('S', 'N', 'H', 'I');
+constexpr u32 IndexVersion = 1;
+
+// Archives opened past this many are not indexed, which keeps the index at a few MiB
+constexpr std::size_t MaxEntries = 1024;
+
+struct IndexHeader {
+    u32 magic;
+    u32 version;
+};
+static_assert(sizeof(IndexHeader) == 0x8, "IndexHeader has incorrect size.");
+
+struct IndexRecord {
+    std::array<u8, 0x10> content_id;
+    u64 size;
+    u8 is_plaintext;
+    INSERT_PADDING_BYTES(7);
+    std::array<u8, NcaHeaderIndex::HeaderSize> header;
+};
+static_assert(sizeof(IndexRecord) == 0xC20, "IndexRecord has incorrect size.");
+
+} // Anonymous namespace
+
+NcaHeaderIndex& NcaHeaderIndex::Instance() {
+    static NcaHeaderIndex instance;
+    return instance;
+}
+
+NcaHeaderIndex::NcaHeaderIndex() = default;
+
+std::optional<NcaHeaderIndex::Entry> NcaHeaderIndex::Find(const VirtualFile& file) {
+    const auto key = MakeKey(file);
+    if (!key) {
+        return std::nullopt;
+    }
+
+    std::scoped_lock lk{mutex};
+    LoadLocked();
+    const auto it = entries.find(*key);
+    if (it == entries.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void NcaHeaderIndex::Insert(const VirtualFile& file, const Entry& entry) {
+    const auto key = MakeKey(file);
+    if (!key) {
+        return;
+    }
+
+    std::scoped_lock lk{mutex};
+    LoadLocked();
+    if (entries.size() >= MaxEntries || !entries.emplace(*key, entry).second) {
+        return;
+    }
+
+    const IndexRecord record{
+        .content_id = key->content_id,
+        .size = key->size,
+        .is_plaintext = static_cast<u8>(entry.is_plaintext),
+        .header = entry.header,
+    };
+    const Common::FS::IOFile index_file{path, Common::FS::FileAccessMode::Append,
+                                        Common::FS::FileType::BinaryFile};
+    if (!index_file.IsOpen() || !index_file.WriteObject(record)) {
+        LOG_ERROR(Loader, "Failed to write NCA header index {}",
+                  Common::FS::PathToUTF8String(path));
+    }
+}
+
+std::optional<NcaHeaderIndex::Key> NcaHeaderIndex::MakeKey(const VirtualFile& file) {
+    if (file == nullptr) {
+        return std::nullopt;
+    }
+
+    // Either <content id>.nca or <content id>.cnmt.nca
+    constexpr std::size_t ContentIdLength = 0x20;
+    const std::string name = file->GetName();
+    const std::string_view extension = std::string_view{name}.substr(
+        std::min(name.size(), ContentIdLength));
+    if (name.size() < ContentIdLength || (extension != ".nca" && extension != ".cnmt.nca") ||
+        !std::all_of(name.begin(), name.begin() + ContentIdLength,
+                     [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); })) {
+        return std::nullopt;
+    }
+
+    return Key{
+        .content_id = Common::HexStringToArray<0x10>(name),
+        .size = file->GetSize(),
+    };
+}
+
+void NcaHeaderIndex::LoadLocked() {
+    if (is_loaded) {
+        return;
+    }
+    is_loaded = true;
+    path = Common::FS::GetSuyuPath(Common::FS::SuyuPath::CacheDir) / "nca_header_index.bin";
+
+    {
+        const Common::FS::IOFile index_file{path, Common::FS::FileAccessMode::Read,
+                                            Common::FS::FileType::BinaryFile};
+        IndexHeader header{};
+        // A record cut short by a crash would misalign everything appended after it
+        if (index_file.IsOpen() &&
+            (index_file.GetSize() - sizeof(IndexHeader)) % sizeof(IndexRecord) == 0 &&
+            index_file.ReadObject(header) && header.magic == IndexMagic &&
+            header.version == IndexVersion) {
+            IndexRecord record{};
+            while (entries.size() < MaxEntries && index_file.ReadObject(record)) {
+                entries.emplace(Key{record.content_id, record.size},
+                                Entry{record.header, record.is_plaintext != 0});
+            }
+            LOG_DEBUG(Loader, "Loaded {} indexed NCA headers", entries.size());
+            return;
+        }
+    }
+
+    // The index is missing or from another version, start over
+    const Common::FS::IOFile index_file{path, Common::FS::FileAccessMode::Write,
+                                        Common::FS::FileType::BinaryFile};
+    const IndexHeader header{
+        .magic = IndexMagic,
+        .version = IndexVersion,
+    };
+    if (!index_file.IsOpen() || !index_file.WriteObject(header)) {
+        LOG_ERROR(Loader, "Failed to create NCA header index {}",
+                  Common::FS::PathToUTF8String(path));
+    }
+}
+
+} // namespace FileSys
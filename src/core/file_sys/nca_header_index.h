@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <compare>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs/vfs_types.h"
+
+namespace FileSys {
+
+/**
+ * On-disk index of decrypted NCA headers.
+ *
+ * Content archives in packages and installed content are named after their content id, a hash of
+ * their contents, so the name and size identify the same archive across boots. Opening an indexed
+ * archive skips reading and decrypting its header.
+ */
+class NcaHeaderIndex {
+public:
+    /// Size of the NCA header followed by its four section headers
+    static constexpr std::size_t HeaderSize = 0xC00;
+
+    struct Entry {
+        std::array<u8, HeaderSize> header;
+        bool is_plaintext;
+    };
+
+    static NcaHeaderIndex& Instance();
+
+    /// Returns the indexed header of file, if it was opened before
+    [[nodiscard]] std::optional<Entry> Find(const VirtualFile& file);
+
+    /// Adds the decrypted header of file to the index, if it is named after its content id
+    void Insert(const VirtualFile& file, const Entry& entry);
+
+private:
+    struct Key {
+        std::array<u8, 0x10> content_id;
+        u64 size;
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+    NcaHeaderIndex();
+
+    static std::optional<Key> MakeKey(const VirtualFile& file);
+
+    void LoadLocked();
+
+    std::mutex mutex;
+    bool is_loaded{false};
+    std::filesystem::path path;
+    std::map<Key, Entry> entries;
+};
+
+} // namespace FileSys
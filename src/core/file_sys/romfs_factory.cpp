@@ -5,18 +5,31 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "core/file_sys/common_funcs.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/nca_metadata.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/romfs_factory.h"
+#include "core/file_sys/vfs/vfs_prefetch.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
 
 namespace FileSys {
 
+namespace {
+
+VirtualFile WrapReadAhead(VirtualFile romfs) {
+    if (romfs == nullptr || !Settings::values.romfs_read_ahead.GetValue()) {
+        return romfs;
+    }
+    return std::make_shared<PrefetchVfsFile>(std::move(romfs));
+}
+
+} // Anonymous namespace
+
 RomFSFactory::RomFSFactory(Loader::AppLoader& app_loader, ContentProvider& provider,
                            Service::FileSystem::FileSystemController& controller)
     : content_provider{provider}, filesystem_controller{controller} {
@@ -36,14 +49,15 @@ void RomFSFactory::SetPackedUpdate(VirtualFile update_raw_file) {
 
 VirtualFile RomFSFactory::OpenCurrentProcess(u64 current_process_title_id) const {
     if (!updatable) {
-        return file;
+        return WrapReadAhead(file);
     }
 
     const auto type = ContentRecordType::Program;
     const auto nca = content_provider.GetEntry(current_process_title_id, type);
     const PatchManager patch_manager{current_process_title_id, filesystem_controller,
                                      content_provider};
-    return patch_manager.PatchRomFS(nca.get(), file, ContentRecordType::Program, packed_update_raw);
+    return WrapReadAhead(
+        patch_manager.PatchRomFS(nca.get(), file, ContentRecordType::Program, packed_update_raw));
 }
 
 VirtualFile RomFSFactory::OpenPatchedRomFS(u64 title_id, ContentRecordType type) const {
@@ -55,7 +69,7 @@ VirtualFile RomFSFactory::OpenPatchedRomFS(u64 title_id, ContentRecordType type)
 
     const PatchManager patch_manager{title_id, filesystem_controller, content_provider};
 
-    return patch_manager.PatchRomFS(nca.get(), nca->GetRomFS(), type);
+    return WrapReadAhead(patch_manager.PatchRomFS(nca.get(), nca->GetRomFS(), type));
 }
 
 VirtualFile RomFSFactory::OpenPatchedRomFSWithProgramIndex(u64 title_id, u8 program_index,
@@ -71,7 +85,7 @@ VirtualFile RomFSFactory::Open(u64 title_id, StorageId storage, ContentRecordTyp
         return nullptr;
     }
 
-    return res->GetRomFS();
+    return WrapReadAhead(res->GetRomFS());
 }
 
 std::shared_ptr<NCA> RomFSFactory::GetEntry(u64 title_id, StorageId storage,
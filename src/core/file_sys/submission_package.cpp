@@ -213,13 +213,16 @@ void NSP::InitializeExeFSAndRomFS(const std::vector<VirtualFile>& files) {
 }
 
 void NSP::ReadNCAs(const std::vector<VirtualFile>& files) {
+    std::vector<VirtualFile> meta_files;
     for (const auto& outer_file : files) {
         if (outer_file->GetName().size() < 9 ||
             outer_file->GetName().substr(outer_file->GetName().size() - 9) != ".cnmt.nca") {
             continue;
         }
+        meta_files.push_back(outer_file);
+    }
 
-        const auto nca = std::make_shared<NCA>(outer_file);
+    for (const auto& nca : OpenNCAs(meta_files)) {
         if (nca->GetStatus() != Loader::ResultStatus::Success || nca->GetSubdirectories().empty()) {
             program_status[nca->GetTitleId()] = nca->GetStatus();
             continue;
@@ -236,6 +239,8 @@ void NSP::ReadNCAs(const std::vector<VirtualFile>& files) {
 
             ncas[cnmt.GetTitleID()][{cnmt.GetType(), ContentRecordType::Meta}] = nca;
 
+            std::vector<ContentRecord> records;
+            std::vector<VirtualFile> record_files;
             for (const auto& rec : cnmt.GetContentRecords()) {
                 const auto id_string = Common::HexToString(rec.nca_id, false);
                 auto next_file = pfs->GetFile(fmt::format("{}.nca", id_string));
@@ -251,7 +256,14 @@ void NSP::ReadNCAs(const std::vector<VirtualFile>& files) {
                     continue;
                 }
 
-                auto next_nca = std::make_shared<NCA>(std::move(next_file));
+                records.push_back(rec);
+                record_files.push_back(std::move(next_file));
+            }
+
+            auto record_ncas = OpenNCAs(record_files);
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                const auto& rec = records[i];
+                auto next_nca = std::move(record_ncas[i]);
 
                 if (next_nca->GetType() == NCAContentType::Program) {
                     program_status[next_nca->GetTitleId()] = next_nca->GetStatus();
@@ -0,0 +1,248 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/logging/log.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/vfs/vfs_prefetch.h"
+
+namespace FileSys {
+
+namespace {
+
+// Number of consecutive sequential reads before reading ahead
+constexpr u32 SequentialReadThreshold = 2;
+
+std::atomic<u64> global_cache_hits{};
+std::atomic<u64> global_cache_misses{};
+std::atomic<u64> global_bytes_prefetched{};
+
+Common::ThreadWorker& GetPrefetchWorker() {
+    static Common::ThreadWorker worker{1, "RomFSPrefetch"};
+    return worker;
+}
+
+} // Anonymous namespace
+
+// Shared by every file wrapping the same base and by the queued prefetch tasks, which only hold it
+// weakly so closing the last file drops them
+struct PrefetchVfsFile::Cache {
+    explicit Cache(VirtualFile base_) : base{std::move(base_)}, size{base->GetSize()} {}
+
+    bool TryCopy(std::unique_lock<std::mutex>& lk, u8* data, std::size_t length,
+                 std::size_t offset) {
+        const u64 first_block = offset / BlockSize;
+        const u64 last_block = (offset + length - 1) / BlockSize;
+
+        // Waiting on a block that is already being read is cheaper than reading it a second time
+        condition.wait(lk, [&] {
+            for (u64 block = first_block; block <= last_block; ++block) {
+                if (in_flight.contains(block)) {
+                    return false;
+                }
+            }
+            return true;
+        });
+        for (u64 block = first_block; block <= last_block; ++block) {
+            if (!blocks.contains(block)) {
+                return false;
+            }
+        }
+
+        std::size_t copied = 0;
+        while (copied < length) {
+            const std::size_t position = offset + copied;
+            const auto& block = blocks.at(position / BlockSize);
+            const std::size_t block_offset = position % BlockSize;
+            const std::size_t copy_size = std::min(length - copied, block.size() - block_offset);
+            std::memcpy(data + copied, block.data() + block_offset, copy_size);
+            copied += copy_size;
+        }
+        return true;
+    }
+
+    void QueueReadAhead(const std::shared_ptr<Cache>& self, std::size_t offset) {
+        const u64 first_block = offset / BlockSize;
+        for (u64 block = first_block; block < first_block + ReadAheadBlocks; ++block) {
+            if (block * BlockSize >= size) {
+                break;
+            }
+            if (blocks.contains(block) || in_flight.contains(block)) {
+                continue;
+            }
+            in_flight.insert(block);
+            GetPrefetchWorker().QueueWork([weak_self = std::weak_ptr{self}, block] {
+                if (const auto cache = weak_self.lock()) {
+                    cache->LoadBlock(block);
+                }
+            });
+        }
+    }
+
+    void LoadBlock(u64 block) {
+        const std::size_t offset = block * BlockSize;
+        std::vector<u8> data(std::min(BlockSize, size - offset));
+        std::size_t read_size;
+        {
+            std::scoped_lock base_lk{base_mutex};
+            read_size = base->Read(data.data(), data.size(), offset);
+        }
+
+        std::scoped_lock lk{mutex};
+        in_flight.erase(block);
+        if (read_size == data.size()) {
+            blocks.emplace(block, std::move(data));
+            insertion_order.push_back(block);
+            while (insertion_order.size() > MaxCachedBlocks) {
+                blocks.erase(insertion_order.front());
+                insertion_order.pop_front();
+            }
+            bytes_prefetched += read_size;
+            global_bytes_prefetched += read_size;
+        }
+        condition.notify_all();
+    }
+
+    const VirtualFile base;
+    const std::size_t size;
+
+    // Encryption layers keep their cipher state in the file, so reads of the base are serialized
+    std::mutex base_mutex;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::unordered_map<u64, std::vector<u8>> blocks;
+    std::deque<u64> insertion_order;
+    std::unordered_set<u64> in_flight;
+
+    std::atomic<u64> bytes_prefetched{};
+};
+
+std::shared_ptr<PrefetchVfsFile::Cache> PrefetchVfsFile::GetCache(VirtualFile base) {
+    static std::mutex caches_mutex;
+    static std::unordered_map<const VfsFile*, std::weak_ptr<Cache>> caches;
+
+    // RomFS opens share the same base file, one cache per base serializes all reads of it
+    std::scoped_lock lk{caches_mutex};
+    std::erase_if(caches, [](const auto& entry) { return entry.second.expired(); });
+    auto& entry = caches[base.get()];
+    if (auto cache = entry.lock()) {
+        return cache;
+    }
+    auto cache = std::make_shared<Cache>(std::move(base));
+    entry = cache;
+    return cache;
+}
+
+PrefetchVfsFile::PrefetchVfsFile(VirtualFile base) : cache{GetCache(std::move(base))} {}
+
+PrefetchVfsFile::~PrefetchVfsFile() {
+    const auto stats = GetStatistics();
+    if (stats.cache_hits + stats.cache_misses != 0) {
+        LOG_DEBUG(Service_FS, "{}: {} hits, {} misses ({:.1f}% hit rate), {} bytes prefetched",
+                  cache->base->GetName(), stats.cache_hits, stats.cache_misses,
+                  stats.HitRate() * 100.0, stats.bytes_prefetched);
+    }
+}
+
+std::string PrefetchVfsFile::GetName() const {
+    return cache->base->GetName();
+}
+
+std::size_t PrefetchVfsFile::GetSize() const {
+    return cache->size;
+}
+
+bool PrefetchVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir PrefetchVfsFile::GetContainingDirectory() const {
+    return cache->base->GetContainingDirectory();
+}
+
+bool PrefetchVfsFile::IsWritable() const {
+    return false;
+}
+
+bool PrefetchVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t PrefetchVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (offset >= cache->size) {
+        return 0;
+    }
+    length = std::min(length, cache->size - offset);
+    if (length == 0) {
+        return 0;
+    }
+
+    std::unique_lock lk{cache->mutex};
+
+    // Small forward gaps still count as sequential, archives often skip over padding
+    const bool is_sequential =
+        offset >= next_sequential_offset && offset - next_sequential_offset <= BlockSize;
+    sequential_reads = is_sequential ? sequential_reads + 1 : 0;
+    next_sequential_offset = offset + length;
+    const bool should_read_ahead = sequential_reads >= SequentialReadThreshold;
+
+    if (cache->TryCopy(lk, data, length, offset)) {
+        ++cache_hits;
+        ++global_cache_hits;
+        if (should_read_ahead) {
+            cache->QueueReadAhead(cache, offset + length);
+        }
+        return length;
+    }
+    lk.unlock();
+
+    ++cache_misses;
+    ++global_cache_misses;
+    std::size_t read_size;
+    {
+        std::scoped_lock base_lk{cache->base_mutex};
+        read_size = cache->base->Read(data, length, offset);
+    }
+
+    if (should_read_ahead) {
+        lk.lock();
+        cache->QueueReadAhead(cache, offset + length);
+    }
+    return read_size;
+}
+
+std::size_t PrefetchVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+bool PrefetchVfsFile::Rename(std::string_view new_name) {
+    return false;
+}
+
+PrefetchStatistics PrefetchVfsFile::GetStatistics() const {
+    return {
+        .cache_hits = cache_hits.load(std::memory_order_relaxed),
+        .cache_misses = cache_misses.load(std::memory_order_relaxed),
+        .bytes_prefetched = cache->bytes_prefetched.load(std::memory_order_relaxed),
+    };
+}
+
+PrefetchStatistics GetAndResetGlobalPrefetchStatistics() {
+    return {
+        .cache_hits = global_cache_hits.exchange(0, std::memory_order_relaxed),
+        .cache_misses = global_cache_misses.exchange(0, std::memory_order_relaxed),
+        .bytes_prefetched = global_bytes_prefetched.exchange(0, std::memory_order_relaxed),
+    };
+}
+
+} // namespace FileSys
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+struct PrefetchStatistics {
+    u64 cache_hits;
+    u64 cache_misses;
+    u64 bytes_prefetched;
+
+    [[nodiscard]] double HitRate() const {
+        const u64 total = cache_hits + cache_misses;
+        return total == 0 ? 0.0 : static_cast<double>(cache_hits) / static_cast<double>(total);
+    }
+};
+
+// A read-only VfsFile that detects sequential access and reads ahead of it.
+// Once a few reads follow each other, the blocks after the last read are read (and decrypted, when
+// the wrapped file is an encryption layer) on a background thread into a bounded cache, so the
+// next guest request is served from memory instead of waiting on storage. Files wrapping the same
+// base share its cache, so the base is never read by two threads at once.
+class PrefetchVfsFile : public VfsFile {
+public:
+    static constexpr std::size_t BlockSize = 0x40000;
+    static constexpr std::size_t ReadAheadBlocks = 16;
+    static constexpr std::size_t MaxCachedBlocks = 32;
+
+    explicit PrefetchVfsFile(VirtualFile base);
+    ~PrefetchVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view new_name) override;
+
+    /// Hits and misses of this file alone, bytes prefetched for every file wrapping its base
+    [[nodiscard]] PrefetchStatistics GetStatistics() const;
+
+private:
+    struct Cache;
+
+    static std::shared_ptr<Cache> GetCache(VirtualFile base);
+
+    std::shared_ptr<Cache> cache;
+
+    // Guarded by the cache mutex
+    mutable std::size_t next_sequential_offset{};
+    mutable u32 sequential_reads{};
+
+    mutable std::atomic<u64> cache_hits{};
+    mutable std::atomic<u64> cache_misses{};
+};
+
+/// Returns the counters summed over every prefetching file since the last call and resets them
+[[nodiscard]] PrefetchStatistics GetAndResetGlobalPrefetchStatistics();
+
+} // namespace FileSys
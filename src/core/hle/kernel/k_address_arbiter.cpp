@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/scope_exit.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_address_arbiter.h"
@@ -109,13 +110,15 @@ bool UpdateIfEqual(KernelCore& kernel, s32* out, KProcessAddress address, s32 va
 
 class ThreadQueueImplForKAddressArbiter final : public KThreadQueue {
 public:
-    explicit ThreadQueueImplForKAddressArbiter(KernelCore& kernel, KAddressArbiter::ThreadTree* t)
-        : KThreadQueue(kernel), m_tree(t) {}
+    explicit ThreadQueueImplForKAddressArbiter(KernelCore& kernel, KHashedThreadTree::Bucket* b)
+        : KThreadQueue(kernel), m_bucket(b) {}
 
     void CancelWait(KThread* waiting_thread, Result wait_result, bool cancel_timer_task) override {
         // If the thread is waiting on an address arbiter, remove it from the tree.
         if (waiting_thread->IsWaitingForAddressArbiter()) {
-            m_tree->erase(m_tree->iterator_to(*waiting_thread));
+            auto& tree = m_bucket->Tree();
+            tree.erase(tree.iterator_to(*waiting_thread));
+            m_bucket->RemoveWaiter();
             waiting_thread->ClearAddressArbiter();
         }
 
@@ -124,19 +127,25 @@ public:
     }
 
 private:
-    KAddressArbiter::ThreadTree* m_tree{};
+    KHashedThreadTree::Bucket* m_bucket{};
 };
 
 } // namespace
 
 Result KAddressArbiter::Signal(uint64_t addr, s32 count) {
+    KHashedThreadTree::Bucket& bucket = m_waiters.GetBucket(addr);
+    ThreadTree& tree = bucket.Tree();
+
+    // If nobody waits, there is nobody to wake.
+    R_SUCCEED_IF(!bucket.HasWaiters());
+
     // Perform signaling.
     s32 num_waiters{};
     {
         KScopedSchedulerLock sl(m_kernel);
 
-        auto it = m_tree.nfind_key({addr, -1});
-        while ((it != m_tree.end()) && (count <= 0 || num_waiters < count) &&
+        auto it = tree.nfind_key({addr, -1});
+        while ((it != tree.end()) && (count <= 0 || num_waiters < count) &&
                (it->GetAddressArbiterKey() == addr)) {
             // End the thread's wait.
             KThread* target_thread = std::addressof(*it);
@@ -145,7 +154,8 @@ Result KAddressArbiter::Signal(uint64_t addr, s32 count) {
             ASSERT(target_thread->IsWaitingForAddressArbiter());
             target_thread->ClearAddressArbiter();
 
-            it = m_tree.erase(it);
+            it = tree.erase(it);
+            bucket.RemoveWaiter();
             ++num_waiters;
         }
     }
@@ -153,9 +163,14 @@ Result KAddressArbiter::Signal(uint64_t addr, s32 count) {
 }
 
 Result KAddressArbiter::SignalAndIncrementIfEqual(uint64_t addr, s32 value, s32 count) {
+    KHashedThreadTree::Bucket& bucket = m_waiters.GetBucket(addr);
+    ThreadTree& tree = bucket.Tree();
+
     // Perform signaling.
     s32 num_waiters{};
     {
+        // The value is updated under the lock, so a thread waiting on the new value can't be
+        // woken by this signal.
         KScopedSchedulerLock sl(m_kernel);
 
         // Check the userspace value.
@@ -164,8 +179,8 @@ Result KAddressArbiter::SignalAndIncrementIfEqual(uint64_t addr, s32 value, s32
                  ResultInvalidCurrentMemory);
         R_UNLESS(user_value == value, ResultInvalidState);
 
-        auto it = m_tree.nfind_key({addr, -1});
-        while ((it != m_tree.end()) && (count <= 0 || num_waiters < count) &&
+        auto it = tree.nfind_key({addr, -1});
+        while ((it != tree.end()) && (count <= 0 || num_waiters < count) &&
                (it->GetAddressArbiterKey() == addr)) {
             // End the thread's wait.
             KThread* target_thread = std::addressof(*it);
@@ -174,7 +189,8 @@ Result KAddressArbiter::SignalAndIncrementIfEqual(uint64_t addr, s32 value, s32
             ASSERT(target_thread->IsWaitingForAddressArbiter());
             target_thread->ClearAddressArbiter();
 
-            it = m_tree.erase(it);
+            it = tree.erase(it);
+            bucket.RemoveWaiter();
             ++num_waiters;
         }
     }
@@ -182,25 +198,28 @@ Result KAddressArbiter::SignalAndIncrementIfEqual(uint64_t addr, s32 value, s32
 }
 
 Result KAddressArbiter::SignalAndModifyByWaitingCountIfEqual(uint64_t addr, s32 value, s32 count) {
+    KHashedThreadTree::Bucket& bucket = m_waiters.GetBucket(addr);
+    ThreadTree& tree = bucket.Tree();
+
     // Perform signaling.
     s32 num_waiters{};
     {
         KScopedSchedulerLock sl(m_kernel);
 
-        auto it = m_tree.nfind_key({addr, -1});
+        auto it = tree.nfind_key({addr, -1});
         // Determine the updated value.
         s32 new_value{};
         if (count <= 0) {
-            if (it != m_tree.end() && it->GetAddressArbiterKey() == addr) {
+            if (it != tree.end() && it->GetAddressArbiterKey() == addr) {
                 new_value = value - 2;
             } else {
                 new_value = value + 1;
             }
         } else {
-            if (it != m_tree.end() && it->GetAddressArbiterKey() == addr) {
+            if (it != tree.end() && it->GetAddressArbiterKey() == addr) {
                 auto tmp_it = it;
                 s32 tmp_num_waiters{};
-                while (++tmp_it != m_tree.end() && tmp_it->GetAddressArbiterKey() == addr) {
+                while (++tmp_it != tree.end() && tmp_it->GetAddressArbiterKey() == addr) {
                     if (tmp_num_waiters++ >= count) {
                         break;
                     }
@@ -228,7 +247,7 @@ Result KAddressArbiter::SignalAndModifyByWaitingCountIfEqual(uint64_t addr, s32
         R_UNLESS(succeeded, ResultInvalidCurrentMemory);
         R_UNLESS(user_value == value, ResultInvalidState);
 
-        while ((it != m_tree.end()) && (count <= 0 || num_waiters < count) &&
+        while ((it != tree.end()) && (count <= 0 || num_waiters < count) &&
                (it->GetAddressArbiterKey() == addr)) {
             // End the thread's wait.
             KThread* target_thread = std::addressof(*it);
@@ -237,7 +256,8 @@ Result KAddressArbiter::SignalAndModifyByWaitingCountIfEqual(uint64_t addr, s32
             ASSERT(target_thread->IsWaitingForAddressArbiter());
             target_thread->ClearAddressArbiter();
 
-            it = m_tree.erase(it);
+            it = tree.erase(it);
+            bucket.RemoveWaiter();
             ++num_waiters;
         }
     }
@@ -245,10 +265,21 @@ Result KAddressArbiter::SignalAndModifyByWaitingCountIfEqual(uint64_t addr, s32
 }
 
 Result KAddressArbiter::WaitIfLessThan(uint64_t addr, s32 value, bool decrement, s64 timeout) {
-    // Prepare to wait.
     KThread* cur_thread = GetCurrentThreadPointer(m_kernel);
+
+    // If the value isn't less than the specified one, fail without taking the scheduler lock.
+    // Nothing would be decremented in that case either.
+    if (!cur_thread->IsTerminationRequested()) {
+        s32 user_value{};
+        R_UNLESS(ReadFromUser(m_kernel, std::addressof(user_value), addr),
+                 ResultInvalidCurrentMemory);
+        R_UNLESS(user_value < value, ResultInvalidState);
+    }
+
+    // Prepare to wait.
     KHardwareTimer* timer{};
-    ThreadQueueImplForKAddressArbiter wait_queue(m_kernel, std::addressof(m_tree));
+    KHashedThreadTree::Bucket& bucket = m_waiters.GetBucket(addr);
+    ThreadQueueImplForKAddressArbiter wait_queue(m_kernel, std::addressof(bucket));
 
     {
         KScopedSchedulerLockAndSleep slp{m_kernel, std::addressof(timer), cur_thread, timeout};
@@ -259,6 +290,15 @@ Result KAddressArbiter::WaitIfLessThan(uint64_t addr, s32 value, bool decrement,
             R_THROW(ResultTerminationRequested);
         }
 
+        // Announce the wait before reading userspace, so that signalers can't miss this thread.
+        bool is_waiting{};
+        bucket.AddWaiter();
+        SCOPE_EXIT {
+            if (!is_waiting) {
+                bucket.RemoveWaiter();
+            }
+        };
+
         // Read the value from userspace.
         s32 user_value{};
         bool succeeded{};
@@ -286,8 +326,9 @@ Result KAddressArbiter::WaitIfLessThan(uint64_t addr, s32 value, bool decrement,
         }
 
         // Set the arbiter.
-        cur_thread->SetAddressArbiter(std::addressof(m_tree), addr);
-        m_tree.insert(*cur_thread);
+        cur_thread->SetAddressArbiter(std::addressof(bucket.Tree()), addr);
+        bucket.Tree().insert(*cur_thread);
+        is_waiting = true;
 
         // Wait for the thread to finish.
         wait_queue.SetHardwareTimer(timer);
@@ -300,10 +341,20 @@ Result KAddressArbiter::WaitIfLessThan(uint64_t addr, s32 value, bool decrement,
 }
 
 Result KAddressArbiter::WaitIfEqual(uint64_t addr, s32 value, s64 timeout) {
-    // Prepare to wait.
     KThread* cur_thread = GetCurrentThreadPointer(m_kernel);
+
+    // If the value isn't equal, fail without taking the scheduler lock.
+    if (!cur_thread->IsTerminationRequested()) {
+        s32 user_value{};
+        R_UNLESS(ReadFromUser(m_kernel, std::addressof(user_value), addr),
+                 ResultInvalidCurrentMemory);
+        R_UNLESS(user_value == value, ResultInvalidState);
+    }
+
+    // Prepare to wait.
     KHardwareTimer* timer{};
-    ThreadQueueImplForKAddressArbiter wait_queue(m_kernel, std::addressof(m_tree));
+    KHashedThreadTree::Bucket& bucket = m_waiters.GetBucket(addr);
+    ThreadQueueImplForKAddressArbiter wait_queue(m_kernel, std::addressof(bucket));
 
     {
         KScopedSchedulerLockAndSleep slp{m_kernel, std::addressof(timer), cur_thread, timeout};
@@ -314,6 +365,15 @@ Result KAddressArbiter::WaitIfEqual(uint64_t addr, s32 value, s64 timeout) {
             R_THROW(ResultTerminationRequested);
         }
 
+        // Announce the wait before reading userspace, so that signalers can't miss this thread.
+        bool is_waiting{};
+        bucket.AddWaiter();
+        SCOPE_EXIT {
+            if (!is_waiting) {
+                bucket.RemoveWaiter();
+            }
+        };
+
         // Read the value from userspace.
         s32 user_value{};
         if (!ReadFromUser(m_kernel, std::addressof(user_value), addr)) {
@@ -334,8 +394,9 @@ Result KAddressArbiter::WaitIfEqual(uint64_t addr, s32 value, s64 timeout) {
         }
 
         // Set the arbiter.
-        cur_thread->SetAddressArbiter(std::addressof(m_tree), addr);
-        m_tree.insert(*cur_thread);
+        cur_thread->SetAddressArbiter(std::addressof(bucket.Tree()), addr);
+        bucket.Tree().insert(*cur_thread);
+        is_waiting = true;
 
         // Wait for the thread to finish.
         wait_queue.SetHardwareTimer(timer);
@@ -6,6 +6,7 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "core/hle/kernel/k_condition_variable.h"
+#include "core/hle/kernel/k_hashed_thread_tree.h"
 #include "core/hle/kernel/svc_types.h"
 
 union Result;
@@ -59,7 +60,7 @@ private:
     Result WaitIfEqual(uint64_t addr, s32 value, s64 timeout);
 
 private:
-    ThreadTree m_tree;
+    KHashedThreadTree m_waiters;
     Core::System& m_system;
     KernelCore& m_kernel;
 };
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/scope_exit.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_condition_variable.h"
@@ -76,12 +77,12 @@ public:
 
 class ThreadQueueImplForKConditionVariableWaitConditionVariable final : public KThreadQueue {
 private:
-    KConditionVariable::ThreadTree* m_tree;
+    KHashedThreadTree::Bucket* m_bucket;
 
 public:
     explicit ThreadQueueImplForKConditionVariableWaitConditionVariable(
-        KernelCore& kernel, KConditionVariable::ThreadTree* t)
-        : KThreadQueue(kernel), m_tree(t) {}
+        KernelCore& kernel, KHashedThreadTree::Bucket* b)
+        : KThreadQueue(kernel), m_bucket(b) {}
 
     void CancelWait(KThread* waiting_thread, Result wait_result, bool cancel_timer_task) override {
         // Remove the thread as a waiter from its owner.
@@ -91,7 +92,9 @@ public:
 
         // If the thread is waiting on a condvar, remove it from the tree.
         if (waiting_thread->IsWaitingForConditionVariable()) {
-            m_tree->erase(m_tree->iterator_to(*waiting_thread));
+            auto& tree = m_bucket->Tree();
+            tree.erase(tree.iterator_to(*waiting_thread));
+            m_bucket->RemoveWaiter();
             waiting_thread->ClearConditionVariable();
         }
 
@@ -153,6 +156,14 @@ Result KConditionVariable::WaitForAddress(KernelCore& kernel, Handle handle, KPr
     KThread* cur_thread = GetCurrentThreadPointer(kernel);
     ThreadQueueImplForKConditionVariableWaitForAddress wait_queue(kernel);
 
+    // If the lock isn't tagged as contended with the handle, there's no owner to wait on. This is
+    // checked again with the scheduler lock held, but skips taking it when the lock was released.
+    if (!cur_thread->IsTerminationRequested()) {
+        u32 test_tag{};
+        R_UNLESS(ReadFromUser(kernel, std::addressof(test_tag), addr), ResultInvalidCurrentMemory);
+        R_SUCCEED_IF(test_tag != (handle | Svc::HandleWaitMask));
+    }
+
     // Wait for the address.
     KThread* owner_thread{};
     {
@@ -241,17 +252,34 @@ void KConditionVariable::SignalImpl(KThread* thread) {
 }
 
 void KConditionVariable::Signal(u64 cv_key, s32 count) {
+    KHashedThreadTree::Bucket& bucket = m_waiters.GetBucket(cv_key);
+    ThreadTree& tree = bucket.Tree();
+
+    // If nobody waits, only the has waiter flag has to be cleared.
+    bool is_flag_cleared{};
+    if (!bucket.HasWaiters()) {
+        const u32 has_waiter_flag{};
+        WriteToUser(m_kernel, cv_key, std::addressof(has_waiter_flag));
+
+        // A thread that started waiting meanwhile may have set the flag before it was cleared.
+        if (!bucket.HasWaiters()) {
+            return;
+        }
+        is_flag_cleared = true;
+    }
+
     // Perform signaling.
     s32 num_waiters{};
     {
         KScopedSchedulerLock sl(m_kernel);
 
-        auto it = m_tree.nfind_key({cv_key, -1});
-        while ((it != m_tree.end()) && (count <= 0 || num_waiters < count) &&
+        auto it = tree.nfind_key({cv_key, -1});
+        while ((it != tree.end()) && (count <= 0 || num_waiters < count) &&
                (it->GetConditionVariableKey() == cv_key)) {
             KThread* target_thread = std::addressof(*it);
 
-            it = m_tree.erase(it);
+            it = tree.erase(it);
+            bucket.RemoveWaiter();
             target_thread->ClearConditionVariable();
 
             this->SignalImpl(target_thread);
@@ -260,9 +288,13 @@ void KConditionVariable::Signal(u64 cv_key, s32 count) {
         }
 
         // If we have no waiters, clear the has waiter flag.
-        if (it == m_tree.end() || it->GetConditionVariableKey() != cv_key) {
+        if (it == tree.end() || it->GetConditionVariableKey() != cv_key) {
             const u32 has_waiter_flag{};
             WriteToUser(m_kernel, cv_key, std::addressof(has_waiter_flag));
+        } else if (is_flag_cleared) {
+            // Otherwise, restore the flag if it may have been cleared above.
+            const u32 has_waiter_flag = 1;
+            WriteToUser(m_kernel, cv_key, std::addressof(has_waiter_flag));
         }
     }
 }
@@ -271,8 +303,9 @@ Result KConditionVariable::Wait(KProcessAddress addr, u64 key, u32 value, s64 ti
     // Prepare to wait.
     KThread* cur_thread = GetCurrentThreadPointer(m_kernel);
     KHardwareTimer* timer{};
+    KHashedThreadTree::Bucket& bucket = m_waiters.GetBucket(key);
     ThreadQueueImplForKConditionVariableWaitConditionVariable wait_queue(m_kernel,
-                                                                         std::addressof(m_tree));
+                                                                         std::addressof(bucket));
 
     {
         KScopedSchedulerLockAndSleep slp(m_kernel, std::addressof(timer), cur_thread, timeout);
@@ -283,6 +316,15 @@ Result KConditionVariable::Wait(KProcessAddress addr, u64 key, u32 value, s64 ti
             R_THROW(ResultTerminationRequested);
         }
 
+        // Announce the wait before setting the has waiter flag, so that signalers can't clear it.
+        bool is_waiting{};
+        bucket.AddWaiter();
+        SCOPE_EXIT {
+            if (!is_waiting) {
+                bucket.RemoveWaiter();
+            }
+        };
+
         // Update the value and process for the next owner.
         {
             // Remove waiter thread.
@@ -321,8 +363,9 @@ Result KConditionVariable::Wait(KProcessAddress addr, u64 key, u32 value, s64 ti
         R_UNLESS(timeout != 0, ResultTimedOut);
 
         // Update condition variable tracking.
-        cur_thread->SetConditionVariable(std::addressof(m_tree), addr, key, value);
-        m_tree.insert(*cur_thread);
+        cur_thread->SetConditionVariable(std::addressof(bucket.Tree()), addr, key, value);
+        bucket.Tree().insert(*cur_thread);
+        is_waiting = true;
 
         // Begin waiting.
         wait_queue.SetHardwareTimer(timer);
@@ -5,6 +5,7 @@
 
 #include "common/assert.h"
 
+#include "core/hle/kernel/k_hashed_thread_tree.h"
 #include "core/hle/kernel/k_scheduler.h"
 #include "core/hle/kernel/k_thread.h"
 #include "core/hle/kernel/k_typed_address.h"
@@ -39,7 +40,7 @@ private:
 private:
     Core::System& m_system;
     KernelCore& m_kernel;
-    ThreadTree m_tree{};
+    KHashedThreadTree m_waiters;
 };
 
 inline void BeforeUpdatePriority(KernelCore& kernel, KConditionVariable::ThreadTree* tree,
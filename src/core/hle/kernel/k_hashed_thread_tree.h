@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/hle/kernel/k_thread.h"
+
+namespace Kernel {
+
+/**
+ * Threads waiting on userspace addresses, split into trees by a hash of the address.
+ *
+ * Besides keeping the trees small, each bucket counts the threads that wait or are about to wait
+ * on it. Waiters announce themselves before reading userspace, and signalers check the count after
+ * updating userspace, so a signaler that sees no waiters can skip the scheduler lock: any thread
+ * that starts waiting afterwards is guaranteed to observe the update.
+ */
+class KHashedThreadTree {
+public:
+    using ThreadTree = KThread::ConditionVariableThreadTreeType;
+
+    static constexpr size_t NumBuckets = 64;
+
+    class Bucket {
+    public:
+        ThreadTree& Tree() {
+            return m_tree;
+        }
+
+        /// Announces a thread that is about to wait, must be called before reading userspace
+        void AddWaiter() {
+            m_num_waiters.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        /// Removes a thread that stopped waiting, or decided not to wait
+        void RemoveWaiter() {
+            m_num_waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /// Returns true when a thread may wait, must be called after updating userspace
+        [[nodiscard]] bool HasWaiters() const {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return m_num_waiters.load(std::memory_order_seq_cst) != 0;
+        }
+
+    private:
+        ThreadTree m_tree{};
+        std::atomic<u32> m_num_waiters{};
+    };
+
+    KHashedThreadTree() = default;
+
+    SUYU_NON_COPYABLE(KHashedThreadTree);
+    SUYU_NON_MOVEABLE(KHashedThreadTree);
+
+    Bucket& GetBucket(u64 key) {
+        // Keys are word aligned userspace addresses, mix the bits above the alignment
+        constexpr u64 Multiplier = 0x9E3779B97F4A7C15ULL;
+        return m_buckets[((key >> 2) * Multiplier) >> (64 - BucketBits)];
+    }
+
+private:
+    static constexpr u32 BucketBits = 6;
+    static_assert(NumBuckets == 1ULL << BucketBits);
+
+    std::array<Bucket, NumBuckets> m_buckets{};
+};
+
+} // namespace Kernel
@@ -20,6 +20,7 @@ Result KMemoryBlockManager::Initialize(KProcessAddress st, KProcessAddress nd,
     ASSERT(Common::IsAligned(GetInteger(m_end_address), PageSize));
 
     // Initialize and insert the block.
+    this->InvalidateFindCache();
     start_block->Initialize(m_start_address, (m_end_address - m_start_address) / PageSize,
                             KMemoryState::Free, KMemoryPermission::None, KMemoryAttribute::None);
     m_memory_block_tree.insert(*start_block);
@@ -30,6 +31,7 @@ Result KMemoryBlockManager::Initialize(KProcessAddress st, KProcessAddress nd,
 void KMemoryBlockManager::Finalize(KMemoryBlockSlabManager* slab_manager,
                                    BlockCallback&& block_callback) {
     // Erase every block until we have none left.
+    this->InvalidateFindCache();
     auto it = m_memory_block_tree.begin();
     while (it != m_memory_block_tree.end()) {
         KMemoryBlock* block = std::addressof(*it);
@@ -41,6 +43,24 @@ void KMemoryBlockManager::Finalize(KMemoryBlockSlabManager* slab_manager,
     ASSERT(m_memory_block_tree.empty());
 }
 
+KMemoryBlockManager::iterator KMemoryBlockManager::FindIteratorSlow(
+    KProcessAddress address) const {
+    iterator it = m_memory_block_tree.find(KMemoryBlock(
+        address, 1, KMemoryState::Free, KMemoryPermission::None, KMemoryAttribute::None));
+
+    // The next query often targets the block that follows, remember both.
+    if (it != m_memory_block_tree.end()) {
+        m_find_cache[m_find_cache_next] = {m_generation, it};
+        m_find_cache_next = (m_find_cache_next + 1) % NumFindCacheEntries;
+        if (iterator next = std::next(it); next != m_memory_block_tree.end()) {
+            m_find_cache[m_find_cache_next] = {m_generation, next};
+            m_find_cache_next = (m_find_cache_next + 1) % NumFindCacheEntries;
+        }
+    }
+
+    return it;
+}
+
 KProcessAddress KMemoryBlockManager::FindFreeArea(KProcessAddress region_start,
                                                   size_t region_num_pages, size_t num_pages,
                                                   size_t alignment, size_t offset,
@@ -82,6 +102,7 @@ KProcessAddress KMemoryBlockManager::FindFreeArea(KProcessAddress region_start,
 void KMemoryBlockManager::CoalesceForUpdate(KMemoryBlockManagerUpdateAllocator* allocator,
                                             KProcessAddress address, size_t num_pages) {
     // Find the iterator now that we've updated.
+    this->InvalidateFindCache();
     iterator it = this->FindIterator(address);
     if (address != m_start_address) {
         it--;
@@ -106,6 +127,9 @@ void KMemoryBlockManager::CoalesceForUpdate(KMemoryBlockManagerUpdateAllocator*
             break;
         }
     }
+
+    // Blocks may have been merged away.
+    this->InvalidateFindCache();
 }
 
 void KMemoryBlockManager::Update(KMemoryBlockManagerUpdateAllocator* allocator,
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <functional>
+#include <optional>
 
 #include "common/common_funcs.h"
 #include "core/hle/kernel/k_dynamic_resource_manager.h"
@@ -122,8 +123,14 @@ public:
                          size_t num_pages, KMemoryAttribute mask, KMemoryAttribute attr);
 
     iterator FindIterator(KProcessAddress address) const {
-        return m_memory_block_tree.find(KMemoryBlock(
-            address, 1, KMemoryState::Free, KMemoryPermission::None, KMemoryAttribute::None));
+        // Queries tend to repeat, or to walk the blocks in order, so check recent results first.
+        for (const FindCacheEntry& entry : m_find_cache) {
+            if (entry.generation == m_generation && (*entry.it)->Contains(address)) {
+                return *entry.it;
+            }
+        }
+
+        return this->FindIteratorSlow(address);
     }
 
     const KMemoryBlock* FindBlock(KProcessAddress address) const {
@@ -138,12 +145,29 @@ public:
     bool CheckState() const;
 
 private:
+    struct FindCacheEntry {
+        u64 generation{};
+        std::optional<iterator> it{};
+    };
+
+    static constexpr size_t NumFindCacheEntries = 4;
+
+    iterator FindIteratorSlow(KProcessAddress address) const;
+
+    /// Forgets recently found blocks, which updates may have split, merged or freed
+    void InvalidateFindCache() {
+        ++m_generation;
+    }
+
     void CoalesceForUpdate(KMemoryBlockManagerUpdateAllocator* allocator, KProcessAddress address,
                            size_t num_pages);
 
     MemoryBlockTree m_memory_block_tree;
     KProcessAddress m_start_address{};
     KProcessAddress m_end_address{};
+    mutable std::array<FindCacheEntry, NumFindCacheEntries> m_find_cache{};
+    mutable size_t m_find_cache_next{};
+    u64 m_generation{1};
 };
 
 class KScopedMemoryBlockManagerAuditor {
@@ -14,6 +14,7 @@
 #include "core/hle/kernel/k_interrupt_manager.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/kernel/k_scheduler.h"
+#include "core/hle/kernel/k_scheduler_trace.h"
 #include "core/hle/kernel/k_scoped_scheduler_lock_and_sleep.h"
 #include "core/hle/kernel/k_thread.h"
 #include "core/hle/kernel/kernel.h"
@@ -337,7 +338,11 @@ void KScheduler::SwitchThread(KThread* next_thread) {
         next_thread = m_idle_thread;
     }
 
-    if (next_thread->GetCurrentCore() != m_core_id) {
+    KSchedulerTrace& trace = m_kernel.SchedulerTrace();
+    if (const s32 old_core = next_thread->GetCurrentCore(); old_core != m_core_id) {
+        if (trace.IsEnabled()) [[unlikely]] {
+            trace.RecordMigration(next_thread, old_core, m_core_id);
+        }
         next_thread->SetCurrentCore(m_core_id);
     }
 
@@ -346,6 +351,11 @@ void KScheduler::SwitchThread(KThread* next_thread) {
         return;
     }
 
+    if (trace.IsEnabled()) [[unlikely]] {
+        trace.RecordContextSwitch(m_core_id, cur_thread, cur_thread == m_idle_thread, next_thread,
+                                  next_thread == m_idle_thread);
+    }
+
     // Next thread is now known not to be nullptr, and must not be dispatchable.
     ASSERT(next_thread->GetDisableDispatchCount() == 1);
     ASSERT(!next_thread->IsDummyThread());
@@ -543,6 +553,9 @@ void KScheduler::OnThreadStateChanged(KernelCore& kernel, KThread* thread, Threa
     } else if (cur_state == ThreadState::Runnable) {
         // If we're now runnable, then we weren't previously, and we should add.
         GetPriorityQueue(kernel).PushBack(thread);
+        if (auto& trace = kernel.SchedulerTrace(); trace.IsEnabled()) [[unlikely]] {
+            trace.RecordWakeUp(thread);
+        }
         IncrementScheduledCount(thread);
         SetSchedulerUpdateNeeded(kernel);
 
@@ -557,6 +570,10 @@ void KScheduler::OnThreadStateChanged(KernelCore& kernel, KThread* thread, Threa
 void KScheduler::OnThreadPriorityChanged(KernelCore& kernel, KThread* thread, s32 old_priority) {
     ASSERT(IsSchedulerLockedByCurrentThread(kernel));
 
+    if (auto& trace = kernel.SchedulerTrace(); trace.IsEnabled()) [[unlikely]] {
+        trace.RecordPriorityChange(thread, old_priority);
+    }
+
     // If the thread is runnable, we want to change its priority in the queue.
     if (thread->GetRawState() == ThreadState::Runnable) {
         GetPriorityQueue(kernel).ChangePriority(old_priority,
@@ -0,0 +1,368 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/hle/kernel/k_scheduler_trace.h"
+#include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/svc.h"
+
+namespace Kernel {
+
+namespace {
+
+// Events kept per buffer, 4 MiB each
+constexpr size_t BufferCapacity = 1 << 17;
+
+constexpr u8 FlagPrevIdle = 1 << 0;
+constexpr u8 FlagNextIdle = 1 << 1;
+
+// Chrome trace processes the tracks are grouped in
+constexpr u32 CoresPid = 1;
+constexpr u32 ThreadsPid = 2;
+constexpr u32 SvcsPid = 3;
+
+s64 GetTimestampNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+std::string_view WaitReasonName(ThreadWaitReasonForDebugging reason) {
+    switch (reason) {
+    case ThreadWaitReasonForDebugging::None:
+        return "Waiting";
+    case ThreadWaitReasonForDebugging::Sleep:
+        return "Sleep";
+    case ThreadWaitReasonForDebugging::IPC:
+        return "IPC";
+    case ThreadWaitReasonForDebugging::Synchronization:
+        return "Synchronization";
+    case ThreadWaitReasonForDebugging::ConditionVar:
+        return "ConditionVar";
+    case ThreadWaitReasonForDebugging::Arbitration:
+        return "Arbitration";
+    case ThreadWaitReasonForDebugging::Suspended:
+        return "Suspended";
+    }
+    return "Waiting";
+}
+
+/// Why a thread that was switched out is not running, empty if it is gone
+std::string_view OffCpuName(u32 value) {
+    const auto state = static_cast<ThreadState>(value >> 8);
+    const auto reason = static_cast<ThreadWaitReasonForDebugging>(value & 0xff);
+    if ((state & ThreadState::SuspendFlagMask) != ThreadState{}) {
+        return "Suspended";
+    }
+    switch (state & ThreadState::Mask) {
+    case ThreadState::Runnable:
+        return "Preempted";
+    case ThreadState::Waiting:
+        return WaitReasonName(reason);
+    default:
+        return {};
+    }
+}
+
+class TraceWriter {
+public:
+    explicit TraceWriter(s64 origin_ns_) : origin_ns{origin_ns_} {
+        trace = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    }
+
+    void Metadata(std::string_view kind, u32 pid, u64 tid, std::string_view name) {
+        Separator();
+        fmt::format_to(std::back_inserter(trace),
+                       "{{\"name\":\"{}\",\"ph\":\"M\",\"pid\":{},\"tid\":{},"
+                       "\"args\":{{\"name\":\"{}\"}}}}",
+                       kind, pid, tid, name);
+    }
+
+    void Slice(std::string_view name, u32 pid, u64 tid, s64 start_ns, s64 end_ns) {
+        Separator();
+        fmt::format_to(std::back_inserter(trace),
+                       "{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":{},\"tid\":{},\"ts\":{:.3f},"
+                       "\"dur\":{:.3f}}}",
+                       name, pid, tid, Us(start_ns), (end_ns - start_ns) / 1000.0);
+    }
+
+    void Instant(std::string_view name, u32 pid, u64 tid, s64 timestamp_ns) {
+        Separator();
+        fmt::format_to(std::back_inserter(trace),
+                       "{{\"name\":\"{}\",\"ph\":\"i\",\"s\":\"t\",\"pid\":{},\"tid\":{},"
+                       "\"ts\":{:.3f}}}",
+                       name, pid, tid, Us(timestamp_ns));
+    }
+
+    std::string Finish() {
+        trace += "]}\n";
+        return std::move(trace);
+    }
+
+private:
+    void Separator() {
+        if (!is_first) {
+            trace += ',';
+        }
+        is_first = false;
+    }
+
+    double Us(s64 timestamp_ns) const {
+        return (timestamp_ns - origin_ns) / 1000.0;
+    }
+
+    s64 origin_ns;
+    bool is_first{true};
+    std::string trace;
+};
+
+} // Anonymous namespace
+
+KSchedulerTrace::KSchedulerTrace(KernelCore& kernel) : m_kernel{kernel} {}
+
+KSchedulerTrace::~KSchedulerTrace() = default;
+
+void KSchedulerTrace::Start() {
+    for (RingBuffer& buffer : buffers) {
+        std::scoped_lock lk{buffer.lock};
+        buffer.events.resize(BufferCapacity);
+        buffer.num_recorded = 0;
+    }
+    origin_ns = GetTimestampNs();
+    is_enabled.store(true, std::memory_order_relaxed);
+}
+
+void KSchedulerTrace::Stop() {
+    is_enabled.store(false, std::memory_order_relaxed);
+}
+
+void KSchedulerTrace::RecordContextSwitch(s32 core_id, const KThread* prev_thread,
+                                          bool prev_is_idle, const KThread* next_thread,
+                                          bool next_is_idle) {
+    const u32 prev_state = static_cast<u32>(prev_thread->GetRawState()) << 8 |
+                           static_cast<u32>(prev_thread->GetWaitReasonForDebugging());
+    Push(Event{
+        .timestamp_ns = GetTimestampNs(),
+        .thread_id = next_thread->GetThreadId(),
+        .other = prev_thread->GetThreadId(),
+        .value = prev_state,
+        .type = EventType::ContextSwitch,
+        .core = static_cast<u8>(core_id),
+        .flags = static_cast<u8>((prev_is_idle ? FlagPrevIdle : 0) |
+                                 (next_is_idle ? FlagNextIdle : 0)),
+    });
+}
+
+void KSchedulerTrace::RecordWakeUp(const KThread* thread) {
+    Push(Event{
+        .timestamp_ns = GetTimestampNs(),
+        .thread_id = thread->GetThreadId(),
+        .type = EventType::WakeUp,
+    });
+}
+
+void KSchedulerTrace::RecordPriorityChange(const KThread* thread, s32 old_priority) {
+    Push(Event{
+        .timestamp_ns = GetTimestampNs(),
+        .thread_id = thread->GetThreadId(),
+        .other = static_cast<u64>(old_priority),
+        .value = static_cast<u32>(thread->GetPriority()),
+        .type = EventType::PriorityChange,
+    });
+}
+
+void KSchedulerTrace::RecordMigration(const KThread* thread, s32 old_core, s32 new_core) {
+    Push(Event{
+        .timestamp_ns = GetTimestampNs(),
+        .thread_id = thread->GetThreadId(),
+        .other = static_cast<u64>(old_core),
+        .value = static_cast<u32>(new_core),
+        .type = EventType::Migration,
+    });
+}
+
+void KSchedulerTrace::RecordSvcEnter(const KThread* thread, u32 svc_id) {
+    Push(Event{
+        .timestamp_ns = GetTimestampNs(),
+        .thread_id = thread->GetThreadId(),
+        .value = svc_id,
+        .type = EventType::SvcEnter,
+    });
+}
+
+void KSchedulerTrace::RecordSvcExit(const KThread* thread, u32 svc_id) {
+    Push(Event{
+        .timestamp_ns = GetTimestampNs(),
+        .thread_id = thread->GetThreadId(),
+        .value = svc_id,
+        .type = EventType::SvcExit,
+    });
+}
+
+void KSchedulerTrace::Push(Event event) {
+    // Host threads that are not emulated cores share the last buffer
+    const u32 host_thread_id = m_kernel.GetCurrentHostThreadID();
+    const size_t index = std::min<size_t>(host_thread_id, NumBuffers - 1);
+    if (event.type != EventType::ContextSwitch) {
+        event.core = static_cast<u8>(index);
+    }
+    RingBuffer& buffer = buffers[index];
+    std::scoped_lock lk{buffer.lock};
+    if (buffer.events.empty()) {
+        return;
+    }
+    buffer.events[buffer.num_recorded % buffer.events.size()] = event;
+    ++buffer.num_recorded;
+}
+
+std::vector<KSchedulerTrace::Event> KSchedulerTrace::CollectEvents() const {
+    std::vector<Event> events;
+    for (const RingBuffer& buffer : buffers) {
+        std::scoped_lock lk{buffer.lock};
+        const u64 capacity = buffer.events.size();
+        const u64 first = buffer.num_recorded > capacity ? buffer.num_recorded - capacity : 0;
+        for (u64 i = first; i < buffer.num_recorded; ++i) {
+            events.push_back(buffer.events[i % capacity]);
+        }
+    }
+    std::ranges::stable_sort(events, {}, &Event::timestamp_ns);
+    return events;
+}
+
+bool KSchedulerTrace::Export(const std::filesystem::path& path) const {
+    const std::vector<Event> events = CollectEvents();
+    TraceWriter writer{origin_ns};
+
+    writer.Metadata("process_name", CoresPid, 0, "Emulated cores");
+    writer.Metadata("process_name", ThreadsPid, 0, "Guest threads");
+    writer.Metadata("process_name", SvcsPid, 0, "Guest SVCs");
+    for (u32 core = 0; core < Core::Hardware::NUM_CPU_CORES; ++core) {
+        writer.Metadata("thread_name", CoresPid, core, fmt::format("Core {}", core));
+    }
+
+    struct CoreTrack {
+        u64 thread_id;
+        s64 since_ns;
+        bool is_running;
+    };
+    struct ThreadTrack {
+        bool is_running;
+        std::string_view off_cpu_name;
+        s64 since_ns;
+        std::vector<std::pair<u32, s64>> svcs;
+    };
+    std::array<CoreTrack, Core::Hardware::NUM_CPU_CORES> cores{};
+    std::unordered_map<u64, ThreadTrack> threads;
+
+    const auto get_thread = [&](u64 thread_id) -> ThreadTrack& {
+        const auto [it, is_new] = threads.try_emplace(thread_id);
+        if (is_new) {
+            writer.Metadata("thread_name", ThreadsPid, thread_id,
+                            fmt::format("Thread {}", thread_id));
+            writer.Metadata("thread_name", SvcsPid, thread_id,
+                            fmt::format("Thread {}", thread_id));
+        }
+        return it->second;
+    };
+    const auto end_off_cpu = [&](ThreadTrack& thread, u64 thread_id, s64 timestamp_ns) {
+        if (!thread.off_cpu_name.empty()) {
+            writer.Slice(thread.off_cpu_name, ThreadsPid, thread_id, thread.since_ns,
+                         timestamp_ns);
+        }
+        thread.off_cpu_name = {};
+    };
+
+    for (const Event& event : events) {
+        const s64 ts = event.timestamp_ns;
+        switch (event.type) {
+        case EventType::ContextSwitch: {
+            CoreTrack& core = cores[event.core % cores.size()];
+            if (core.is_running) {
+                const std::string name = fmt::format("Thread {}", core.thread_id);
+                writer.Slice(name, CoresPid, event.core, core.since_ns, ts);
+                writer.Slice("Running", ThreadsPid, core.thread_id, core.since_ns, ts);
+            }
+            if ((event.flags & FlagPrevIdle) == 0) {
+                ThreadTrack& prev = get_thread(event.other);
+                prev.is_running = false;
+                prev.off_cpu_name = OffCpuName(event.value);
+                prev.since_ns = ts;
+            }
+            core.is_running = (event.flags & FlagNextIdle) == 0;
+            core.thread_id = event.thread_id;
+            core.since_ns = ts;
+            if (core.is_running) {
+                ThreadTrack& next = get_thread(event.thread_id);
+                next.is_running = true;
+                end_off_cpu(next, event.thread_id, ts);
+            }
+            break;
+        }
+        case EventType::WakeUp: {
+            // The wait is over, from now on the thread is only waiting for a core. Threads can
+            // also be woken up before they were switched out, those keep running.
+            ThreadTrack& thread = get_thread(event.thread_id);
+            if (thread.is_running) {
+                break;
+            }
+            end_off_cpu(thread, event.thread_id, ts);
+            thread.off_cpu_name = "Ready";
+            thread.since_ns = ts;
+            break;
+        }
+        case EventType::PriorityChange:
+            writer.Instant(fmt::format("Priority {} -> {}", static_cast<s32>(event.other),
+                                       static_cast<s32>(event.value)),
+                           ThreadsPid, event.thread_id, ts);
+            get_thread(event.thread_id);
+            break;
+        case EventType::Migration:
+            writer.Instant(fmt::format("Core {} -> {}", static_cast<s32>(event.other),
+                                       static_cast<s32>(event.value)),
+                           ThreadsPid, event.thread_id, ts);
+            get_thread(event.thread_id);
+            break;
+        case EventType::SvcEnter:
+            get_thread(event.thread_id).svcs.emplace_back(event.value, ts);
+            break;
+        case EventType::SvcExit: {
+            // Calls entered before the oldest kept event have no start, and are dropped
+            auto& svcs = get_thread(event.thread_id).svcs;
+            if (!svcs.empty() && svcs.back().first == event.value) {
+                const std::string_view name = Svc::GetSvcName(event.value);
+                writer.Slice(name.empty() ? fmt::format("SVC 0x{:02X}", event.value)
+                                          : std::string{name},
+                             SvcsPid, event.thread_id, svcs.back().second, ts);
+                svcs.pop_back();
+            }
+            break;
+        }
+        }
+    }
+
+    const std::string trace = writer.Finish();
+    if (Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile, trace) !=
+        trace.size()) {
+        LOG_ERROR(Kernel, "Failed to write scheduler trace to {}",
+                  Common::FS::PathToUTF8String(path));
+        return false;
+    }
+    LOG_INFO(Kernel, "Wrote scheduler trace with {} events to {}", events.size(),
+             Common::FS::PathToUTF8String(path));
+    return true;
+}
+
+} // namespace Kernel
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/spin_lock.h"
+#include "core/hardware_properties.h"
+
+namespace Kernel {
+
+class KernelCore;
+class KThread;
+
+/**
+ * Opt-in tracer of the guest thread timeline.
+ *
+ * Records context switches, wake ups, priority changes, core migrations and SVC calls into
+ * per-core ring buffers, which only keep the most recent events. The trace can be exported as a
+ * Chrome trace (chrome://tracing, Perfetto), with a track per emulated core showing which thread
+ * runs on it and a track per guest thread showing why it is not running.
+ *
+ * Recording does nothing unless the trace was started, so callers only pay for IsEnabled.
+ */
+class KSchedulerTrace {
+public:
+    enum class EventType : u8 {
+        ContextSwitch,
+        WakeUp,
+        PriorityChange,
+        Migration,
+        SvcEnter,
+        SvcExit,
+    };
+
+    struct Event {
+        s64 timestamp_ns;
+        u64 thread_id;
+        u64 other; ///< Previous thread of a switch, or the old priority or core
+        u32 value; ///< State of the previous thread, new priority or core, or SVC id
+        EventType type;
+        u8 core;
+        u8 flags;
+    };
+    static_assert(sizeof(Event) == 32, "Event has incorrect size.");
+
+    explicit KSchedulerTrace(KernelCore& kernel);
+    ~KSchedulerTrace();
+
+    SUYU_NON_COPYABLE(KSchedulerTrace);
+    SUYU_NON_MOVEABLE(KSchedulerTrace);
+
+    /// Starts recording, discarding any previously recorded events
+    void Start();
+
+    /// Stops recording, recorded events are kept until the next Start
+    void Stop();
+
+    /// Returns true while events are being recorded
+    [[nodiscard]] bool IsEnabled() const noexcept {
+        return is_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Records a context switch on a core, idle threads are only marked as such
+    void RecordContextSwitch(s32 core_id, const KThread* prev_thread, bool prev_is_idle,
+                             const KThread* next_thread, bool next_is_idle);
+
+    /// Records a waiting thread becoming runnable
+    void RecordWakeUp(const KThread* thread);
+
+    void RecordPriorityChange(const KThread* thread, s32 old_priority);
+
+    void RecordMigration(const KThread* thread, s32 old_core, s32 new_core);
+
+    void RecordSvcEnter(const KThread* thread, u32 svc_id);
+
+    void RecordSvcExit(const KThread* thread, u32 svc_id);
+
+    /// Writes the recorded events as a Chrome trace, returns true on success
+    bool Export(const std::filesystem::path& path) const;
+
+private:
+    /// One buffer per emulated core and one for every other host thread
+    static constexpr size_t NumBuffers = Core::Hardware::NUM_CPU_CORES + 1;
+
+    struct RingBuffer {
+        mutable Common::SpinLock lock;
+        std::vector<Event> events;
+        u64 num_recorded{};
+    };
+
+    void Push(Event event);
+
+    [[nodiscard]] std::vector<Event> CollectEvents() const;
+
+    KernelCore& m_kernel;
+    std::atomic_bool is_enabled{false};
+    s64 origin_ns{};
+    std::array<RingBuffer, NumBuffers> buffers;
+};
+
+} // namespace Kernel
@@ -4,6 +4,7 @@
 #include <array>
 #include <atomic>
 #include <bitset>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <thread>
@@ -11,9 +12,11 @@
 #include <utility>
 
 #include "common/assert.h"
+#include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #include "common/thread_worker.h"
 #include "core/arm/arm_interface.h"
@@ -34,6 +37,7 @@
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/kernel/k_resource_limit.h"
 #include "core/hle/kernel/k_scheduler.h"
+#include "core/hle/kernel/k_scheduler_trace.h"
 #include "core/hle/kernel/k_scoped_resource_reservation.h"
 #include "core/hle/kernel/k_shared_memory.h"
 #include "core/hle/kernel/k_system_resource.h"
@@ -41,6 +45,7 @@
 #include "core/hle/kernel/k_worker_task_manager.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/physical_core.h"
+#include "core/hle/kernel/svc_statistics.h"
 #include "core/hle/result.h"
 #include "core/hle/service/server_manager.h"
 #include "core/hle/service/sm/sm.h"
@@ -56,7 +61,8 @@ struct KernelCore::Impl {
     static constexpr size_t BlockInfoSlabHeapSize = 4000;
     static constexpr size_t ReservedDynamicPageCount = 64;
 
-    explicit Impl(Core::System& system_, KernelCore& kernel_) : system{system_} {}
+    explicit Impl(Core::System& system_, KernelCore& kernel_)
+        : system{system_}, scheduler_trace{kernel_} {}
 
     void SetMulticore(bool is_multi) {
         is_multicore = is_multi;
@@ -95,6 +101,25 @@ struct KernelCore::Impl {
 
         InitializeHackSharedMemory(kernel);
         RegisterHostThread(nullptr);
+
+        if (Settings::values.enable_scheduler_trace) {
+            scheduler_trace.Start();
+        }
+        svc_statistics.SetEnabled(Settings::values.enable_svc_statistics.GetValue());
+    }
+
+    void LogSvcStatistics() const {
+        constexpr size_t MaxLoggedSvcs = 16;
+        const auto entries = svc_statistics.Collect();
+        LOG_INFO(Kernel_SVC, "Host time spent in SVCs, most expensive first:");
+        for (size_t i = 0; i < std::min(entries.size(), MaxLoggedSvcs); ++i) {
+            const auto& entry = entries[i];
+            LOG_INFO(Kernel_SVC,
+                     "  0x{:02X} {:<28} calls={:<10} total={:>8} us mean={:>6} ns p50<{} ns "
+                     "p99<{} ns",
+                     entry.id, entry.name, entry.calls, entry.total_ns / 1000, entry.MeanNs(),
+                     entry.PercentileNs(50.0), entry.PercentileNs(99.0));
+        }
     }
 
     void TerminateAllProcesses() {
@@ -113,6 +138,17 @@ struct KernelCore::Impl {
             is_shutting_down.store(false, std::memory_order_relaxed);
         };
 
+        if (scheduler_trace.IsEnabled()) {
+            scheduler_trace.Stop();
+            scheduler_trace.Export(Common::FS::GetSuyuPath(Common::FS::SuyuPath::LogDir) /
+                                   "scheduler_trace.json");
+        }
+        if (svc_statistics.IsEnabled()) {
+            LogSvcStatistics();
+            svc_statistics.SetEnabled(false);
+            svc_statistics.Reset();
+        }
+
         CloseServices();
 
         if (application_process) {
@@ -846,6 +882,9 @@ struct KernelCore::Impl {
 
     // System context
     Core::System& system;
+
+    KSchedulerTrace scheduler_trace;
+    Kernel::SvcStatistics svc_statistics;
 };
 
 KernelCore::KernelCore(Core::System& system) : impl{std::make_unique<Impl>(system, *this)} {}
@@ -921,6 +960,14 @@ const Kernel::GlobalSchedulerContext& KernelCore::GlobalSchedulerContext() const
     return *impl->global_scheduler_context;
 }
 
+KSchedulerTrace& KernelCore::SchedulerTrace() {
+    return impl->scheduler_trace;
+}
+
+Kernel::SvcStatistics& KernelCore::SvcStatistics() {
+    return impl->svc_statistics;
+}
+
 Kernel::KScheduler& KernelCore::Scheduler(std::size_t id) {
     return *impl->schedulers[id];
 }
@@ -1278,11 +1325,32 @@ void KernelCore::ExceptionalExitApplication() {
     SuspendEmulation(true);
 }
 
-void KernelCore::EnterSVCProfile() {
+static u64 SteadyClockNs() {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+}
+
+u64 KernelCore::EnterSVCProfile(u32 svc_id) {
     impl->svc_ticks[CurrentPhysicalCoreIndex()] = MicroProfileEnter(MICROPROFILE_TOKEN(Kernel_SVC));
+    if (impl->scheduler_trace.IsEnabled()) [[unlikely]] {
+        impl->scheduler_trace.RecordSvcEnter(GetCurrentThreadPointer(*this), svc_id);
+    }
+    if (!impl->svc_statistics.IsEnabled()) [[likely]] {
+        return 0;
+    }
+    return SteadyClockNs();
 }
 
-void KernelCore::ExitSVCProfile() {
+void KernelCore::ExitSVCProfile(u32 svc_id, u64 start_ns) {
+    if (start_ns != 0) [[unlikely]] {
+        // The SVC may have rescheduled the calling thread onto another core
+        impl->svc_statistics.Record(CurrentPhysicalCoreIndex(), svc_id,
+                                    SteadyClockNs() - start_ns);
+    }
+    if (impl->scheduler_trace.IsEnabled()) [[unlikely]] {
+        impl->scheduler_trace.RecordSvcExit(GetCurrentThreadPointer(*this), svc_id);
+    }
     MicroProfileLeave(MICROPROFILE_TOKEN(Kernel_SVC), impl->svc_ticks[CurrentPhysicalCoreIndex()]);
 }
 
@@ -59,6 +59,8 @@ class KPort;
 class KProcess;
 class KResourceLimit;
 class KScheduler;
+class KSchedulerTrace;
+class SvcStatistics;
 class KServerPort;
 class KServerSession;
 class KSession;
@@ -139,6 +141,12 @@ public:
     /// Gets the sole instance of the global scheduler
     const Kernel::GlobalSchedulerContext& GlobalSchedulerContext() const;
 
+    /// Gets the tracer of the guest thread timeline
+    Kernel::KSchedulerTrace& SchedulerTrace();
+
+    /// Gets the counters of the host time spent in each SVC
+    Kernel::SvcStatistics& SvcStatistics();
+
     /// Gets the sole instance of the Scheduler assoviated with cpu core 'id'
     Kernel::KScheduler& Scheduler(std::size_t id);
 
@@ -271,9 +279,10 @@ public:
 
     bool IsShuttingDown() const;
 
-    void EnterSVCProfile();
+    /// Returns the host time in ns at which the SVC started when SVC statistics are enabled, or 0
+    u64 EnterSVCProfile(u32 svc_id);
 
-    void ExitSVCProfile();
+    void ExitSVCProfile(u32 svc_id, u64 start_ns);
 
     /// Workaround for single-core mode when preempting threads while idle.
     bool IsPhantomModeForSingleCore() const;
@@ -160,7 +160,7 @@ void PhysicalCore::LoadContext(const KThread* thread) {
     }
 }
 
-void PhysicalCore::LoadSvcArguments(const KProcess& process, std::span<const uint64_t, 8> args) {
+void PhysicalCore::LoadSvcArguments(const KProcess& process, std::span<const uint64_t> args) {
     process.GetArmInterface(m_core_index)->SetSvcArguments(args);
 }
 
@@ -177,7 +177,7 @@ void PhysicalCore::SaveContext(KThread* thread) const {
     }
 }
 
-void PhysicalCore::SaveSvcArguments(KProcess& process, std::span<uint64_t, 8> args) const {
+void PhysicalCore::SaveSvcArguments(KProcess& process, std::span<uint64_t> args) const {
     process.GetArmInterface(m_core_index)->GetSvcArguments(args);
 }
 
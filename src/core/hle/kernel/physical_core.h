@@ -34,11 +34,11 @@ public:
 
     // Copy context from thread to current core.
     void LoadContext(const KThread* thread);
-    void LoadSvcArguments(const KProcess& process, std::span<const uint64_t, 8> args);
+    void LoadSvcArguments(const KProcess& process, std::span<const uint64_t> args);
 
     // Copy context from current core to thread.
     void SaveContext(KThread* thread) const;
-    void SaveSvcArguments(KProcess& process, std::span<uint64_t, 8> args) const;
+    void SaveSvcArguments(KProcess& process, std::span<uint64_t> args) const;
 
     // Copy floating point status registers to the target thread.
     void CloneFpuStatus(KThread* dst) const;
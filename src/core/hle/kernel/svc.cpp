@@ -3,6 +3,8 @@
 
 // This file is automatically generated using svc_generator.py.
 
+#include <array>
+#include <string_view>
 #include <type_traits>
 
 #include "core/arm/arm_interface.h"
@@ -28,6 +30,15 @@ static void SetArg64(std::span<uint64_t, 8> args, int n, uint64_t result) {
     args[n] = result;
 }
 
+using SvcWrapper = void (*)(Core::System& system, std::span<uint64_t, 8> args);
+
+// Dispatch table entry, only the argument registers an SVC uses are transferred.
+struct SvcTableEntry {
+    SvcWrapper wrapper;
+    u8 num_inputs;
+    u8 num_outputs;
+};
+
 // Like bit_cast, but handles the case when the source and dest
 // are differently-sized.
 template <typename To, typename From>
@@ -3913,531 +3924,425 @@ static void SvcWrap_UnmapInsecureMemory64(Core::System& system, std::span<uint64
     SetArg64(args, 0, Convert<uint64_t>(ret));
 }
 
-static void Call32(Core::System& system, u32 imm, std::span<uint64_t, 8> args) {
-    switch (static_cast<SvcId>(imm)) {
-    case SvcId::SetHeapSize:
-        return SvcWrap_SetHeapSize64From32(system, args);
-    case SvcId::SetMemoryPermission:
-        return SvcWrap_SetMemoryPermission64From32(system, args);
-    case SvcId::SetMemoryAttribute:
-        return SvcWrap_SetMemoryAttribute64From32(system, args);
-    case SvcId::MapMemory:
-        return SvcWrap_MapMemory64From32(system, args);
-    case SvcId::UnmapMemory:
-        return SvcWrap_UnmapMemory64From32(system, args);
-    case SvcId::QueryMemory:
-        return SvcWrap_QueryMemory64From32(system, args);
-    case SvcId::ExitProcess:
-        return SvcWrap_ExitProcess64From32(system, args);
-    case SvcId::CreateThread:
-        return SvcWrap_CreateThread64From32(system, args);
-    case SvcId::StartThread:
-        return SvcWrap_StartThread64From32(system, args);
-    case SvcId::ExitThread:
-        return SvcWrap_ExitThread64From32(system, args);
-    case SvcId::SleepThread:
-        return SvcWrap_SleepThread64From32(system, args);
-    case SvcId::GetThreadPriority:
-        return SvcWrap_GetThreadPriority64From32(system, args);
-    case SvcId::SetThreadPriority:
-        return SvcWrap_SetThreadPriority64From32(system, args);
-    case SvcId::GetThreadCoreMask:
-        return SvcWrap_GetThreadCoreMask64From32(system, args);
-    case SvcId::SetThreadCoreMask:
-        return SvcWrap_SetThreadCoreMask64From32(system, args);
-    case SvcId::GetCurrentProcessorNumber:
-        return SvcWrap_GetCurrentProcessorNumber64From32(system, args);
-    case SvcId::SignalEvent:
-        return SvcWrap_SignalEvent64From32(system, args);
-    case SvcId::ClearEvent:
-        return SvcWrap_ClearEvent64From32(system, args);
-    case SvcId::MapSharedMemory:
-        return SvcWrap_MapSharedMemory64From32(system, args);
-    case SvcId::UnmapSharedMemory:
-        return SvcWrap_UnmapSharedMemory64From32(system, args);
-    case SvcId::CreateTransferMemory:
-        return SvcWrap_CreateTransferMemory64From32(system, args);
-    case SvcId::CloseHandle:
-        return SvcWrap_CloseHandle64From32(system, args);
-    case SvcId::ResetSignal:
-        return SvcWrap_ResetSignal64From32(system, args);
-    case SvcId::WaitSynchronization:
-        return SvcWrap_WaitSynchronization64From32(system, args);
-    case SvcId::CancelSynchronization:
-        return SvcWrap_CancelSynchronization64From32(system, args);
-    case SvcId::ArbitrateLock:
-        return SvcWrap_ArbitrateLock64From32(system, args);
-    case SvcId::ArbitrateUnlock:
-        return SvcWrap_ArbitrateUnlock64From32(system, args);
-    case SvcId::WaitProcessWideKeyAtomic:
-        return SvcWrap_WaitProcessWideKeyAtomic64From32(system, args);
-    case SvcId::SignalProcessWideKey:
-        return SvcWrap_SignalProcessWideKey64From32(system, args);
-    case SvcId::GetSystemTick:
-        return SvcWrap_GetSystemTick64From32(system, args);
-    case SvcId::ConnectToNamedPort:
-        return SvcWrap_ConnectToNamedPort64From32(system, args);
-    case SvcId::SendSyncRequestLight:
-        return SvcWrap_SendSyncRequestLight64From32(system, args);
-    case SvcId::SendSyncRequest:
-        return SvcWrap_SendSyncRequest64From32(system, args);
-    case SvcId::SendSyncRequestWithUserBuffer:
-        return SvcWrap_SendSyncRequestWithUserBuffer64From32(system, args);
-    case SvcId::SendAsyncRequestWithUserBuffer:
-        return SvcWrap_SendAsyncRequestWithUserBuffer64From32(system, args);
-    case SvcId::GetProcessId:
-        return SvcWrap_GetProcessId64From32(system, args);
-    case SvcId::GetThreadId:
-        return SvcWrap_GetThreadId64From32(system, args);
-    case SvcId::Break:
-        return SvcWrap_Break64From32(system, args);
-    case SvcId::OutputDebugString:
-        return SvcWrap_OutputDebugString64From32(system, args);
-    case SvcId::ReturnFromException:
-        return SvcWrap_ReturnFromException64From32(system, args);
-    case SvcId::GetInfo:
-        return SvcWrap_GetInfo64From32(system, args);
-    case SvcId::FlushEntireDataCache:
-        return SvcWrap_FlushEntireDataCache64From32(system, args);
-    case SvcId::FlushDataCache:
-        return SvcWrap_FlushDataCache64From32(system, args);
-    case SvcId::MapPhysicalMemory:
-        return SvcWrap_MapPhysicalMemory64From32(system, args);
-    case SvcId::UnmapPhysicalMemory:
-        return SvcWrap_UnmapPhysicalMemory64From32(system, args);
-    case SvcId::GetDebugFutureThreadInfo:
-        return SvcWrap_GetDebugFutureThreadInfo64From32(system, args);
-    case SvcId::GetLastThreadInfo:
-        return SvcWrap_GetLastThreadInfo64From32(system, args);
-    case SvcId::GetResourceLimitLimitValue:
-        return SvcWrap_GetResourceLimitLimitValue64From32(system, args);
-    case SvcId::GetResourceLimitCurrentValue:
-        return SvcWrap_GetResourceLimitCurrentValue64From32(system, args);
-    case SvcId::SetThreadActivity:
-        return SvcWrap_SetThreadActivity64From32(system, args);
-    case SvcId::GetThreadContext3:
-        return SvcWrap_GetThreadContext364From32(system, args);
-    case SvcId::WaitForAddress:
-        return SvcWrap_WaitForAddress64From32(system, args);
-    case SvcId::SignalToAddress:
-        return SvcWrap_SignalToAddress64From32(system, args);
-    case SvcId::SynchronizePreemptionState:
-        return SvcWrap_SynchronizePreemptionState64From32(system, args);
-    case SvcId::GetResourceLimitPeakValue:
-        return SvcWrap_GetResourceLimitPeakValue64From32(system, args);
-    case SvcId::CreateIoPool:
-        return SvcWrap_CreateIoPool64From32(system, args);
-    case SvcId::CreateIoRegion:
-        return SvcWrap_CreateIoRegion64From32(system, args);
-    case SvcId::KernelDebug:
-        return SvcWrap_KernelDebug64From32(system, args);
-    case SvcId::ChangeKernelTraceState:
-        return SvcWrap_ChangeKernelTraceState64From32(system, args);
-    case SvcId::CreateSession:
-        return SvcWrap_CreateSession64From32(system, args);
-    case SvcId::AcceptSession:
-        return SvcWrap_AcceptSession64From32(system, args);
-    case SvcId::ReplyAndReceiveLight:
-        return SvcWrap_ReplyAndReceiveLight64From32(system, args);
-    case SvcId::ReplyAndReceive:
-        return SvcWrap_ReplyAndReceive64From32(system, args);
-    case SvcId::ReplyAndReceiveWithUserBuffer:
-        return SvcWrap_ReplyAndReceiveWithUserBuffer64From32(system, args);
-    case SvcId::CreateEvent:
-        return SvcWrap_CreateEvent64From32(system, args);
-    case SvcId::MapIoRegion:
-        return SvcWrap_MapIoRegion64From32(system, args);
-    case SvcId::UnmapIoRegion:
-        return SvcWrap_UnmapIoRegion64From32(system, args);
-    case SvcId::MapPhysicalMemoryUnsafe:
-        return SvcWrap_MapPhysicalMemoryUnsafe64From32(system, args);
-    case SvcId::UnmapPhysicalMemoryUnsafe:
-        return SvcWrap_UnmapPhysicalMemoryUnsafe64From32(system, args);
-    case SvcId::SetUnsafeLimit:
-        return SvcWrap_SetUnsafeLimit64From32(system, args);
-    case SvcId::CreateCodeMemory:
-        return SvcWrap_CreateCodeMemory64From32(system, args);
-    case SvcId::ControlCodeMemory:
-        return SvcWrap_ControlCodeMemory64From32(system, args);
-    case SvcId::SleepSystem:
-        return SvcWrap_SleepSystem64From32(system, args);
-    case SvcId::ReadWriteRegister:
-        return SvcWrap_ReadWriteRegister64From32(system, args);
-    case SvcId::SetProcessActivity:
-        return SvcWrap_SetProcessActivity64From32(system, args);
-    case SvcId::CreateSharedMemory:
-        return SvcWrap_CreateSharedMemory64From32(system, args);
-    case SvcId::MapTransferMemory:
-        return SvcWrap_MapTransferMemory64From32(system, args);
-    case SvcId::UnmapTransferMemory:
-        return SvcWrap_UnmapTransferMemory64From32(system, args);
-    case SvcId::CreateInterruptEvent:
-        return SvcWrap_CreateInterruptEvent64From32(system, args);
-    case SvcId::QueryPhysicalAddress:
-        return SvcWrap_QueryPhysicalAddress64From32(system, args);
-    case SvcId::QueryIoMapping:
-        return SvcWrap_QueryIoMapping64From32(system, args);
-    case SvcId::CreateDeviceAddressSpace:
-        return SvcWrap_CreateDeviceAddressSpace64From32(system, args);
-    case SvcId::AttachDeviceAddressSpace:
-        return SvcWrap_AttachDeviceAddressSpace64From32(system, args);
-    case SvcId::DetachDeviceAddressSpace:
-        return SvcWrap_DetachDeviceAddressSpace64From32(system, args);
-    case SvcId::MapDeviceAddressSpaceByForce:
-        return SvcWrap_MapDeviceAddressSpaceByForce64From32(system, args);
-    case SvcId::MapDeviceAddressSpaceAligned:
-        return SvcWrap_MapDeviceAddressSpaceAligned64From32(system, args);
-    case SvcId::UnmapDeviceAddressSpace:
-        return SvcWrap_UnmapDeviceAddressSpace64From32(system, args);
-    case SvcId::InvalidateProcessDataCache:
-        return SvcWrap_InvalidateProcessDataCache64From32(system, args);
-    case SvcId::StoreProcessDataCache:
-        return SvcWrap_StoreProcessDataCache64From32(system, args);
-    case SvcId::FlushProcessDataCache:
-        return SvcWrap_FlushProcessDataCache64From32(system, args);
-    case SvcId::DebugActiveProcess:
-        return SvcWrap_DebugActiveProcess64From32(system, args);
-    case SvcId::BreakDebugProcess:
-        return SvcWrap_BreakDebugProcess64From32(system, args);
-    case SvcId::TerminateDebugProcess:
-        return SvcWrap_TerminateDebugProcess64From32(system, args);
-    case SvcId::GetDebugEvent:
-        return SvcWrap_GetDebugEvent64From32(system, args);
-    case SvcId::ContinueDebugEvent:
-        return SvcWrap_ContinueDebugEvent64From32(system, args);
-    case SvcId::GetProcessList:
-        return SvcWrap_GetProcessList64From32(system, args);
-    case SvcId::GetThreadList:
-        return SvcWrap_GetThreadList64From32(system, args);
-    case SvcId::GetDebugThreadContext:
-        return SvcWrap_GetDebugThreadContext64From32(system, args);
-    case SvcId::SetDebugThreadContext:
-        return SvcWrap_SetDebugThreadContext64From32(system, args);
-    case SvcId::QueryDebugProcessMemory:
-        return SvcWrap_QueryDebugProcessMemory64From32(system, args);
-    case SvcId::ReadDebugProcessMemory:
-        return SvcWrap_ReadDebugProcessMemory64From32(system, args);
-    case SvcId::WriteDebugProcessMemory:
-        return SvcWrap_WriteDebugProcessMemory64From32(system, args);
-    case SvcId::SetHardwareBreakPoint:
-        return SvcWrap_SetHardwareBreakPoint64From32(system, args);
-    case SvcId::GetDebugThreadParam:
-        return SvcWrap_GetDebugThreadParam64From32(system, args);
-    case SvcId::GetSystemInfo:
-        return SvcWrap_GetSystemInfo64From32(system, args);
-    case SvcId::CreatePort:
-        return SvcWrap_CreatePort64From32(system, args);
-    case SvcId::ManageNamedPort:
-        return SvcWrap_ManageNamedPort64From32(system, args);
-    case SvcId::ConnectToPort:
-        return SvcWrap_ConnectToPort64From32(system, args);
-    case SvcId::SetProcessMemoryPermission:
-        return SvcWrap_SetProcessMemoryPermission64From32(system, args);
-    case SvcId::MapProcessMemory:
-        return SvcWrap_MapProcessMemory64From32(system, args);
-    case SvcId::UnmapProcessMemory:
-        return SvcWrap_UnmapProcessMemory64From32(system, args);
-    case SvcId::QueryProcessMemory:
-        return SvcWrap_QueryProcessMemory64From32(system, args);
-    case SvcId::MapProcessCodeMemory:
-        return SvcWrap_MapProcessCodeMemory64From32(system, args);
-    case SvcId::UnmapProcessCodeMemory:
-        return SvcWrap_UnmapProcessCodeMemory64From32(system, args);
-    case SvcId::CreateProcess:
-        return SvcWrap_CreateProcess64From32(system, args);
-    case SvcId::StartProcess:
-        return SvcWrap_StartProcess64From32(system, args);
-    case SvcId::TerminateProcess:
-        return SvcWrap_TerminateProcess64From32(system, args);
-    case SvcId::GetProcessInfo:
-        return SvcWrap_GetProcessInfo64From32(system, args);
-    case SvcId::CreateResourceLimit:
-        return SvcWrap_CreateResourceLimit64From32(system, args);
-    case SvcId::SetResourceLimitLimitValue:
-        return SvcWrap_SetResourceLimitLimitValue64From32(system, args);
-    case SvcId::CallSecureMonitor:
-        return SvcWrap_CallSecureMonitor64From32(system, args);
-    case SvcId::MapInsecureMemory:
-        return SvcWrap_MapInsecureMemory64From32(system, args);
-    case SvcId::UnmapInsecureMemory:
-        return SvcWrap_UnmapInsecureMemory64From32(system, args);
-    default:
-        LOG_CRITICAL(Kernel_SVC, "Unknown SVC {:x}!", imm);
-        break;
-    }
-}
-
-static void Call64(Core::System& system, u32 imm, std::span<uint64_t, 8> args) {
-    switch (static_cast<SvcId>(imm)) {
-    case SvcId::SetHeapSize:
-        return SvcWrap_SetHeapSize64(system, args);
-    case SvcId::SetMemoryPermission:
-        return SvcWrap_SetMemoryPermission64(system, args);
-    case SvcId::SetMemoryAttribute:
-        return SvcWrap_SetMemoryAttribute64(system, args);
-    case SvcId::MapMemory:
-        return SvcWrap_MapMemory64(system, args);
-    case SvcId::UnmapMemory:
-        return SvcWrap_UnmapMemory64(system, args);
-    case SvcId::QueryMemory:
-        return SvcWrap_QueryMemory64(system, args);
-    case SvcId::ExitProcess:
-        return SvcWrap_ExitProcess64(system, args);
-    case SvcId::CreateThread:
-        return SvcWrap_CreateThread64(system, args);
-    case SvcId::StartThread:
-        return SvcWrap_StartThread64(system, args);
-    case SvcId::ExitThread:
-        return SvcWrap_ExitThread64(system, args);
-    case SvcId::SleepThread:
-        return SvcWrap_SleepThread64(system, args);
-    case SvcId::GetThreadPriority:
-        return SvcWrap_GetThreadPriority64(system, args);
-    case SvcId::SetThreadPriority:
-        return SvcWrap_SetThreadPriority64(system, args);
-    case SvcId::GetThreadCoreMask:
-        return SvcWrap_GetThreadCoreMask64(system, args);
-    case SvcId::SetThreadCoreMask:
-        return SvcWrap_SetThreadCoreMask64(system, args);
-    case SvcId::GetCurrentProcessorNumber:
-        return SvcWrap_GetCurrentProcessorNumber64(system, args);
-    case SvcId::SignalEvent:
-        return SvcWrap_SignalEvent64(system, args);
-    case SvcId::ClearEvent:
-        return SvcWrap_ClearEvent64(system, args);
-    case SvcId::MapSharedMemory:
-        return SvcWrap_MapSharedMemory64(system, args);
-    case SvcId::UnmapSharedMemory:
-        return SvcWrap_UnmapSharedMemory64(system, args);
-    case SvcId::CreateTransferMemory:
-        return SvcWrap_CreateTransferMemory64(system, args);
-    case SvcId::CloseHandle:
-        return SvcWrap_CloseHandle64(system, args);
-    case SvcId::ResetSignal:
-        return SvcWrap_ResetSignal64(system, args);
-    case SvcId::WaitSynchronization:
-        return SvcWrap_WaitSynchronization64(system, args);
-    case SvcId::CancelSynchronization:
-        return SvcWrap_CancelSynchronization64(system, args);
-    case SvcId::ArbitrateLock:
-        return SvcWrap_ArbitrateLock64(system, args);
-    case SvcId::ArbitrateUnlock:
-        return SvcWrap_ArbitrateUnlock64(system, args);
-    case SvcId::WaitProcessWideKeyAtomic:
-        return SvcWrap_WaitProcessWideKeyAtomic64(system, args);
-    case SvcId::SignalProcessWideKey:
-        return SvcWrap_SignalProcessWideKey64(system, args);
-    case SvcId::GetSystemTick:
-        return SvcWrap_GetSystemTick64(system, args);
-    case SvcId::ConnectToNamedPort:
-        return SvcWrap_ConnectToNamedPort64(system, args);
-    case SvcId::SendSyncRequestLight:
-        return SvcWrap_SendSyncRequestLight64(system, args);
-    case SvcId::SendSyncRequest:
-        return SvcWrap_SendSyncRequest64(system, args);
-    case SvcId::SendSyncRequestWithUserBuffer:
-        return SvcWrap_SendSyncRequestWithUserBuffer64(system, args);
-    case SvcId::SendAsyncRequestWithUserBuffer:
-        return SvcWrap_SendAsyncRequestWithUserBuffer64(system, args);
-    case SvcId::GetProcessId:
-        return SvcWrap_GetProcessId64(system, args);
-    case SvcId::GetThreadId:
-        return SvcWrap_GetThreadId64(system, args);
-    case SvcId::Break:
-        return SvcWrap_Break64(system, args);
-    case SvcId::OutputDebugString:
-        return SvcWrap_OutputDebugString64(system, args);
-    case SvcId::ReturnFromException:
-        return SvcWrap_ReturnFromException64(system, args);
-    case SvcId::GetInfo:
-        return SvcWrap_GetInfo64(system, args);
-    case SvcId::FlushEntireDataCache:
-        return SvcWrap_FlushEntireDataCache64(system, args);
-    case SvcId::FlushDataCache:
-        return SvcWrap_FlushDataCache64(system, args);
-    case SvcId::MapPhysicalMemory:
-        return SvcWrap_MapPhysicalMemory64(system, args);
-    case SvcId::UnmapPhysicalMemory:
-        return SvcWrap_UnmapPhysicalMemory64(system, args);
-    case SvcId::GetDebugFutureThreadInfo:
-        return SvcWrap_GetDebugFutureThreadInfo64(system, args);
-    case SvcId::GetLastThreadInfo:
-        return SvcWrap_GetLastThreadInfo64(system, args);
-    case SvcId::GetResourceLimitLimitValue:
-        return SvcWrap_GetResourceLimitLimitValue64(system, args);
-    case SvcId::GetResourceLimitCurrentValue:
-        return SvcWrap_GetResourceLimitCurrentValue64(system, args);
-    case SvcId::SetThreadActivity:
-        return SvcWrap_SetThreadActivity64(system, args);
-    case SvcId::GetThreadContext3:
-        return SvcWrap_GetThreadContext364(system, args);
-    case SvcId::WaitForAddress:
-        return SvcWrap_WaitForAddress64(system, args);
-    case SvcId::SignalToAddress:
-        return SvcWrap_SignalToAddress64(system, args);
-    case SvcId::SynchronizePreemptionState:
-        return SvcWrap_SynchronizePreemptionState64(system, args);
-    case SvcId::GetResourceLimitPeakValue:
-        return SvcWrap_GetResourceLimitPeakValue64(system, args);
-    case SvcId::CreateIoPool:
-        return SvcWrap_CreateIoPool64(system, args);
-    case SvcId::CreateIoRegion:
-        return SvcWrap_CreateIoRegion64(system, args);
-    case SvcId::KernelDebug:
-        return SvcWrap_KernelDebug64(system, args);
-    case SvcId::ChangeKernelTraceState:
-        return SvcWrap_ChangeKernelTraceState64(system, args);
-    case SvcId::CreateSession:
-        return SvcWrap_CreateSession64(system, args);
-    case SvcId::AcceptSession:
-        return SvcWrap_AcceptSession64(system, args);
-    case SvcId::ReplyAndReceiveLight:
-        return SvcWrap_ReplyAndReceiveLight64(system, args);
-    case SvcId::ReplyAndReceive:
-        return SvcWrap_ReplyAndReceive64(system, args);
-    case SvcId::ReplyAndReceiveWithUserBuffer:
-        return SvcWrap_ReplyAndReceiveWithUserBuffer64(system, args);
-    case SvcId::CreateEvent:
-        return SvcWrap_CreateEvent64(system, args);
-    case SvcId::MapIoRegion:
-        return SvcWrap_MapIoRegion64(system, args);
-    case SvcId::UnmapIoRegion:
-        return SvcWrap_UnmapIoRegion64(system, args);
-    case SvcId::MapPhysicalMemoryUnsafe:
-        return SvcWrap_MapPhysicalMemoryUnsafe64(system, args);
-    case SvcId::UnmapPhysicalMemoryUnsafe:
-        return SvcWrap_UnmapPhysicalMemoryUnsafe64(system, args);
-    case SvcId::SetUnsafeLimit:
-        return SvcWrap_SetUnsafeLimit64(system, args);
-    case SvcId::CreateCodeMemory:
-        return SvcWrap_CreateCodeMemory64(system, args);
-    case SvcId::ControlCodeMemory:
-        return SvcWrap_ControlCodeMemory64(system, args);
-    case SvcId::SleepSystem:
-        return SvcWrap_SleepSystem64(system, args);
-    case SvcId::ReadWriteRegister:
-        return SvcWrap_ReadWriteRegister64(system, args);
-    case SvcId::SetProcessActivity:
-        return SvcWrap_SetProcessActivity64(system, args);
-    case SvcId::CreateSharedMemory:
-        return SvcWrap_CreateSharedMemory64(system, args);
-    case SvcId::MapTransferMemory:
-        return SvcWrap_MapTransferMemory64(system, args);
-    case SvcId::UnmapTransferMemory:
-        return SvcWrap_UnmapTransferMemory64(system, args);
-    case SvcId::CreateInterruptEvent:
-        return SvcWrap_CreateInterruptEvent64(system, args);
-    case SvcId::QueryPhysicalAddress:
-        return SvcWrap_QueryPhysicalAddress64(system, args);
-    case SvcId::QueryIoMapping:
-        return SvcWrap_QueryIoMapping64(system, args);
-    case SvcId::CreateDeviceAddressSpace:
-        return SvcWrap_CreateDeviceAddressSpace64(system, args);
-    case SvcId::AttachDeviceAddressSpace:
-        return SvcWrap_AttachDeviceAddressSpace64(system, args);
-    case SvcId::DetachDeviceAddressSpace:
-        return SvcWrap_DetachDeviceAddressSpace64(system, args);
-    case SvcId::MapDeviceAddressSpaceByForce:
-        return SvcWrap_MapDeviceAddressSpaceByForce64(system, args);
-    case SvcId::MapDeviceAddressSpaceAligned:
-        return SvcWrap_MapDeviceAddressSpaceAligned64(system, args);
-    case SvcId::UnmapDeviceAddressSpace:
-        return SvcWrap_UnmapDeviceAddressSpace64(system, args);
-    case SvcId::InvalidateProcessDataCache:
-        return SvcWrap_InvalidateProcessDataCache64(system, args);
-    case SvcId::StoreProcessDataCache:
-        return SvcWrap_StoreProcessDataCache64(system, args);
-    case SvcId::FlushProcessDataCache:
-        return SvcWrap_FlushProcessDataCache64(system, args);
-    case SvcId::DebugActiveProcess:
-        return SvcWrap_DebugActiveProcess64(system, args);
-    case SvcId::BreakDebugProcess:
-        return SvcWrap_BreakDebugProcess64(system, args);
-    case SvcId::TerminateDebugProcess:
-        return SvcWrap_TerminateDebugProcess64(system, args);
-    case SvcId::GetDebugEvent:
-        return SvcWrap_GetDebugEvent64(system, args);
-    case SvcId::ContinueDebugEvent:
-        return SvcWrap_ContinueDebugEvent64(system, args);
-    case SvcId::GetProcessList:
-        return SvcWrap_GetProcessList64(system, args);
-    case SvcId::GetThreadList:
-        return SvcWrap_GetThreadList64(system, args);
-    case SvcId::GetDebugThreadContext:
-        return SvcWrap_GetDebugThreadContext64(system, args);
-    case SvcId::SetDebugThreadContext:
-        return SvcWrap_SetDebugThreadContext64(system, args);
-    case SvcId::QueryDebugProcessMemory:
-        return SvcWrap_QueryDebugProcessMemory64(system, args);
-    case SvcId::ReadDebugProcessMemory:
-        return SvcWrap_ReadDebugProcessMemory64(system, args);
-    case SvcId::WriteDebugProcessMemory:
-        return SvcWrap_WriteDebugProcessMemory64(system, args);
-    case SvcId::SetHardwareBreakPoint:
-        return SvcWrap_SetHardwareBreakPoint64(system, args);
-    case SvcId::GetDebugThreadParam:
-        return SvcWrap_GetDebugThreadParam64(system, args);
-    case SvcId::GetSystemInfo:
-        return SvcWrap_GetSystemInfo64(system, args);
-    case SvcId::CreatePort:
-        return SvcWrap_CreatePort64(system, args);
-    case SvcId::ManageNamedPort:
-        return SvcWrap_ManageNamedPort64(system, args);
-    case SvcId::ConnectToPort:
-        return SvcWrap_ConnectToPort64(system, args);
-    case SvcId::SetProcessMemoryPermission:
-        return SvcWrap_SetProcessMemoryPermission64(system, args);
-    case SvcId::MapProcessMemory:
-        return SvcWrap_MapProcessMemory64(system, args);
-    case SvcId::UnmapProcessMemory:
-        return SvcWrap_UnmapProcessMemory64(system, args);
-    case SvcId::QueryProcessMemory:
-        return SvcWrap_QueryProcessMemory64(system, args);
-    case SvcId::MapProcessCodeMemory:
-        return SvcWrap_MapProcessCodeMemory64(system, args);
-    case SvcId::UnmapProcessCodeMemory:
-        return SvcWrap_UnmapProcessCodeMemory64(system, args);
-    case SvcId::CreateProcess:
-        return SvcWrap_CreateProcess64(system, args);
-    case SvcId::StartProcess:
-        return SvcWrap_StartProcess64(system, args);
-    case SvcId::TerminateProcess:
-        return SvcWrap_TerminateProcess64(system, args);
-    case SvcId::GetProcessInfo:
-        return SvcWrap_GetProcessInfo64(system, args);
-    case SvcId::CreateResourceLimit:
-        return SvcWrap_CreateResourceLimit64(system, args);
-    case SvcId::SetResourceLimitLimitValue:
-        return SvcWrap_SetResourceLimitLimitValue64(system, args);
-    case SvcId::CallSecureMonitor:
-        return SvcWrap_CallSecureMonitor64(system, args);
-    case SvcId::MapInsecureMemory:
-        return SvcWrap_MapInsecureMemory64(system, args);
-    case SvcId::UnmapInsecureMemory:
-        return SvcWrap_UnmapInsecureMemory64(system, args);
-    default:
-        LOG_CRITICAL(Kernel_SVC, "Unknown SVC {:x}!", imm);
-        break;
-    }
-}
+static constexpr std::array<SvcTableEntry, 0x80> SvcTable64From32{{
+    /* 0x00 */ {},
+    /* 0x01 */ {SvcWrap_SetHeapSize64From32, 2, 2},
+    /* 0x02 */ {SvcWrap_SetMemoryPermission64From32, 3, 1},
+    /* 0x03 */ {SvcWrap_SetMemoryAttribute64From32, 4, 1},
+    /* 0x04 */ {SvcWrap_MapMemory64From32, 3, 1},
+    /* 0x05 */ {SvcWrap_UnmapMemory64From32, 3, 1},
+    /* 0x06 */ {SvcWrap_QueryMemory64From32, 3, 2},
+    /* 0x07 */ {SvcWrap_ExitProcess64From32, 0, 0},
+    /* 0x08 */ {SvcWrap_CreateThread64From32, 5, 2},
+    /* 0x09 */ {SvcWrap_StartThread64From32, 1, 1},
+    /* 0x0a */ {SvcWrap_ExitThread64From32, 0, 0},
+    /* 0x0b */ {SvcWrap_SleepThread64From32, 2, 0},
+    /* 0x0c */ {SvcWrap_GetThreadPriority64From32, 2, 2},
+    /* 0x0d */ {SvcWrap_SetThreadPriority64From32, 2, 1},
+    /* 0x0e */ {SvcWrap_GetThreadCoreMask64From32, 3, 4},
+    /* 0x0f */ {SvcWrap_SetThreadCoreMask64From32, 4, 1},
+    /* 0x10 */ {SvcWrap_GetCurrentProcessorNumber64From32, 0, 1},
+    /* 0x11 */ {SvcWrap_SignalEvent64From32, 1, 1},
+    /* 0x12 */ {SvcWrap_ClearEvent64From32, 1, 1},
+    /* 0x13 */ {SvcWrap_MapSharedMemory64From32, 4, 1},
+    /* 0x14 */ {SvcWrap_UnmapSharedMemory64From32, 3, 1},
+    /* 0x15 */ {SvcWrap_CreateTransferMemory64From32, 4, 2},
+    /* 0x16 */ {SvcWrap_CloseHandle64From32, 1, 1},
+    /* 0x17 */ {SvcWrap_ResetSignal64From32, 1, 1},
+    /* 0x18 */ {SvcWrap_WaitSynchronization64From32, 4, 2},
+    /* 0x19 */ {SvcWrap_CancelSynchronization64From32, 1, 1},
+    /* 0x1a */ {SvcWrap_ArbitrateLock64From32, 3, 1},
+    /* 0x1b */ {SvcWrap_ArbitrateUnlock64From32, 1, 1},
+    /* 0x1c */ {SvcWrap_WaitProcessWideKeyAtomic64From32, 5, 1},
+    /* 0x1d */ {SvcWrap_SignalProcessWideKey64From32, 2, 0},
+    /* 0x1e */ {SvcWrap_GetSystemTick64From32, 0, 2},
+    /* 0x1f */ {SvcWrap_ConnectToNamedPort64From32, 2, 2},
+    /* 0x20 */ {SvcWrap_SendSyncRequestLight64From32, 8, 8},
+    /* 0x21 */ {SvcWrap_SendSyncRequest64From32, 1, 1},
+    /* 0x22 */ {SvcWrap_SendSyncRequestWithUserBuffer64From32, 3, 1},
+    /* 0x23 */ {SvcWrap_SendAsyncRequestWithUserBuffer64From32, 4, 2},
+    /* 0x24 */ {SvcWrap_GetProcessId64From32, 2, 3},
+    /* 0x25 */ {SvcWrap_GetThreadId64From32, 2, 3},
+    /* 0x26 */ {SvcWrap_Break64From32, 3, 0},
+    /* 0x27 */ {SvcWrap_OutputDebugString64From32, 2, 1},
+    /* 0x28 */ {SvcWrap_ReturnFromException64From32, 1, 0},
+    /* 0x29 */ {SvcWrap_GetInfo64From32, 4, 3},
+    /* 0x2a */ {SvcWrap_FlushEntireDataCache64From32, 0, 0},
+    /* 0x2b */ {SvcWrap_FlushDataCache64From32, 2, 1},
+    /* 0x2c */ {SvcWrap_MapPhysicalMemory64From32, 2, 1},
+    /* 0x2d */ {SvcWrap_UnmapPhysicalMemory64From32, 2, 1},
+    /* 0x2e */ {SvcWrap_GetDebugFutureThreadInfo64From32, 3, 7},
+    /* 0x2f */ {SvcWrap_GetLastThreadInfo64From32, 0, 7},
+    /* 0x30 */ {SvcWrap_GetResourceLimitLimitValue64From32, 3, 3},
+    /* 0x31 */ {SvcWrap_GetResourceLimitCurrentValue64From32, 3, 3},
+    /* 0x32 */ {SvcWrap_SetThreadActivity64From32, 2, 1},
+    /* 0x33 */ {SvcWrap_GetThreadContext364From32, 2, 1},
+    /* 0x34 */ {SvcWrap_WaitForAddress64From32, 5, 1},
+    /* 0x35 */ {SvcWrap_SignalToAddress64From32, 4, 1},
+    /* 0x36 */ {SvcWrap_SynchronizePreemptionState64From32, 0, 0},
+    /* 0x37 */ {SvcWrap_GetResourceLimitPeakValue64From32, 3, 3},
+    /* 0x38 */ {},
+    /* 0x39 */ {SvcWrap_CreateIoPool64From32, 2, 2},
+    /* 0x3a */ {SvcWrap_CreateIoRegion64From32, 6, 2},
+    /* 0x3b */ {},
+    /* 0x3c */ {SvcWrap_KernelDebug64From32, 7, 0},
+    /* 0x3d */ {SvcWrap_ChangeKernelTraceState64From32, 1, 0},
+    /* 0x3e */ {},
+    /* 0x3f */ {},
+    /* 0x40 */ {SvcWrap_CreateSession64From32, 4, 3},
+    /* 0x41 */ {SvcWrap_AcceptSession64From32, 2, 2},
+    /* 0x42 */ {SvcWrap_ReplyAndReceiveLight64From32, 8, 8},
+    /* 0x43 */ {SvcWrap_ReplyAndReceive64From32, 5, 2},
+    /* 0x44 */ {SvcWrap_ReplyAndReceiveWithUserBuffer64From32, 7, 2},
+    /* 0x45 */ {SvcWrap_CreateEvent64From32, 0, 3},
+    /* 0x46 */ {SvcWrap_MapIoRegion64From32, 4, 1},
+    /* 0x47 */ {SvcWrap_UnmapIoRegion64From32, 3, 1},
+    /* 0x48 */ {SvcWrap_MapPhysicalMemoryUnsafe64From32, 2, 1},
+    /* 0x49 */ {SvcWrap_UnmapPhysicalMemoryUnsafe64From32, 2, 1},
+    /* 0x4a */ {SvcWrap_SetUnsafeLimit64From32, 1, 1},
+    /* 0x4b */ {SvcWrap_CreateCodeMemory64From32, 3, 2},
+    /* 0x4c */ {SvcWrap_ControlCodeMemory64From32, 7, 1},
+    /* 0x4d */ {SvcWrap_SleepSystem64From32, 0, 0},
+    /* 0x4e */ {SvcWrap_ReadWriteRegister64From32, 4, 2},
+    /* 0x4f */ {SvcWrap_SetProcessActivity64From32, 2, 1},
+    /* 0x50 */ {SvcWrap_CreateSharedMemory64From32, 4, 2},
+    /* 0x51 */ {SvcWrap_MapTransferMemory64From32, 4, 1},
+    /* 0x52 */ {SvcWrap_UnmapTransferMemory64From32, 3, 1},
+    /* 0x53 */ {SvcWrap_CreateInterruptEvent64From32, 3, 2},
+    /* 0x54 */ {SvcWrap_QueryPhysicalAddress64From32, 2, 5},
+    /* 0x55 */ {SvcWrap_QueryIoMapping64From32, 4, 3},
+    /* 0x56 */ {SvcWrap_CreateDeviceAddressSpace64From32, 4, 2},
+    /* 0x57 */ {SvcWrap_AttachDeviceAddressSpace64From32, 2, 1},
+    /* 0x58 */ {SvcWrap_DetachDeviceAddressSpace64From32, 2, 1},
+    /* 0x59 */ {SvcWrap_MapDeviceAddressSpaceByForce64From32, 8, 1},
+    /* 0x5a */ {SvcWrap_MapDeviceAddressSpaceAligned64From32, 8, 1},
+    /* 0x5b */ {},
+    /* 0x5c */ {SvcWrap_UnmapDeviceAddressSpace64From32, 7, 1},
+    /* 0x5d */ {SvcWrap_InvalidateProcessDataCache64From32, 5, 1},
+    /* 0x5e */ {SvcWrap_StoreProcessDataCache64From32, 5, 1},
+    /* 0x5f */ {SvcWrap_FlushProcessDataCache64From32, 5, 1},
+    /* 0x60 */ {SvcWrap_DebugActiveProcess64From32, 4, 2},
+    /* 0x61 */ {SvcWrap_BreakDebugProcess64From32, 1, 1},
+    /* 0x62 */ {SvcWrap_TerminateDebugProcess64From32, 1, 1},
+    /* 0x63 */ {SvcWrap_GetDebugEvent64From32, 2, 1},
+    /* 0x64 */ {SvcWrap_ContinueDebugEvent64From32, 4, 1},
+    /* 0x65 */ {SvcWrap_GetProcessList64From32, 3, 2},
+    /* 0x66 */ {SvcWrap_GetThreadList64From32, 4, 2},
+    /* 0x67 */ {SvcWrap_GetDebugThreadContext64From32, 5, 1},
+    /* 0x68 */ {SvcWrap_SetDebugThreadContext64From32, 5, 1},
+    /* 0x69 */ {SvcWrap_QueryDebugProcessMemory64From32, 4, 2},
+    /* 0x6a */ {SvcWrap_ReadDebugProcessMemory64From32, 4, 1},
+    /* 0x6b */ {SvcWrap_WriteDebugProcessMemory64From32, 4, 1},
+    /* 0x6c */ {SvcWrap_SetHardwareBreakPoint64From32, 5, 1},
+    /* 0x6d */ {SvcWrap_GetDebugThreadParam64From32, 4, 4},
+    /* 0x6e */ {},
+    /* 0x6f */ {SvcWrap_GetSystemInfo64From32, 4, 3},
+    /* 0x70 */ {SvcWrap_CreatePort64From32, 4, 3},
+    /* 0x71 */ {SvcWrap_ManageNamedPort64From32, 3, 2},
+    /* 0x72 */ {SvcWrap_ConnectToPort64From32, 2, 2},
+    /* 0x73 */ {SvcWrap_SetProcessMemoryPermission64From32, 6, 1},
+    /* 0x74 */ {SvcWrap_MapProcessMemory64From32, 5, 1},
+    /* 0x75 */ {SvcWrap_UnmapProcessMemory64From32, 5, 1},
+    /* 0x76 */ {SvcWrap_QueryProcessMemory64From32, 4, 2},
+    /* 0x77 */ {SvcWrap_MapProcessCodeMemory64From32, 7, 1},
+    /* 0x78 */ {SvcWrap_UnmapProcessCodeMemory64From32, 7, 1},
+    /* 0x79 */ {SvcWrap_CreateProcess64From32, 4, 2},
+    /* 0x7a */ {SvcWrap_StartProcess64From32, 5, 1},
+    /* 0x7b */ {SvcWrap_TerminateProcess64From32, 1, 1},
+    /* 0x7c */ {SvcWrap_GetProcessInfo64From32, 3, 3},
+    /* 0x7d */ {SvcWrap_CreateResourceLimit64From32, 0, 2},
+    /* 0x7e */ {SvcWrap_SetResourceLimitLimitValue64From32, 4, 1},
+    /* 0x7f */ {SvcWrap_CallSecureMonitor64From32, 8, 8},
+}};
+
+static constexpr std::array<SvcTableEntry, 0x80> SvcTable64{{
+    /* 0x00 */ {},
+    /* 0x01 */ {SvcWrap_SetHeapSize64, 2, 2},
+    /* 0x02 */ {SvcWrap_SetMemoryPermission64, 3, 1},
+    /* 0x03 */ {SvcWrap_SetMemoryAttribute64, 4, 1},
+    /* 0x04 */ {SvcWrap_MapMemory64, 3, 1},
+    /* 0x05 */ {SvcWrap_UnmapMemory64, 3, 1},
+    /* 0x06 */ {SvcWrap_QueryMemory64, 3, 2},
+    /* 0x07 */ {SvcWrap_ExitProcess64, 0, 0},
+    /* 0x08 */ {SvcWrap_CreateThread64, 6, 2},
+    /* 0x09 */ {SvcWrap_StartThread64, 1, 1},
+    /* 0x0a */ {SvcWrap_ExitThread64, 0, 0},
+    /* 0x0b */ {SvcWrap_SleepThread64, 1, 0},
+    /* 0x0c */ {SvcWrap_GetThreadPriority64, 2, 2},
+    /* 0x0d */ {SvcWrap_SetThreadPriority64, 2, 1},
+    /* 0x0e */ {SvcWrap_GetThreadCoreMask64, 3, 3},
+    /* 0x0f */ {SvcWrap_SetThreadCoreMask64, 3, 1},
+    /* 0x10 */ {SvcWrap_GetCurrentProcessorNumber64, 0, 1},
+    /* 0x11 */ {SvcWrap_SignalEvent64, 1, 1},
+    /* 0x12 */ {SvcWrap_ClearEvent64, 1, 1},
+    /* 0x13 */ {SvcWrap_MapSharedMemory64, 4, 1},
+    /* 0x14 */ {SvcWrap_UnmapSharedMemory64, 3, 1},
+    /* 0x15 */ {SvcWrap_CreateTransferMemory64, 4, 2},
+    /* 0x16 */ {SvcWrap_CloseHandle64, 1, 1},
+    /* 0x17 */ {SvcWrap_ResetSignal64, 1, 1},
+    /* 0x18 */ {SvcWrap_WaitSynchronization64, 4, 2},
+    /* 0x19 */ {SvcWrap_CancelSynchronization64, 1, 1},
+    /* 0x1a */ {SvcWrap_ArbitrateLock64, 3, 1},
+    /* 0x1b */ {SvcWrap_ArbitrateUnlock64, 1, 1},
+    /* 0x1c */ {SvcWrap_WaitProcessWideKeyAtomic64, 4, 1},
+    /* 0x1d */ {SvcWrap_SignalProcessWideKey64, 2, 0},
+    /* 0x1e */ {SvcWrap_GetSystemTick64, 0, 1},
+    /* 0x1f */ {SvcWrap_ConnectToNamedPort64, 2, 2},
+    /* 0x20 */ {SvcWrap_SendSyncRequestLight64, 8, 8},
+    /* 0x21 */ {SvcWrap_SendSyncRequest64, 1, 1},
+    /* 0x22 */ {SvcWrap_SendSyncRequestWithUserBuffer64, 3, 1},
+    /* 0x23 */ {SvcWrap_SendAsyncRequestWithUserBuffer64, 4, 2},
+    /* 0x24 */ {SvcWrap_GetProcessId64, 2, 2},
+    /* 0x25 */ {SvcWrap_GetThreadId64, 2, 2},
+    /* 0x26 */ {SvcWrap_Break64, 3, 0},
+    /* 0x27 */ {SvcWrap_OutputDebugString64, 2, 1},
+    /* 0x28 */ {SvcWrap_ReturnFromException64, 1, 0},
+    /* 0x29 */ {SvcWrap_GetInfo64, 4, 2},
+    /* 0x2a */ {SvcWrap_FlushEntireDataCache64, 0, 0},
+    /* 0x2b */ {SvcWrap_FlushDataCache64, 2, 1},
+    /* 0x2c */ {SvcWrap_MapPhysicalMemory64, 2, 1},
+    /* 0x2d */ {SvcWrap_UnmapPhysicalMemory64, 2, 1},
+    /* 0x2e */ {SvcWrap_GetDebugFutureThreadInfo64, 4, 6},
+    /* 0x2f */ {SvcWrap_GetLastThreadInfo64, 0, 7},
+    /* 0x30 */ {SvcWrap_GetResourceLimitLimitValue64, 3, 2},
+    /* 0x31 */ {SvcWrap_GetResourceLimitCurrentValue64, 3, 2},
+    /* 0x32 */ {SvcWrap_SetThreadActivity64, 2, 1},
+    /* 0x33 */ {SvcWrap_GetThreadContext364, 2, 1},
+    /* 0x34 */ {SvcWrap_WaitForAddress64, 4, 1},
+    /* 0x35 */ {SvcWrap_SignalToAddress64, 4, 1},
+    /* 0x36 */ {SvcWrap_SynchronizePreemptionState64, 0, 0},
+    /* 0x37 */ {SvcWrap_GetResourceLimitPeakValue64, 3, 2},
+    /* 0x38 */ {},
+    /* 0x39 */ {SvcWrap_CreateIoPool64, 2, 2},
+    /* 0x3a */ {SvcWrap_CreateIoRegion64, 6, 2},
+    /* 0x3b */ {},
+    /* 0x3c */ {SvcWrap_KernelDebug64, 4, 0},
+    /* 0x3d */ {SvcWrap_ChangeKernelTraceState64, 1, 0},
+    /* 0x3e */ {},
+    /* 0x3f */ {},
+    /* 0x40 */ {SvcWrap_CreateSession64, 4, 3},
+    /* 0x41 */ {SvcWrap_AcceptSession64, 2, 2},
+    /* 0x42 */ {SvcWrap_ReplyAndReceiveLight64, 8, 8},
+    /* 0x43 */ {SvcWrap_ReplyAndReceive64, 5, 2},
+    /* 0x44 */ {SvcWrap_ReplyAndReceiveWithUserBuffer64, 7, 2},
+    /* 0x45 */ {SvcWrap_CreateEvent64, 0, 3},
+    /* 0x46 */ {SvcWrap_MapIoRegion64, 4, 1},
+    /* 0x47 */ {SvcWrap_UnmapIoRegion64, 3, 1},
+    /* 0x48 */ {SvcWrap_MapPhysicalMemoryUnsafe64, 2, 1},
+    /* 0x49 */ {SvcWrap_UnmapPhysicalMemoryUnsafe64, 2, 1},
+    /* 0x4a */ {SvcWrap_SetUnsafeLimit64, 1, 1},
+    /* 0x4b */ {SvcWrap_CreateCodeMemory64, 3, 2},
+    /* 0x4c */ {SvcWrap_ControlCodeMemory64, 5, 1},
+    /* 0x4d */ {SvcWrap_SleepSystem64, 0, 0},
+    /* 0x4e */ {SvcWrap_ReadWriteRegister64, 4, 2},
+    /* 0x4f */ {SvcWrap_SetProcessActivity64, 2, 1},
+    /* 0x50 */ {SvcWrap_CreateSharedMemory64, 4, 2},
+    /* 0x51 */ {SvcWrap_MapTransferMemory64, 4, 1},
+    /* 0x52 */ {SvcWrap_UnmapTransferMemory64, 3, 1},
+    /* 0x53 */ {SvcWrap_CreateInterruptEvent64, 3, 2},
+    /* 0x54 */ {SvcWrap_QueryPhysicalAddress64, 2, 4},
+    /* 0x55 */ {SvcWrap_QueryIoMapping64, 4, 3},
+    /* 0x56 */ {SvcWrap_CreateDeviceAddressSpace64, 3, 2},
+    /* 0x57 */ {SvcWrap_AttachDeviceAddressSpace64, 2, 1},
+    /* 0x58 */ {SvcWrap_DetachDeviceAddressSpace64, 2, 1},
+    /* 0x59 */ {SvcWrap_MapDeviceAddressSpaceByForce64, 6, 1},
+    /* 0x5a */ {SvcWrap_MapDeviceAddressSpaceAligned64, 6, 1},
+    /* 0x5b */ {},
+    /* 0x5c */ {SvcWrap_UnmapDeviceAddressSpace64, 5, 1},
+    /* 0x5d */ {SvcWrap_InvalidateProcessDataCache64, 3, 1},
+    /* 0x5e */ {SvcWrap_StoreProcessDataCache64, 3, 1},
+    /* 0x5f */ {SvcWrap_FlushProcessDataCache64, 3, 1},
+    /* 0x60 */ {SvcWrap_DebugActiveProcess64, 2, 2},
+    /* 0x61 */ {SvcWrap_BreakDebugProcess64, 1, 1},
+    /* 0x62 */ {SvcWrap_TerminateDebugProcess64, 1, 1},
+    /* 0x63 */ {SvcWrap_GetDebugEvent64, 2, 1},
+    /* 0x64 */ {SvcWrap_ContinueDebugEvent64, 4, 1},
+    /* 0x65 */ {SvcWrap_GetProcessList64, 3, 2},
+    /* 0x66 */ {SvcWrap_GetThreadList64, 4, 2},
+    /* 0x67 */ {SvcWrap_GetDebugThreadContext64, 4, 1},
+    /* 0x68 */ {SvcWrap_SetDebugThreadContext64, 4, 1},
+    /* 0x69 */ {SvcWrap_QueryDebugProcessMemory64, 4, 2},
+    /* 0x6a */ {SvcWrap_ReadDebugProcessMemory64, 4, 1},
+    /* 0x6b */ {SvcWrap_WriteDebugProcessMemory64, 4, 1},
+    /* 0x6c */ {SvcWrap_SetHardwareBreakPoint64, 3, 1},
+    /* 0x6d */ {SvcWrap_GetDebugThreadParam64, 5, 3},
+    /* 0x6e */ {},
+    /* 0x6f */ {SvcWrap_GetSystemInfo64, 4, 2},
+    /* 0x70 */ {SvcWrap_CreatePort64, 5, 3},
+    /* 0x71 */ {SvcWrap_ManageNamedPort64, 3, 2},
+    /* 0x72 */ {SvcWrap_ConnectToPort64, 2, 2},
+    /* 0x73 */ {SvcWrap_SetProcessMemoryPermission64, 4, 1},
+    /* 0x74 */ {SvcWrap_MapProcessMemory64, 4, 1},
+    /* 0x75 */ {SvcWrap_UnmapProcessMemory64, 4, 1},
+    /* 0x76 */ {SvcWrap_QueryProcessMemory64, 4, 2},
+    /* 0x77 */ {SvcWrap_MapProcessCodeMemory64, 4, 1},
+    /* 0x78 */ {SvcWrap_UnmapProcessCodeMemory64, 4, 1},
+    /* 0x79 */ {SvcWrap_CreateProcess64, 4, 2},
+    /* 0x7a */ {SvcWrap_StartProcess64, 4, 1},
+    /* 0x7b */ {SvcWrap_TerminateProcess64, 1, 1},
+    /* 0x7c */ {SvcWrap_GetProcessInfo64, 3, 2},
+    /* 0x7d */ {SvcWrap_CreateResourceLimit64, 0, 2},
+    /* 0x7e */ {SvcWrap_SetResourceLimitLimitValue64, 3, 1},
+    /* 0x7f */ {SvcWrap_CallSecureMonitor64, 8, 8},
+}};
+
+static constexpr std::array<std::string_view, 0x80> SvcNames{{
+    /* 0x00 */ "",
+    /* 0x01 */ "SetHeapSize",
+    /* 0x02 */ "SetMemoryPermission",
+    /* 0x03 */ "SetMemoryAttribute",
+    /* 0x04 */ "MapMemory",
+    /* 0x05 */ "UnmapMemory",
+    /* 0x06 */ "QueryMemory",
+    /* 0x07 */ "ExitProcess",
+    /* 0x08 */ "CreateThread",
+    /* 0x09 */ "StartThread",
+    /* 0x0a */ "ExitThread",
+    /* 0x0b */ "SleepThread",
+    /* 0x0c */ "GetThreadPriority",
+    /* 0x0d */ "SetThreadPriority",
+    /* 0x0e */ "GetThreadCoreMask",
+    /* 0x0f */ "SetThreadCoreMask",
+    /* 0x10 */ "GetCurrentProcessorNumber",
+    /* 0x11 */ "SignalEvent",
+    /* 0x12 */ "ClearEvent",
+    /* 0x13 */ "MapSharedMemory",
+    /* 0x14 */ "UnmapSharedMemory",
+    /* 0x15 */ "CreateTransferMemory",
+    /* 0x16 */ "CloseHandle",
+    /* 0x17 */ "ResetSignal",
+    /* 0x18 */ "WaitSynchronization",
+    /* 0x19 */ "CancelSynchronization",
+    /* 0x1a */ "ArbitrateLock",
+    /* 0x1b */ "ArbitrateUnlock",
+    /* 0x1c */ "WaitProcessWideKeyAtomic",
+    /* 0x1d */ "SignalProcessWideKey",
+    /* 0x1e */ "GetSystemTick",
+    /* 0x1f */ "ConnectToNamedPort",
+    /* 0x20 */ "SendSyncRequestLight",
+    /* 0x21 */ "SendSyncRequest",
+    /* 0x22 */ "SendSyncRequestWithUserBuffer",
+    /* 0x23 */ "SendAsyncRequestWithUserBuffer",
+    /* 0x24 */ "GetProcessId",
+    /* 0x25 */ "GetThreadId",
+    /* 0x26 */ "Break",
+    /* 0x27 */ "OutputDebugString",
+    /* 0x28 */ "ReturnFromException",
+    /* 0x29 */ "GetInfo",
+    /* 0x2a */ "FlushEntireDataCache",
+    /* 0x2b */ "FlushDataCache",
+    /* 0x2c */ "MapPhysicalMemory",
+    /* 0x2d */ "UnmapPhysicalMemory",
+    /* 0x2e */ "GetDebugFutureThreadInfo",
+    /* 0x2f */ "GetLastThreadInfo",
+    /* 0x30 */ "GetResourceLimitLimitValue",
+    /* 0x31 */ "GetResourceLimitCurrentValue",
+    /* 0x32 */ "SetThreadActivity",
+    /* 0x33 */ "GetThreadContext3",
+    /* 0x34 */ "WaitForAddress",
+    /* 0x35 */ "SignalToAddress",
+    /* 0x36 */ "SynchronizePreemptionState",
+    /* 0x37 */ "GetResourceLimitPeakValue",
+    /* 0x38 */ "",
+    /* 0x39 */ "CreateIoPool",
+    /* 0x3a */ "CreateIoRegion",
+    /* 0x3b */ "",
+    /* 0x3c */ "KernelDebug",
+    /* 0x3d */ "ChangeKernelTraceState",
+    /* 0x3e */ "",
+    /* 0x3f */ "",
+    /* 0x40 */ "CreateSession",
+    /* 0x41 */ "AcceptSession",
+    /* 0x42 */ "ReplyAndReceiveLight",
+    /* 0x43 */ "ReplyAndReceive",
+    /* 0x44 */ "ReplyAndReceiveWithUserBuffer",
+    /* 0x45 */ "CreateEvent",
+    /* 0x46 */ "MapIoRegion",
+    /* 0x47 */ "UnmapIoRegion",
+    /* 0x48 */ "MapPhysicalMemoryUnsafe",
+    /* 0x49 */ "UnmapPhysicalMemoryUnsafe",
+    /* 0x4a */ "SetUnsafeLimit",
+    /* 0x4b */ "CreateCodeMemory",
+    /* 0x4c */ "ControlCodeMemory",
+    /* 0x4d */ "SleepSystem",
+    /* 0x4e */ "ReadWriteRegister",
+    /* 0x4f */ "SetProcessActivity",
+    /* 0x50 */ "CreateSharedMemory",
+    /* 0x51 */ "MapTransferMemory",
+    /* 0x52 */ "UnmapTransferMemory",
+    /* 0x53 */ "CreateInterruptEvent",
+    /* 0x54 */ "QueryPhysicalAddress",
+    /* 0x55 */ "QueryIoMapping",
+    /* 0x56 */ "CreateDeviceAddressSpace",
+    /* 0x57 */ "AttachDeviceAddressSpace",
+    /* 0x58 */ "DetachDeviceAddressSpace",
+    /* 0x59 */ "MapDeviceAddressSpaceByForce",
+    /* 0x5a */ "MapDeviceAddressSpaceAligned",
+    /* 0x5b */ "",
+    /* 0x5c */ "UnmapDeviceAddressSpace",
+    /* 0x5d */ "InvalidateProcessDataCache",
+    /* 0x5e */ "StoreProcessDataCache",
+    /* 0x5f */ "FlushProcessDataCache",
+    /* 0x60 */ "DebugActiveProcess",
+    /* 0x61 */ "BreakDebugProcess",
+    /* 0x62 */ "TerminateDebugProcess",
+    /* 0x63 */ "GetDebugEvent",
+    /* 0x64 */ "ContinueDebugEvent",
+    /* 0x65 */ "GetProcessList",
+    /* 0x66 */ "GetThreadList",
+    /* 0x67 */ "GetDebugThreadContext",
+    /* 0x68 */ "SetDebugThreadContext",
+    /* 0x69 */ "QueryDebugProcessMemory",
+    /* 0x6a */ "ReadDebugProcessMemory",
+    /* 0x6b */ "WriteDebugProcessMemory",
+    /* 0x6c */ "SetHardwareBreakPoint",
+    /* 0x6d */ "GetDebugThreadParam",
+    /* 0x6e */ "",
+    /* 0x6f */ "GetSystemInfo",
+    /* 0x70 */ "CreatePort",
+    /* 0x71 */ "ManageNamedPort",
+    /* 0x72 */ "ConnectToPort",
+    /* 0x73 */ "SetProcessMemoryPermission",
+    /* 0x74 */ "MapProcessMemory",
+    /* 0x75 */ "UnmapProcessMemory",
+    /* 0x76 */ "QueryProcessMemory",
+    /* 0x77 */ "MapProcessCodeMemory",
+    /* 0x78 */ "UnmapProcessCodeMemory",
+    /* 0x79 */ "CreateProcess",
+    /* 0x7a */ "StartProcess",
+    /* 0x7b */ "TerminateProcess",
+    /* 0x7c */ "GetProcessInfo",
+    /* 0x7d */ "CreateResourceLimit",
+    /* 0x7e */ "SetResourceLimitLimitValue",
+    /* 0x7f */ "CallSecureMonitor",
+}};
 // clang-format on
 
 void Call(Core::System& system, u32 imm) {
     auto& kernel = system.Kernel();
     auto& process = GetCurrentProcess(kernel);
 
-    std::array<uint64_t, 8> args;
-    kernel.CurrentPhysicalCore().SaveSvcArguments(process, args);
-    kernel.EnterSVCProfile();
-
-    if (process.Is64Bit()) {
-        Call64(system, imm, args);
-    } else {
-        Call32(system, imm, args);
+    const auto& table = process.Is64Bit() ? SvcTable64 : SvcTable64From32;
+    if (imm >= table.size() || table[imm].wrapper == nullptr) {
+        LOG_CRITICAL(Kernel_SVC, "Unknown SVC {:x}!", imm);
+        return;
     }
+    const SvcTableEntry& entry = table[imm];
+
+    std::array<uint64_t, 8> args{};
+    kernel.CurrentPhysicalCore().SaveSvcArguments(process,
+                                                  std::span{args}.first(entry.num_inputs));
+    const u64 start_ns = kernel.EnterSVCProfile(imm);
+
+    entry.wrapper(system, args);
+
+    kernel.ExitSVCProfile(imm, start_ns);
+    kernel.CurrentPhysicalCore().LoadSvcArguments(process,
+                                                  std::span{args}.first(entry.num_outputs));
+}
 
-    kernel.ExitSVCProfile();
-    kernel.CurrentPhysicalCore().LoadSvcArguments(process, args);
+std::string_view GetSvcName(u32 imm) {
+    return imm < SvcNames.size() ? SvcNames[imm] : std::string_view{};
 }
 
 } // namespace Kernel::Svc
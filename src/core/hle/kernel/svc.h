@@ -10,6 +10,7 @@ class System;
 }
 
 #include <span>
+#include <string_view>
 
 #include "common/common_types.h"
 #include "core/hle/kernel/svc_types.h"
@@ -535,4 +536,7 @@ void SvcWrap_CallSecureMonitor64(Core::System& system, std::span<uint64_t, 8> ar
 // Perform a supervisor call by index.
 void Call(Core::System& system, u32 imm);
 
+// Gets the name of a supervisor call, empty if it is unknown.
+std::string_view GetSvcName(u32 imm);
+
 } // namespace Kernel::Svc
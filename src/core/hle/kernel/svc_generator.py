@@ -146,6 +146,9 @@ SKIP_WRAPPERS = {
 BIT_32 = 0
 BIT_64 = 1
 
+NUM_SVCS = 0x80
+NUM_ARGUMENT_REGISTERS = 8
+
 REG_SIZES = [4, 8]
 SUFFIX_NAMES = ["64From32", "64"]
 TYPE_SIZES = {
@@ -499,6 +502,7 @@ class System;
 }
 
 #include <span>
+#include <string_view>
 
 #include "common/common_types.h"
 #include "core/hle/kernel/svc_types.h"
@@ -539,10 +543,15 @@ void SvcWrap_CallSecureMonitor64(Core::System& system, std::span<uint64_t, 8> ar
 // Perform a supervisor call by index.
 void Call(Core::System& system, u32 imm);
 
+// Gets the name of a supervisor call, empty if it is unknown.
+std::string_view GetSvcName(u32 imm);
+
 } // namespace Kernel::Svc
 """
 
 PROLOGUE_CPP = """
+#include <array>
+#include <string_view>
 #include <type_traits>
 
 #include "core/arm/arm_interface.h"
@@ -568,6 +577,15 @@ static void SetArg64(std::span<uint64_t, 8> args, int n, uint64_t result) {
     args[n] = result;
 }
 
+using SvcWrapper = void (*)(Core::System& system, std::span<uint64_t, 8> args);
+
+// Dispatch table entry, only the argument registers an SVC uses are transferred.
+struct SvcTableEntry {
+    SvcWrapper wrapper;
+    u8 num_inputs;
+    u8 num_outputs;
+};
+
 // Like bit_cast, but handles the case when the source and dest
 // are differently-sized.
 template <typename To, typename From>
@@ -594,43 +612,72 @@ void Call(Core::System& system, u32 imm) {
     auto& kernel = system.Kernel();
     auto& process = GetCurrentProcess(kernel);
 
-    std::array<uint64_t, 8> args;
-    kernel.CurrentPhysicalCore().SaveSvcArguments(process, args);
-    kernel.EnterSVCProfile();
-
-    if (process.Is64Bit()) {
-        Call64(system, imm, args);
-    } else {
-        Call32(system, imm, args);
+    const auto& table = process.Is64Bit() ? SvcTable64 : SvcTable64From32;
+    if (imm >= table.size() || table[imm].wrapper == nullptr) {
+        LOG_CRITICAL(Kernel_SVC, "Unknown SVC {:x}!", imm);
+        return;
     }
+    const SvcTableEntry& entry = table[imm];
 
-    kernel.ExitSVCProfile();
-    kernel.CurrentPhysicalCore().LoadSvcArguments(process, args);
+    std::array<uint64_t, 8> args{};
+    kernel.CurrentPhysicalCore().SaveSvcArguments(process,
+                                                  std::span{args}.first(entry.num_inputs));
+    const u64 start_ns = kernel.EnterSVCProfile(imm);
+
+    entry.wrapper(system, args);
+
+    kernel.ExitSVCProfile(imm, start_ns);
+    kernel.CurrentPhysicalCore().LoadSvcArguments(process,
+                                                  std::span{args}.first(entry.num_outputs));
+}
+
+std::string_view GetSvcName(u32 imm) {
+    return imm < SvcNames.size() ? SvcNames[imm] : std::string_view{};
 }
 
 } // namespace Kernel::Svc
 """
 
 
-def emit_call(bitness, names, suffix):
-    bit_size = REG_SIZES[bitness]*8
+# Counts the argument registers up to the highest one in the lists.
+def count_registers(register_lists):
+    count = 0
+    for regs in register_lists:
+        for reg in regs:
+            count = max(count, reg + 1)
+    return count
+
+
+def emit_table(bitness, names, register_counts, suffix):
     indent = "    "
     lines = [
-        f"static void Call{bit_size}(Core::System& system, u32 imm, std::span<uint64_t, 8> args) {{",
-        f"{indent}switch (static_cast<SvcId>(imm)) {{"
+        f"static constexpr std::array<SvcTableEntry, {hex(NUM_SVCS)}> SvcTable{suffix}{{{{"
     ]
 
-    for _, name in names:
-        lines.append(f"{indent}case SvcId::{name}:")
-        lines.append(f"{indent*2}return SvcWrap_{name}{suffix}(system, args);")
+    wrappers = {imm: name for imm, name in names}
+    for imm in range(NUM_SVCS):
+        if imm not in wrappers:
+            lines.append(f"{indent}/* {imm:#04x} */ {{}},")
+            continue
+        num_inputs, num_outputs = register_counts[bitness][imm]
+        lines.append(
+            f"{indent}/* {imm:#04x} */ {{SvcWrap_{wrappers[imm]}{suffix}, {num_inputs}, {num_outputs}}},")
+
+    lines.append("}};")
+    return "\n".join(lines)
 
-    lines.append(f"{indent}default:")
-    lines.append(
-        f"{indent*2}LOG_CRITICAL(Kernel_SVC, \"Unknown SVC {{:x}}!\", imm);")
-    lines.append(f"{indent*2}break;")
-    lines.append(f"{indent}}}")
-    lines.append("}")
 
+def emit_names(names):
+    indent = "    "
+    lines = [
+        f"static constexpr std::array<std::string_view, {hex(NUM_SVCS)}> SvcNames{{{{"
+    ]
+
+    svc_names = {imm: name for imm, name in names}
+    for imm in range(NUM_SVCS):
+        lines.append(f"{indent}/* {imm:#04x} */ \"{svc_names.get(imm, '')}\",")
+
+    lines.append("}};")
     return "\n".join(lines)
 
 
@@ -661,6 +708,7 @@ def main():
     svc_fw_declarations = []
     wrapper_fns = []
     names = []
+    register_counts = [{}, {}]
 
     for imm, decl in SVCS:
         return_type, name, arguments = parse_declaration(decl, BIT_64)
@@ -677,19 +725,28 @@ def main():
 
         for imm, decl in SVCS:
             if imm in SKIP_WRAPPERS:
+                # Custom ABIs use every argument register.
+                register_counts[bitness][imm] = (
+                    NUM_ARGUMENT_REGISTERS, NUM_ARGUMENT_REGISTERS)
                 continue
 
             parse_result = parse_declaration(decl, bitness)
             return_type, name, arguments = parse_result
 
             register_info = get_registers(parse_result, bitness)
+            return_write, output_writes, input_reads = register_info
+            register_counts[bitness][imm] = (
+                count_registers([regs for _, _, regs in input_reads]),
+                count_registers([regs for _, regs in return_write] +
+                                [regs for _, _, regs, _ in output_writes]))
             wrapper_fns.append(
                 emit_wrapper(name, suffix, register_info, arguments, byte_size))
             arch_fw_declarations[bitness].append(
                 build_fn_declaration(return_type, name + suffix, arguments))
 
-    call_32 = emit_call(BIT_32, names, SUFFIX_NAMES[BIT_32])
-    call_64 = emit_call(BIT_64, names, SUFFIX_NAMES[BIT_64])
+    table_32 = emit_table(BIT_32, names, register_counts, SUFFIX_NAMES[BIT_32])
+    table_64 = emit_table(BIT_64, names, register_counts, SUFFIX_NAMES[BIT_64])
+    svc_names = emit_names(names)
     enum_decls = build_enum_declarations()
 
     with open("svc.h", "w") as f:
@@ -711,9 +768,11 @@ def main():
         f.write("\n\n")
         f.write("\n\n".join(wrapper_fns))
         f.write("\n\n")
-        f.write(call_32)
+        f.write(table_32)
+        f.write("\n\n")
+        f.write(table_64)
         f.write("\n\n")
-        f.write(call_64)
+        f.write(svc_names)
         f.write(EPILOGUE_CPP)
 
     print(f"Done (emitted {len(names)} definitions)")
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "core/hle/kernel/svc.h"
+#include "core/hle/kernel/svc_statistics.h"
+
+namespace Kernel {
+
+namespace {
+
+size_t BucketIndex(u64 duration_ns) {
+    const u64 scaled = duration_ns >> SvcStatistics::FirstBucketShift;
+    return std::min<size_t>(std::bit_width(scaled), SvcStatistics::NumBuckets - 1);
+}
+
+} // Anonymous namespace
+
+u64 SvcStatistics::Entry::PercentileNs(double percentile) const noexcept {
+    if (calls == 0) {
+        return 0;
+    }
+    const u64 target = std::max<u64>(
+        static_cast<u64>(std::ceil(static_cast<double>(calls) * percentile / 100.0)), 1);
+    u64 seen = 0;
+    for (size_t bucket = 0; bucket < NumBuckets; ++bucket) {
+        seen += histogram[bucket];
+        if (seen >= target) {
+            return u64{1} << (FirstBucketShift + bucket);
+        }
+    }
+    return u64{1} << (FirstBucketShift + NumBuckets - 1);
+}
+
+SvcStatistics::SvcStatistics() = default;
+
+SvcStatistics::~SvcStatistics() = default;
+
+void SvcStatistics::Record(size_t core, u32 svc_id, u64 duration_ns) noexcept {
+    if (core >= counters.size() || svc_id >= NumSvcs) {
+        return;
+    }
+    // Each core only updates its own counters, so relaxed increments never contend
+    Counter& counter = counters[core][svc_id];
+    counter.calls.fetch_add(1, std::memory_order_relaxed);
+    counter.total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+    counter.histogram[BucketIndex(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<SvcStatistics::Entry> SvcStatistics::Collect() const {
+    std::vector<Entry> entries;
+    for (u32 id = 0; id < NumSvcs; ++id) {
+        Entry entry{
+            .id = id,
+            .name = Svc::GetSvcName(id),
+            .calls = 0,
+            .total_ns = 0,
+            .histogram = {},
+        };
+        for (const CoreCounters& core_counters : counters) {
+            const Counter& counter = core_counters[id];
+            entry.calls += counter.calls.load(std::memory_order_relaxed);
+            entry.total_ns += counter.total_ns.load(std::memory_order_relaxed);
+            for (size_t bucket = 0; bucket < NumBuckets; ++bucket) {
+                entry.histogram[bucket] +=
+                    counter.histogram[bucket].load(std::memory_order_relaxed);
+            }
+        }
+        if (entry.calls != 0) {
+            entries.push_back(entry);
+        }
+    }
+    std::ranges::sort(entries, std::greater{}, &Entry::total_ns);
+    return entries;
+}
+
+void SvcStatistics::Reset() noexcept {
+    for (CoreCounters& core_counters : counters) {
+        for (Counter& counter : core_counters) {
+            counter.calls.store(0, std::memory_order_relaxed);
+            counter.total_ns.store(0, std::memory_order_relaxed);
+            for (auto& bucket : counter.histogram) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+} // namespace Kernel
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string_view>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/hardware_properties.h"
+
+namespace Kernel {
+
+/**
+ * Opt-in counters of the host time spent in each SVC.
+ *
+ * Counters are kept per emulated core, so recording a call never contends with other cores. Each
+ * SVC keeps a call count, the total time and a log2 histogram of the call durations, from which
+ * approximate percentiles are derived when collecting.
+ */
+class SvcStatistics {
+public:
+    static constexpr size_t NumSvcs = 0x80;
+    static constexpr size_t NumBuckets = 16;
+
+    /// Durations below 2^FirstBucketShift ns land in the first bucket
+    static constexpr u32 FirstBucketShift = 9;
+
+    struct Entry {
+        u32 id;
+        std::string_view name;
+        u64 calls;
+        u64 total_ns;
+        std::array<u64, NumBuckets> histogram;
+
+        [[nodiscard]] u64 MeanNs() const noexcept {
+            return calls != 0 ? total_ns / calls : 0;
+        }
+
+        /// Returns the upper bound of the histogram bucket holding the given percentile
+        [[nodiscard]] u64 PercentileNs(double percentile) const noexcept;
+    };
+
+    SvcStatistics();
+    ~SvcStatistics();
+
+    SUYU_NON_COPYABLE(SvcStatistics);
+    SUYU_NON_MOVEABLE(SvcStatistics);
+
+    void SetEnabled(bool enabled) noexcept {
+        is_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool IsEnabled() const noexcept {
+        return is_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Records a call of an SVC that took the given host time on a core
+    void Record(size_t core, u32 svc_id, u64 duration_ns) noexcept;
+
+    /// Returns the counters of every SVC called at least once, most expensive first
+    [[nodiscard]] std::vector<Entry> Collect() const;
+
+    /// Clears all counters
+    void Reset() noexcept;
+
+private:
+    struct Counter {
+        std::atomic<u64> calls;
+        std::atomic<u64> total_ns;
+        std::array<std::atomic<u64>, NumBuckets> histogram;
+    };
+
+    using CoreCounters = std::array<Counter, NumSvcs>;
+
+    std::atomic_bool is_enabled{false};
+    std::array<CoreCounters, Core::Hardware::NUM_CPU_CORES> counters{};
+};
+
+} // namespace Kernel
@@ -1,11 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <limits>
 #include <sstream>
 
 #include "common/fs/file.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "common/stb.h"
 #include "core/core.h"
 #include "core/hle/service/caps/caps_manager.h"
@@ -17,9 +19,83 @@
 
 namespace Service::Capture {
 
-AlbumManager::AlbumManager(Core::System& system_) : system{system_} {}
+namespace {
 
-AlbumManager::~AlbumManager() = default;
+// Unique ids are written as a non-negative file name suffix
+constexpr s8 MaxUniqueId = std::numeric_limits<s8>::max();
+
+constexpr int ScreenShotWidth = 1280;
+constexpr int ScreenShotHeight = 720;
+
+struct EncodeOptions {
+    bool use_jpeg;
+    int png_compression_level;
+    int jpeg_quality;
+    bool flip_vertically;
+};
+
+struct EncodeContext {
+    Common::FS::IOFile& file;
+    u64 written_size;
+    bool is_failed;
+};
+
+void WriteEncodedData(void* context, void* data, int size) {
+    auto* encode_context = static_cast<EncodeContext*>(context);
+    const std::span<const u8> chunk{static_cast<const u8*>(data), static_cast<size_t>(size)};
+    if (encode_context->file.WriteSpan(chunk) != chunk.size()) {
+        encode_context->is_failed = true;
+    }
+    encode_context->written_size += chunk.size();
+}
+
+// Streams the encoded image straight to path, returns the file size or zero on failure
+u64 EncodeImage(const std::filesystem::path& path, std::span<const u8> image,
+                const EncodeOptions& options) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Service_Capture, "Failed to create {}", Common::FS::PathToUTF8String(path));
+        return 0;
+    }
+
+    EncodeContext context{
+        .file = file,
+        .written_size = 0,
+        .is_failed = false,
+    };
+
+    // The stb writer options are global, they are only ever changed from the encode worker
+    stbi_flip_vertically_on_write(options.flip_vertically);
+    int is_encoded{};
+    if (options.use_jpeg) {
+        is_encoded = stbi_write_jpg_to_func(WriteEncodedData, &context, ScreenShotWidth,
+                                            ScreenShotHeight, STBI_rgb_alpha, image.data(),
+                                            options.jpeg_quality);
+    } else {
+        stbi_write_png_compression_level = options.png_compression_level;
+        is_encoded = stbi_write_png_to_func(WriteEncodedData, &context, ScreenShotWidth,
+                                            ScreenShotHeight, STBI_rgb_alpha, image.data(), 0);
+    }
+
+    if (!is_encoded || context.is_failed) {
+        LOG_ERROR(Service_Capture, "Failed to save {}", Common::FS::PathToUTF8String(path));
+        file.Close();
+        Common::FS::RemoveFile(path);
+        return 0;
+    }
+    return context.written_size;
+}
+
+} // Anonymous namespace
+
+AlbumManager::AlbumManager(Core::System& system_)
+    : system{system_}, encode_worker{1, "AlbumEncoder"} {}
+
+AlbumManager::~AlbumManager() {
+    // Pending captures must still reach the disk
+    encode_worker.WaitForRequests();
+}
 
 Result AlbumManager::DeleteAlbumFile(const AlbumFileId& file_id) {
     if (file_id.storage > AlbumStorage::Sd) {
@@ -41,6 +117,8 @@ Result AlbumManager::DeleteAlbumFile(const AlbumFileId& file_id) {
         return ResultFileNotFound;
     }
 
+    std::scoped_lock lk{album_mutex};
+    album_files.erase(file_id);
     return ResultSuccess;
 }
 
@@ -68,7 +146,8 @@ Result AlbumManager::GetAlbumFileList(std::span<AlbumEntry> out_entries, u64& ou
         return ResultIsNotMounted;
     }
 
-    for (auto& [file_id, path] : album_files) {
+    std::scoped_lock lk{album_mutex};
+    for (const auto& [file_id, file] : album_files) {
         if (file_id.storage != storage) {
             continue;
         }
@@ -79,9 +158,8 @@ Result AlbumManager::GetAlbumFileList(std::span<AlbumEntry> out_entries, u64& ou
             break;
         }
 
-        const auto entry_size = Common::FS::GetSize(path);
         out_entries[out_entries_count++] = {
-            .entry_size = entry_size,
+            .entry_size = file.size,
             .file_id = file_id,
         };
     }
@@ -125,7 +203,8 @@ Result AlbumManager::GetAlbumFileList(std::span<ApplicationAlbumEntry> out_entri
         return ResultIsNotMounted;
     }
 
-    for (auto& [file_id, path] : album_files) {
+    std::scoped_lock lk{album_mutex};
+    for (const auto& [file_id, file] : album_files) {
         if (file_id.type != content_type) {
             continue;
         }
@@ -142,9 +221,8 @@ Result AlbumManager::GetAlbumFileList(std::span<ApplicationAlbumEntry> out_entri
             break;
         }
 
-        const auto entry_size = Common::FS::GetSize(path);
         out_entries[out_entries_count++] = {
-            .size = entry_size,
+            .size = file.size,
             .hash{},
             .datetime = file_id.date,
             .storage = file_id.storage,
@@ -288,21 +366,31 @@ Result AlbumManager::SaveEditedScreenShot(ApplicationAlbumEntry& out_entry,
 }
 
 Result AlbumManager::GetFile(std::filesystem::path& out_path, const AlbumFileId& file_id) const {
+    // Captures that are still being encoded can't be read or removed yet
+    encode_worker.WaitForRequests();
+
+    std::scoped_lock lk{album_mutex};
     const auto file = album_files.find(file_id);
 
     if (file == album_files.end()) {
         return ResultFileNotFound;
     }
 
-    out_path = file->second;
+    out_path = file->second.path;
     return ResultSuccess;
 }
 
 void AlbumManager::FindScreenshots() {
+    // The index is kept up to date by every save and delete, the directory is only scanned once
+    if (is_index_built) {
+        return;
+    }
+
     is_mounted = false;
+
+    std::scoped_lock lk{album_mutex};
     album_files.clear();
 
-    // TODO: Swap this with a blocking operation.
     const auto screenshots_dir = Common::FS::GetSuyuPath(Common::FS::SuyuPath::ScreenshotsDir);
     Common::FS::IterateDirEntries(
         screenshots_dir,
@@ -311,16 +399,19 @@ void AlbumManager::FindScreenshots() {
             if (GetAlbumEntry(entry, full_path).IsError()) {
                 return true;
             }
-            while (album_files.contains(entry.file_id)) {
-                if (++entry.file_id.date.unique_id == 0) {
-                    break;
-                }
+            while (album_files.contains(entry.file_id) &&
+                   entry.file_id.date.unique_id != MaxUniqueId) {
+                ++entry.file_id.date.unique_id;
             }
-            album_files[entry.file_id] = full_path;
+            album_files[entry.file_id] = {
+                .path = full_path,
+                .size = Common::FS::GetSize(full_path),
+            };
             return true;
         },
         Common::FS::DirEntryFilter::File);
 
+    is_index_built = true;
     is_mounted = true;
 }
 
@@ -343,6 +434,7 @@ Result AlbumManager::GetAlbumEntry(AlbumEntry& out_entry, const std::filesystem:
     std::string hour;
     std::string minute;
     std::string second;
+    std::string unique_id;
 
     std::getline(date_stream, year, '-');
     std::getline(date_stream, month, '-');
@@ -351,8 +443,14 @@ Result AlbumManager::GetAlbumEntry(AlbumEntry& out_entry, const std::filesystem:
     std::getline(time_stream, hour, '-');
     std::getline(time_stream, minute, '-');
     std::getline(time_stream, second, '-');
+    // Captures taken within the same second carry a unique id suffix, older ones don't
+    std::getline(time_stream, unique_id, '-');
 
     try {
+        const int parsed_unique_id = unique_id.empty() ? 0 : std::stoi(unique_id);
+        if (parsed_unique_id < 0 || parsed_unique_id > MaxUniqueId) {
+            return ResultUnknown;
+        }
         out_entry = {
             .entry_size = 1,
             .file_id{
@@ -365,7 +463,7 @@ Result AlbumManager::GetAlbumEntry(AlbumEntry& out_entry, const std::filesystem:
                         .hour = static_cast<s8>(std::stoi(hour)),
                         .minute = static_cast<s8>(std::stoi(minute)),
                         .second = static_cast<s8>(std::stoi(second)),
-                        .unique_id = 0,
+                        .unique_id = static_cast<s8>(parsed_unique_id),
                     },
                 .storage = AlbumStorage::Sd,
                 .type = ContentType::Screenshot,
@@ -426,42 +524,77 @@ Result AlbumManager::LoadImage(std::span<u8> out_image, const std::filesystem::p
 }
 
 void AlbumManager::FlipVerticallyOnWrite(bool flip) {
-    stbi_flip_vertically_on_write(flip);
-}
-
-static void PNGToMemory(void* context, void* data, int len) {
-    std::vector<u8>* png_image = static_cast<std::vector<u8>*>(context);
-    unsigned char* png = static_cast<unsigned char*>(data);
-    png_image->insert(png_image->end(), png, png + len);
+    flip_vertically = flip;
 }
 
 Result AlbumManager::SaveImage(ApplicationAlbumEntry& out_entry, std::span<const u8> image,
-                               u64 title_id, const AlbumFileDateTime& date) const {
-    const auto screenshot_path =
-        Common::FS::GetSuyuPathString(Common::FS::SuyuPath::ScreenshotsDir);
-    const std::string formatted_date =
-        fmt::format("{:04}-{:02}-{:02}_{:02}-{:02}-{:02}-{:03}", date.year, date.month, date.day,
-                    date.hour, date.minute, date.second, 0);
-    const std::string file_path =
-        fmt::format("{}/{:016x}_{}.png", screenshot_path, title_id, formatted_date);
-
-    const Common::FS::IOFile db_file{file_path, Common::FS::FileAccessMode::Write,
-                                     Common::FS::FileType::BinaryFile};
-
-    std::vector<u8> png_image;
-    if (!stbi_write_png_to_func(PNGToMemory, &png_image, 1280, 720, STBI_rgb_alpha, image.data(),
-                                0)) {
-        return ResultFileCountLimit;
+                               u64 title_id, const AlbumFileDateTime& date) {
+    if (image.size() < static_cast<std::size_t>(ScreenShotWidth * ScreenShotHeight *
+                                                STBI_rgb_alpha)) {
+        return ResultUnknown;
     }
 
-    if (db_file.Write(png_image) != png_image.size()) {
-        return ResultFileCountLimit;
+    const EncodeOptions options{
+        .use_jpeg = Settings::values.album_use_jpeg.GetValue(),
+        .png_compression_level = Settings::values.album_png_compression_level.GetValue(),
+        .jpeg_quality = Settings::values.album_jpeg_quality.GetValue(),
+        .flip_vertically = flip_vertically,
+    };
+
+    AlbumFileId file_id{
+        .application_id = title_id,
+        .date = date,
+        .storage = AlbumStorage::Sd,
+        .type = ContentType::Screenshot,
+        .unknown = 1,
+    };
+
+    std::filesystem::path file_path;
+    {
+        std::scoped_lock lk{album_mutex};
+        // Captures taken within the same second get their own id and file
+        while (album_files.contains(file_id)) {
+            if (file_id.date.unique_id == MaxUniqueId) {
+                return ResultFileCountLimit;
+            }
+            ++file_id.date.unique_id;
+        }
+
+        const auto screenshot_path =
+            Common::FS::GetSuyuPathString(Common::FS::SuyuPath::ScreenshotsDir);
+        const std::string formatted_date = fmt::format(
+            "{:04}-{:02}-{:02}_{:02}-{:02}-{:02}-{:03}", date.year, date.month, date.day,
+            date.hour, date.minute, date.second, file_id.date.unique_id);
+        file_path = fmt::format("{}/{:016x}_{}.{}", screenshot_path, title_id, formatted_date,
+                                options.use_jpeg ? "jpg" : "png");
+
+        album_files[file_id] = {
+            .path = file_path,
+            .size = image.size(),
+        };
     }
 
+    // The encoded size is only known once the worker is done, report the raw capture size
+    encode_worker.QueueWork([this, file_id, file_path, options,
+                             image_data = std::vector<u8>(image.begin(), image.end())] {
+        const u64 size = EncodeImage(file_path, image_data, options);
+
+        std::scoped_lock lk{album_mutex};
+        const auto file = album_files.find(file_id);
+        if (file == album_files.end() || file->second.path != file_path) {
+            return;
+        }
+        if (size == 0) {
+            album_files.erase(file);
+            return;
+        }
+        file->second.size = size;
+    });
+
     out_entry = {
-        .size = png_image.size(),
+        .size = image.size(),
         .hash = {},
-        .datetime = date,
+        .datetime = file_id.date,
         .storage = AlbumStorage::Sd,
         .content = ContentType::Screenshot,
         .unknown = 1,
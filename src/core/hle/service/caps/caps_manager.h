@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 
 #include "common/fs/fs.h"
+#include "common/thread_worker.h"
 #include "core/hle/result.h"
 #include "core/hle/service/caps/caps_types.h"
 
@@ -74,20 +76,34 @@ private:
     static constexpr std::size_t NandAlbumFileLimit = 1000;
     static constexpr std::size_t SdAlbumFileLimit = 10000;
 
+    struct AlbumFile {
+        std::filesystem::path path;
+        /// Size of the file, the raw capture size until it has been encoded
+        u64 size;
+    };
+
     void FindScreenshots();
     Result GetFile(std::filesystem::path& out_path, const AlbumFileId& file_id) const;
     Result GetAlbumEntry(AlbumEntry& out_entry, const std::filesystem::path& path) const;
     Result LoadImage(std::span<u8> out_image, const std::filesystem::path& path, int width,
                      int height, ScreenShotDecoderFlag flag) const;
     Result SaveImage(ApplicationAlbumEntry& out_entry, std::span<const u8> image, u64 title_id,
-                     const AlbumFileDateTime& date) const;
+                     const AlbumFileDateTime& date);
 
     AlbumFileDateTime ConvertToAlbumDateTime(u64 posix_time) const;
 
     bool is_mounted{};
-    std::unordered_map<AlbumFileId, std::filesystem::path> album_files;
+    bool is_index_built{};
+    bool flip_vertically{};
+
+    /// Album index, built once from the screenshots directory and updated on every change
+    mutable std::mutex album_mutex;
+    std::unordered_map<AlbumFileId, AlbumFile> album_files;
 
     Core::System& system;
+
+    /// Encodes and writes captures so saving does not stall the guest
+    mutable Common::ThreadWorker encode_worker;
 };
 
 } // namespace Service::Capture
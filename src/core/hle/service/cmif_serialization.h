@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "common/alignment.h"
 #include "common/div_ceil.h"
 
 #include "core/hle/service/cmif_types.h"
@@ -338,8 +339,21 @@ void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLE
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
             using ElementType = typename ArgType::Type;
 
-            // Set up scratch buffer.
+            // Mapped buffers alias guest memory like they do on hardware, let the handler write
+            // into them directly when they are backed by contiguous host memory. The scratch
+            // buffer is left empty so nothing is copied back afterwards.
             auto& buffer = temp[OutBufferIndex];
+            if constexpr ((ArgType::Attr & BufferAttr_HipcMapAlias) && !(ArgType::Attr & BufferAttr_HipcAutoSelect)) {
+                const auto direct = ctx.GetDirectWriteBufferB(OutBufferIndex);
+                if (!direct.empty() && Common::IsAligned(reinterpret_cast<uintptr_t>(direct.data()), alignof(ElementType))) {
+                    buffer.resize_destructive(0);
+                    std::get<ArgIndex>(args) = std::span((ElementType*) direct.data(), direct.size() / sizeof(ElementType));
+
+                    return ReadInArgument<MethodArguments, CallArguments, PrevAlign, DataOffset, HandleIndex, InBufferIndex, OutBufferIndex + 1, RawDataFinished, ArgIndex + 1>(is_domain, args, raw_data, ctx, temp);
+                }
+            }
+
+            // Set up scratch buffer.
             if (ctx.CanWriteBuffer(OutBufferIndex)) {
                 buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
             } else {
@@ -1,13 +1,17 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <future>
 #include <utility>
 
 #include "common/assert.h"
+#include "common/boot_trace.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "common/settings.h"
 #include "core/core.h"
+#include "core/crypto/key_manager.h"
 #include "core/file_sys/bis_factory.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/control_metadata.h"
@@ -698,7 +702,25 @@ void FileSystemController::CreateFactories(FileSys::VfsFilesystem& vfs, bool ove
     auto dump_directory =
         vfs.OpenDirectory(Common::FS::GetSuyuPathString(SuyuPath::DumpDir), rw_mode);
 
+    // Creating the factories parses every NCA in the registered caches. The SD card is scanned
+    // on another thread while the NAND is scanned here. Parsing NAX files derives the SD keys,
+    // which stores them in the key manager. Deriving them here first leaves both scans only
+    // reading it.
+    std::future<std::unique_ptr<FileSys::SDMCFactory>> sdmc_scan;
+    if (sdmc_factory == nullptr) {
+        auto& keys = Core::Crypto::KeyManager::Instance();
+        keys.DeriveSDSeedLazy();
+        std::array<Core::Crypto::Key256, 2> sd_keys{};
+        Core::Crypto::DeriveSDKeys(sd_keys, keys);
+        sdmc_scan = std::async(std::launch::async, [&] {
+            Common::BootTrace::Scope scope{"ScanSDContents"};
+            return std::make_unique<FileSys::SDMCFactory>(std::move(sd_directory),
+                                                          std::move(sd_load_directory));
+        });
+    }
+
     if (bis_factory == nullptr) {
+        Common::BootTrace::Scope scope{"ScanNANDContents"};
         bis_factory = std::make_unique<FileSys::BISFactory>(
             nand_directory, std::move(load_directory), std::move(dump_directory));
         system.RegisterContentProvider(FileSys::ContentProviderUnionSlot::SysNAND,
@@ -707,9 +729,8 @@ void FileSystemController::CreateFactories(FileSys::VfsFilesystem& vfs, bool ove
                                        bis_factory->GetUserNANDContents());
     }
 
-    if (sdmc_factory == nullptr) {
-        sdmc_factory = std::make_unique<FileSys::SDMCFactory>(std::move(sd_directory),
-                                                              std::move(sd_load_directory));
+    if (sdmc_scan.valid()) {
+        sdmc_factory = sdmc_scan.get();
         system.RegisterContentProvider(FileSys::ContentProviderUnionSlot::SDMC,
                                        sdmc_factory->GetSDMCContents());
     }
@@ -6,6 +6,7 @@
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/replay.h"
 #include "core/hle/kernel/svc.h"
 #include "core/hle/service/glue/time/standard_steady_clock_resource.h"
 #include "core/hle/service/psc/time/errors.h"
@@ -19,6 +20,7 @@ Result GetTimeInSeconds(Core::System& system, s64& out_time_s) {
     out_time_s = std::chrono::duration_cast<std::chrono::seconds>(
                      std::chrono::system_clock::now().time_since_epoch())
                      .count();
+    system.GetReplaySession().Process(Core::ReplaySession::Channel::Clock, out_time_s);
 
     if (Settings::values.custom_rtc_enabled) {
         out_time_s += Settings::values.custom_rtc_offset.GetValue();
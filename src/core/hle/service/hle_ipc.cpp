@@ -433,6 +433,19 @@ std::size_t HLERequestContext::WriteBufferB(const void* buffer, std::size_t size
     return size;
 }
 
+std::span<u8> HLERequestContext::GetDirectWriteBufferB(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorB().size()) {
+        return {};
+    }
+
+    const auto& descriptor = BufferDescriptorB()[buffer_index];
+    u8* const host_pointer = memory.GetWritableSpan(descriptor.Address(), descriptor.Size());
+    if (host_pointer == nullptr) {
+        return {};
+    }
+    return {host_pointer, descriptor.Size()};
+}
+
 std::size_t HLERequestContext::WriteBufferC(const void* buffer, std::size_t size,
                                             std::size_t buffer_index) const {
     if (buffer_index >= BufferDescriptorC().size() || size == 0) {
@@ -483,6 +496,18 @@ std::size_t HLERequestContext::GetWriteBufferSize(std::size_t buffer_index) cons
     return 0;
 }
 
+VAddr HLERequestContext::GetWriteBufferAddress(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        return BufferDescriptorB()[buffer_index].Address();
+    }
+    ASSERT_OR_EXECUTE_MSG(
+        BufferDescriptorC().size() > buffer_index, { return 0; },
+        "BufferDescriptorC invalid buffer_index {}", buffer_index);
+    return BufferDescriptorC()[buffer_index].Address();
+}
+
 bool HLERequestContext::CanReadBuffer(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
@@ -281,6 +281,10 @@ public:
     std::size_t WriteBufferC(const void* buffer, std::size_t size,
                              std::size_t buffer_index = 0) const;
 
+    /// Helper function to get buffer B as host memory that can be written directly, returns an
+    /// empty span if it has to be written through WriteBufferB instead
+    [[nodiscard]] std::span<u8> GetDirectWriteBufferB(std::size_t buffer_index = 0) const;
+
     /* Helper function to write a buffer using the appropriate buffer descriptor
      *
      * @tparam T an arbitrary container that satisfies the
@@ -309,6 +313,9 @@ public:
     /// Helper function to get the size of the output buffer
     [[nodiscard]] std::size_t GetWriteBufferSize(std::size_t buffer_index = 0) const;
 
+    /// Helper function to get the guest address of the output buffer
+    [[nodiscard]] VAddr GetWriteBufferAddress(std::size_t buffer_index = 0) const;
+
     /// Helper function to derive the number of elements able to be contained in the read buffer
     template <typename T>
     [[nodiscard]] std::size_t GetReadBufferNumElements(std::size_t buffer_index = 0) const {
@@ -1,10 +1,15 @@
 // SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "core/core.h"
+#include "core/core_timing.h"
 #include "core/hle/service/cmif_serialization.h"
 #include "core/hle/service/nvnflinger/binder.h"
+#include "core/hle/service/nvnflinger/buffer_queue_producer.h"
 #include "core/hle/service/nvnflinger/hos_binder_driver.h"
 #include "core/hle/service/nvnflinger/hos_binder_driver_server.h"
+#include "hid_core/hid_core.h"
+#include "hid_core/input_read_tracker.h"
 
 namespace Service::Nvnflinger {
 
@@ -34,6 +39,14 @@ Result IHOSBinderDriver::TransactParcel(s32 binder_id, u32 transaction_id,
     const auto binder = m_server->TryGetBinder(binder_id);
     R_SUCCEED_IF(binder == nullptr);
 
+    // Games poll input right after they acquire the next framebuffer
+    using TransactionId = android::BufferQueueProducer::TransactionId;
+    if (static_cast<TransactionId>(transaction_id) == TransactionId::DequeueBuffer &&
+        dynamic_cast<android::BufferQueueProducer*>(binder.get()) != nullptr) {
+        system.HIDCore().GetInputReadTracker().OnGuestFrame(
+            system.CoreTiming().GetGlobalTimeNs().count());
+    }
+
     binder->Transact(transaction_id, parcel_data, parcel_reply, flags);
 
     R_SUCCEED();
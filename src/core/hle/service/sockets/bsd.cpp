@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <array>
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -11,13 +12,18 @@
 #include "common/microprofile.h"
 #include "common/socket_types.h"
 #include "core/core.h"
+#include "core/hle/kernel/k_event.h"
 #include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/kernel.h"
 #include "core/hle/service/ipc_helpers.h"
 #include "core/hle/service/sockets/bsd.h"
 #include "core/hle/service/sockets/sockets_translate.h"
 #include "core/internal_network/network.h"
 #include "core/internal_network/socket_proxy.h"
+#include "core/internal_network/socket_reactor.h"
 #include "core/internal_network/sockets.h"
+#include "core/memory.h"
+#include "core/replay.h"
 #include "network/network.h"
 
 using Common::Expected;
@@ -51,10 +57,17 @@ void PutValue(std::span<u8> buffer, const T& t) {
     std::memcpy(buffer.data(), &t, std::min(sizeof(T), buffer.size()));
 }
 
+/// Interval at which completed parked requests are signalled again until they are picked up
+constexpr s32 PARKED_RESIGNAL_INTERVAL_MS = 1;
+
+Network::SocketReactor::Token ToReactorToken(const HLERequestContext* ctx) {
+    return reinterpret_cast<Network::SocketReactor::Token>(ctx);
+}
+
 } // Anonymous namespace
 
-void BSD::PollWork::Execute(BSD* bsd) {
-    std::tie(ret, bsd_errno) = bsd->PollImpl(write_buffer, read_buffer, nfds, timeout);
+void BSD::PollWork::Execute(BSD* bsd, ParkContext* park) {
+    std::tie(ret, bsd_errno) = bsd->PollImpl(write_buffer, read_buffer, nfds, timeout, park);
 }
 
 void BSD::PollWork::Response(HLERequestContext& ctx) {
@@ -68,8 +81,8 @@ void BSD::PollWork::Response(HLERequestContext& ctx) {
     rb.PushEnum(bsd_errno);
 }
 
-void BSD::AcceptWork::Execute(BSD* bsd) {
-    std::tie(ret, bsd_errno) = bsd->AcceptImpl(fd, write_buffer);
+void BSD::AcceptWork::Execute(BSD* bsd, ParkContext* park) {
+    std::tie(ret, bsd_errno) = bsd->AcceptImpl(fd, write_buffer, park);
 }
 
 void BSD::AcceptWork::Response(HLERequestContext& ctx) {
@@ -84,8 +97,8 @@ void BSD::AcceptWork::Response(HLERequestContext& ctx) {
     rb.Push<u32>(static_cast<u32>(write_buffer.size()));
 }
 
-void BSD::ConnectWork::Execute(BSD* bsd) {
-    bsd_errno = bsd->ConnectImpl(fd, addr);
+void BSD::ConnectWork::Execute(BSD* bsd, ParkContext* park) {
+    bsd_errno = bsd->ConnectImpl(fd, addr, park);
 }
 
 void BSD::ConnectWork::Response(HLERequestContext& ctx) {
@@ -95,12 +108,15 @@ void BSD::ConnectWork::Response(HLERequestContext& ctx) {
     rb.PushEnum(bsd_errno);
 }
 
-void BSD::RecvWork::Execute(BSD* bsd) {
-    std::tie(ret, bsd_errno) = bsd->RecvImpl(fd, flags, message);
+void BSD::RecvWork::Execute(BSD* bsd, ParkContext* park) {
+    std::tie(ret, bsd_errno) = bsd->RecvImpl(fd, flags, message, park);
 }
 
 void BSD::RecvWork::Response(HLERequestContext& ctx) {
-    ctx.WriteBuffer(message);
+    if (ret > 0) {
+        // The data was received straight into guest memory, let the rasterizer know
+        ctx.GetMemory().InvalidateDataCache(ctx.GetWriteBufferAddress(), ret);
+    }
 
     IPC::ResponseBuilder rb{ctx, 4};
     rb.Push(ResultSuccess);
@@ -108,12 +124,15 @@ void BSD::RecvWork::Response(HLERequestContext& ctx) {
     rb.PushEnum(bsd_errno);
 }
 
-void BSD::RecvFromWork::Execute(BSD* bsd) {
-    std::tie(ret, bsd_errno) = bsd->RecvFromImpl(fd, flags, message, addr);
+void BSD::RecvFromWork::Execute(BSD* bsd, ParkContext* park) {
+    std::tie(ret, bsd_errno) = bsd->RecvFromImpl(fd, flags, message, addr, park);
 }
 
 void BSD::RecvFromWork::Response(HLERequestContext& ctx) {
-    ctx.WriteBuffer(message, 0);
+    if (ret > 0) {
+        // The data was received straight into guest memory, let the rasterizer know
+        ctx.GetMemory().InvalidateDataCache(ctx.GetWriteBufferAddress(0), ret);
+    }
     if (!addr.empty()) {
         ctx.WriteBuffer(addr, 1);
     }
@@ -125,8 +144,8 @@ void BSD::RecvFromWork::Response(HLERequestContext& ctx) {
     rb.Push<u32>(static_cast<u32>(addr.size()));
 }
 
-void BSD::SendWork::Execute(BSD* bsd) {
-    std::tie(ret, bsd_errno) = bsd->SendImpl(fd, flags, message);
+void BSD::SendWork::Execute(BSD* bsd, ParkContext* park) {
+    std::tie(ret, bsd_errno) = bsd->SendImpl(fd, flags, message, park);
 }
 
 void BSD::SendWork::Response(HLERequestContext& ctx) {
@@ -136,8 +155,8 @@ void BSD::SendWork::Response(HLERequestContext& ctx) {
     rb.PushEnum(bsd_errno);
 }
 
-void BSD::SendToWork::Execute(BSD* bsd) {
-    std::tie(ret, bsd_errno) = bsd->SendToImpl(fd, flags, message, addr);
+void BSD::SendToWork::Execute(BSD* bsd, ParkContext* park) {
+    std::tie(ret, bsd_errno) = bsd->SendToImpl(fd, flags, message, addr, park);
 }
 
 void BSD::SendToWork::Response(HLERequestContext& ctx) {
@@ -355,10 +374,14 @@ void BSD::Recv(HLERequestContext& ctx) {
 
     LOG_DEBUG(Service, "called. fd={} flags=0x{:x} len={}", fd, flags, ctx.GetWriteBufferSize());
 
+    // Receive straight into the guest output buffer
+    Core::Memory::CpuGuestMemoryScoped<u8, Core::Memory::GuestMemoryFlags::UnsafeWrite> message{
+        ctx.GetMemory(), ctx.GetWriteBufferAddress(), ctx.GetWriteBufferSize()};
+
     ExecuteWork(ctx, RecvWork{
                          .fd = fd,
                          .flags = flags,
-                         .message = std::vector<u8>(ctx.GetWriteBufferSize()),
+                         .message = std::span<u8>(message.data(), message.size()),
                      });
 }
 
@@ -371,10 +394,14 @@ void BSD::RecvFrom(HLERequestContext& ctx) {
     LOG_DEBUG(Service, "called. fd={} flags=0x{:x} len={} addrlen={}", fd, flags,
               ctx.GetWriteBufferSize(0), ctx.GetWriteBufferSize(1));
 
+    // Receive straight into the guest output buffer
+    Core::Memory::CpuGuestMemoryScoped<u8, Core::Memory::GuestMemoryFlags::UnsafeWrite> message{
+        ctx.GetMemory(), ctx.GetWriteBufferAddress(0), ctx.GetWriteBufferSize(0)};
+
     ExecuteWork(ctx, RecvFromWork{
                          .fd = fd,
                          .flags = flags,
-                         .message = std::vector<u8>(ctx.GetWriteBufferSize(0)),
+                         .message = std::span<u8>(message.data(), message.size()),
                          .addr = std::vector<u8>(ctx.GetWriteBufferSize(1)),
                      });
 }
@@ -481,10 +508,198 @@ void BSD::EventFd(HLERequestContext& ctx) {
 
 template <typename Work>
 void BSD::ExecuteWork(HLERequestContext& ctx, Work work) {
-    work.Execute(this);
+    if (!reactor) {
+        work.Execute(this, nullptr);
+        work.Response(ctx);
+        return;
+    }
+
+    ParkContext park{};
+    if (!ResumeParkedRequest(ctx, park)) {
+        // Woken up by a deferral meant for another request, keep waiting
+        ctx.SetIsDeferred();
+        return;
+    }
+
+    work.Execute(this, &park);
+    if (!park.wait_fds.empty() && ParkRequest(ctx, park)) {
+        return;
+    }
     work.Response(ctx);
 }
 
+bool BSD::ResumeParkedRequest(HLERequestContext& ctx, ParkContext& park) {
+    std::scoped_lock lk{parked_mutex};
+    const auto it = parked_requests.find(&ctx);
+    if (it == parked_requests.end()) {
+        return true;
+    }
+    if (it->second.state == ParkedRequest::State::Waiting) {
+        return false;
+    }
+    park.resumed = true;
+    park.timed_out = it->second.state == ParkedRequest::State::TimedOut;
+    park.deadline = it->second.deadline;
+    parked_requests.erase(it);
+    return true;
+}
+
+bool BSD::ParkRequest(HLERequestContext& ctx, ParkContext& park) {
+    const auto token = ToReactorToken(&ctx);
+    {
+        std::scoped_lock lk{parked_mutex};
+        parked_requests.insert_or_assign(&ctx, ParkedRequest{.deadline = park.deadline});
+    }
+
+    for (const Network::PollFD& pollfd : park.wait_fds) {
+        if (reactor->Arm(token, *pollfd.socket, pollfd.events) != Network::Errno::SUCCESS) {
+            LOG_ERROR(Service, "Failed to park request on the socket reactor");
+            reactor->Disarm(token);
+            std::scoped_lock lk{parked_mutex};
+            parked_requests.erase(&ctx);
+            return false;
+        }
+    }
+
+    // Wake up the reactor so it takes the new deadline into account
+    reactor->Interrupt();
+    ctx.SetIsDeferred();
+    return true;
+}
+
+void BSD::ReactorLoop() {
+    using namespace std::chrono;
+
+    std::vector<Network::SocketReactor::Token> ready;
+    std::vector<Network::SocketReactor::Token> timed_out;
+    while (!reactor_stop) {
+        s32 timeout = -1;
+        {
+            std::scoped_lock lk{parked_mutex};
+            const auto now = steady_clock::now();
+            for (const auto& [request, parked] : parked_requests) {
+                s32 candidate = -1;
+                if (parked.state != ParkedRequest::State::Waiting) {
+                    // The deferral may have raced with the request being queued, signal again
+                    candidate = PARKED_RESIGNAL_INTERVAL_MS;
+                } else if (parked.deadline) {
+                    const auto remaining = ceil<milliseconds>(*parked.deadline - now).count();
+                    candidate = static_cast<s32>(std::max<s64>(remaining, 0));
+                }
+                if (candidate >= 0 && (timeout < 0 || candidate < timeout)) {
+                    timeout = candidate;
+                }
+            }
+        }
+
+        ready.clear();
+        reactor->Wait(ready, timeout);
+
+        timed_out.clear();
+        bool signal = false;
+        {
+            std::scoped_lock lk{parked_mutex};
+            for (const auto token : ready) {
+                const auto it =
+                    parked_requests.find(reinterpret_cast<const HLERequestContext*>(token));
+                if (it != parked_requests.end() &&
+                    it->second.state == ParkedRequest::State::Waiting) {
+                    it->second.state = ParkedRequest::State::Ready;
+                }
+            }
+            const auto now = steady_clock::now();
+            for (auto& [request, parked] : parked_requests) {
+                if (parked.state == ParkedRequest::State::Waiting && parked.deadline &&
+                    *parked.deadline <= now) {
+                    parked.state = ParkedRequest::State::TimedOut;
+                    timed_out.push_back(ToReactorToken(request));
+                }
+                signal |= parked.state != ParkedRequest::State::Waiting;
+            }
+        }
+
+        for (const auto token : timed_out) {
+            reactor->Disarm(token);
+        }
+        if (signal) {
+            deferral_event->Signal();
+        }
+    }
+}
+
+bool BSD::ShouldPark(const FileDescriptor& descriptor, const ParkContext* park) const noexcept {
+    // Requests whose socket timeout expired complete with the error of a non-blocking call
+    return park != nullptr && !park->timed_out && descriptor.is_reactor_managed &&
+           (descriptor.flags & Network::FLAG_O_NONBLOCK) == 0;
+}
+
+void BSD::ParkOnSocket(const FileDescriptor& descriptor, ParkContext* park,
+                       Network::PollEvents events, u32 timeout_ms) const {
+    park->wait_fds.push_back({descriptor.socket.get(), events, {}});
+    // Requests woken up before their deadline keep the deadline of the first attempt
+    if (timeout_ms != 0 && !park->deadline) {
+        park->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{timeout_ms};
+    }
+}
+
+void BSD::ManageWithReactor(FileDescriptor& descriptor) {
+    // Proxy sockets have no host descriptor to wait on
+    if (!reactor || dynamic_cast<Network::Socket*>(descriptor.socket.get()) == nullptr) {
+        return;
+    }
+    if (descriptor.socket->SetNonBlock(true) == Network::Errno::SUCCESS) {
+        descriptor.is_reactor_managed = true;
+    }
+}
+
+struct ReplayedResult {
+    s32 ret;
+    u32 bsd_errno;
+};
+
+bool BSD::ReplayResult(std::pair<s32, Errno>& out_result, std::span<u8> data) {
+    auto& replay_session = system.GetReplaySession();
+    if (!replay_session.IsReplaying()) {
+        return false;
+    }
+
+    std::vector<u8> payload;
+    if (!replay_session.Next(Core::ReplaySession::Channel::Network, payload) ||
+        payload.size() < sizeof(ReplayedResult)) {
+        // The replay has desynced, fall back to the live socket
+        return false;
+    }
+
+    ReplayedResult result;
+    std::memcpy(&result, payload.data(), sizeof(result));
+    const size_t data_size = std::min(payload.size() - sizeof(result), data.size());
+    std::memcpy(data.data(), payload.data() + sizeof(result), data_size);
+
+    out_result = {result.ret, static_cast<Errno>(result.bsd_errno)};
+    return true;
+}
+
+void BSD::RecordResult(std::pair<s32, Errno> result, std::span<const u8> data,
+                       const ParkContext* park) {
+    auto& replay_session = system.GetReplaySession();
+    if (!replay_session.IsRecording()) {
+        return;
+    }
+    // Parked requests run again once the socket is ready, only their final result is recorded
+    if (park != nullptr && !park->wait_fds.empty()) {
+        return;
+    }
+
+    const ReplayedResult header{
+        .ret = result.first,
+        .bsd_errno = static_cast<u32>(result.second),
+    };
+    std::vector<u8> payload(sizeof(header) + data.size());
+    std::memcpy(payload.data(), &header, sizeof(header));
+    std::memcpy(payload.data() + sizeof(header), data.data(), data.size());
+    replay_session.Record(Core::ReplaySession::Channel::Network, payload);
+}
+
 std::pair<s32, Errno> BSD::SocketImpl(Domain domain, Type type, Protocol protocol) {
     if (type == Type::SEQPACKET) {
         UNIMPLEMENTED_MSG("SOCK_SEQPACKET errno management");
@@ -517,12 +732,13 @@ std::pair<s32, Errno> BSD::SocketImpl(Domain domain, Type type, Protocol protoco
 
     descriptor.socket->Initialize(Translate(domain), Translate(type), Translate(protocol));
     descriptor.is_connection_based = IsConnectionBased(type);
+    ManageWithReactor(descriptor);
 
     return {fd, Errno::SUCCESS};
 }
 
 std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<const u8> read_buffer,
-                                    s32 nfds, s32 timeout) {
+                                    s32 nfds, s32 timeout, ParkContext* park) {
     if (nfds <= 0) {
         // When no entries are provided, -1 is returned with errno zero
         return {-1, Errno::SUCCESS};
@@ -568,6 +784,11 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
         }
     }
 
+    const std::span<u8> poll_result{write_buffer.data(), nfds * sizeof(PollFD)};
+    if (std::pair<s32, Errno> replayed; ReplayResult(replayed, poll_result)) {
+        return replayed;
+    }
+
     std::vector<Network::PollFD> host_pollfds(fds.size());
     std::transform(fds.begin(), fds.end(), host_pollfds.begin(), [this](PollFD pollfd) {
         Network::PollFD result;
@@ -577,7 +798,21 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
         return result;
     });
 
-    const auto result = Network::Poll(host_pollfds, timeout);
+    const bool can_park =
+        park != nullptr && timeout != 0 &&
+        std::all_of(fds.begin(), fds.end(), [this](const PollFD& pollfd) {
+            return file_descriptors[pollfd.fd]->is_reactor_managed;
+        });
+
+    auto result = Network::Poll(host_pollfds, can_park ? 0 : timeout);
+    if (can_park && result.first == 0 && !park->timed_out) {
+        // Nothing is ready yet, park the request until the reactor reports readiness
+        if (!park->deadline && timeout > 0) {
+            park->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{timeout};
+        }
+        park->wait_fds = host_pollfds;
+        return {0, Errno::SUCCESS};
+    }
 
     const size_t num = host_pollfds.size();
     for (size_t i = 0; i < num; ++i) {
@@ -585,10 +820,12 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
     }
     std::memcpy(write_buffer.data(), fds.data(), nfds * sizeof(PollFD));
 
+    RecordResult(Translate(result), poll_result, park);
     return Translate(result);
 }
 
-std::pair<s32, Errno> BSD::AcceptImpl(s32 fd, std::vector<u8>& write_buffer) {
+std::pair<s32, Errno> BSD::AcceptImpl(s32 fd, std::vector<u8>& write_buffer,
+                                     ParkContext* park) {
     if (!IsFileDescriptorValid(fd)) {
         return {-1, Errno::BADF};
     }
@@ -601,6 +838,9 @@ std::pair<s32, Errno> BSD::AcceptImpl(s32 fd, std::vector<u8>& write_buffer) {
 
     FileDescriptor& descriptor = *file_descriptors[fd];
     auto [result, bsd_errno] = descriptor.socket->Accept();
+    if (bsd_errno == Network::Errno::AGAIN && ShouldPark(descriptor, park)) {
+        ParkOnSocket(descriptor, park, Network::PollEvents::In, descriptor.recv_timeout_ms);
+    }
     if (bsd_errno != Network::Errno::SUCCESS) {
         return {-1, Translate(bsd_errno)};
     }
@@ -609,6 +849,7 @@ std::pair<s32, Errno> BSD::AcceptImpl(s32 fd, std::vector<u8>& write_buffer) {
     FileDescriptor& new_descriptor = *file_descriptors[new_fd];
     new_descriptor.socket = std::move(result.socket);
     new_descriptor.is_connection_based = descriptor.is_connection_based;
+    ManageWithReactor(new_descriptor);
 
     const SockAddrIn guest_addr_in = Translate(result.sockaddr_in);
     PutValue(write_buffer, guest_addr_in);
@@ -626,7 +867,7 @@ Errno BSD::BindImpl(s32 fd, std::span<const u8> addr) {
     return Translate(file_descriptors[fd]->socket->Bind(Translate(addr_in)));
 }
 
-Errno BSD::ConnectImpl(s32 fd, std::span<const u8> addr) {
+Errno BSD::ConnectImpl(s32 fd, std::span<const u8> addr, ParkContext* park) {
     if (!IsFileDescriptorValid(fd)) {
         return Errno::BADF;
     }
@@ -634,7 +875,31 @@ Errno BSD::ConnectImpl(s32 fd, std::span<const u8> addr) {
     UNIMPLEMENTED_IF(addr.size() != sizeof(SockAddrIn));
     auto addr_in = GetValue<SockAddrIn>(addr);
 
-    return Translate(file_descriptors[fd]->socket->Connect(Translate(addr_in)));
+    if (std::pair<s32, Errno> replayed; ReplayResult(replayed, {})) {
+        return replayed.second;
+    }
+
+    FileDescriptor& descriptor = *file_descriptors[fd];
+    if (park != nullptr && park->timed_out) {
+        RecordResult({0, Errno::TIMEDOUT}, {}, park);
+        return Errno::TIMEDOUT;
+    }
+    if (park != nullptr && park->resumed && descriptor.is_reactor_managed) {
+        // The connection attempt completed while the request was parked
+        const auto [pending_err, getsockopt_err] = descriptor.socket->GetPendingError();
+        const Errno bsd_errno = getsockopt_err != Network::Errno::SUCCESS
+                                    ? Translate(getsockopt_err)
+                                    : Translate(pending_err);
+        RecordResult({0, bsd_errno}, {}, park);
+        return bsd_errno;
+    }
+
+    const Network::Errno result = descriptor.socket->Connect(Translate(addr_in));
+    if (result == Network::Errno::INPROGRESS && ShouldPark(descriptor, park)) {
+        ParkOnSocket(descriptor, park, Network::PollEvents::Out, descriptor.send_timeout_ms);
+    }
+    RecordResult({0, Translate(result)}, {}, park);
+    return Translate(result);
 }
 
 Errno BSD::GetPeerNameImpl(s32 fd, std::vector<u8>& write_buffer) {
@@ -690,10 +955,12 @@ std::pair<s32, Errno> BSD::FcntlImpl(s32 fd, FcntlCmd cmd, s32 arg) {
         ASSERT(arg == 0);
         return {descriptor.flags, Errno::SUCCESS};
     case FcntlCmd::SETFL: {
-        const bool enable = (arg & Network::FLAG_O_NONBLOCK) != 0;
-        const Errno bsd_errno = Translate(descriptor.socket->SetNonBlock(enable));
-        if (bsd_errno != Errno::SUCCESS) {
-            return {-1, bsd_errno};
+        if (!descriptor.is_reactor_managed) {
+            const bool enable = (arg & Network::FLAG_O_NONBLOCK) != 0;
+            const Errno bsd_errno = Translate(descriptor.socket->SetNonBlock(enable));
+            if (bsd_errno != Errno::SUCCESS) {
+                return {-1, bsd_errno};
+            }
         }
         descriptor.flags = arg;
         return {0, Errno::SUCCESS};
@@ -773,8 +1040,10 @@ Errno BSD::SetSockOptImpl(s32 fd, u32 level, OptName optname, std::span<const u8
     case OptName::RCVBUF:
         return Translate(socket->SetRcvBuf(value));
     case OptName::SNDTIMEO:
+        file_descriptors[fd]->send_timeout_ms = value;
         return Translate(socket->SetSndTimeo(value));
     case OptName::RCVTIMEO:
+        file_descriptors[fd]->recv_timeout_ms = value;
         return Translate(socket->SetRcvTimeo(value));
     case OptName::NOSIGPIPE:
         LOG_WARNING(Service, "(STUBBED) setting NOSIGPIPE to {}", value);
@@ -793,19 +1062,27 @@ Errno BSD::ShutdownImpl(s32 fd, s32 how) {
     return Translate(file_descriptors[fd]->socket->Shutdown(host_how));
 }
 
-std::pair<s32, Errno> BSD::RecvImpl(s32 fd, u32 flags, std::vector<u8>& message) {
+std::pair<s32, Errno> BSD::RecvImpl(s32 fd, u32 flags, std::span<u8> message,
+                                    ParkContext* park) {
     if (!IsFileDescriptorValid(fd)) {
         return {-1, Errno::BADF};
     }
 
+    if (std::pair<s32, Errno> replayed; ReplayResult(replayed, message)) {
+        return replayed;
+    }
+
     FileDescriptor& descriptor = *file_descriptors[fd];
 
     // Apply flags
     using Network::FLAG_MSG_DONTWAIT;
     using Network::FLAG_O_NONBLOCK;
-    if ((flags & FLAG_MSG_DONTWAIT) != 0) {
+    const bool dont_wait = (flags & FLAG_MSG_DONTWAIT) != 0;
+    const bool toggle_non_block =
+        !descriptor.is_reactor_managed && (descriptor.flags & FLAG_O_NONBLOCK) == 0;
+    if (dont_wait) {
         flags &= ~FLAG_MSG_DONTWAIT;
-        if ((descriptor.flags & FLAG_O_NONBLOCK) == 0) {
+        if (toggle_non_block) {
             descriptor.socket->SetNonBlock(true);
         }
     }
@@ -813,20 +1090,35 @@ std::pair<s32, Errno> BSD::RecvImpl(s32 fd, u32 flags, std::vector<u8>& message)
     const auto [ret, bsd_errno] = Translate(descriptor.socket->Recv(flags, message));
 
     // Restore original state
-    if ((descriptor.flags & FLAG_O_NONBLOCK) == 0) {
+    if (toggle_non_block) {
         descriptor.socket->SetNonBlock(false);
     }
 
+    if (bsd_errno == Errno::AGAIN && !dont_wait && ShouldPark(descriptor, park)) {
+        ParkOnSocket(descriptor, park, Network::PollEvents::In, descriptor.recv_timeout_ms);
+    }
+
+    RecordResult({ret, bsd_errno}, message.first(ret > 0 ? static_cast<size_t>(ret) : 0), park);
     return {ret, bsd_errno};
 }
 
-std::pair<s32, Errno> BSD::RecvFromImpl(s32 fd, u32 flags, std::vector<u8>& message,
-                                        std::vector<u8>& addr) {
+std::pair<s32, Errno> BSD::RecvFromImpl(s32 fd, u32 flags, std::span<u8> message,
+                                        std::vector<u8>& addr, ParkContext* park) {
     if (!IsFileDescriptorValid(fd)) {
         return {-1, Errno::BADF};
     }
 
     FileDescriptor& descriptor = *file_descriptors[fd];
+    if (std::pair<s32, Errno> replayed; ReplayResult(replayed, message)) {
+        // Connection based sockets report no address, the others report the recorded sender
+        if (descriptor.is_connection_based || replayed.first < 0) {
+            addr.clear();
+        } else {
+            std::pair<s32, Errno> replayed_addr;
+            ReplayResult(replayed_addr, addr);
+        }
+        return replayed;
+    }
 
     Network::SockAddrIn addr_in{};
     Network::SockAddrIn* p_addr_in = nullptr;
@@ -840,9 +1132,12 @@ std::pair<s32, Errno> BSD::RecvFromImpl(s32 fd, u32 flags, std::vector<u8>& mess
     // Apply flags
     using Network::FLAG_MSG_DONTWAIT;
     using Network::FLAG_O_NONBLOCK;
-    if ((flags & FLAG_MSG_DONTWAIT) != 0) {
+    const bool dont_wait = (flags & FLAG_MSG_DONTWAIT) != 0;
+    const bool toggle_non_block =
+        !descriptor.is_reactor_managed && (descriptor.flags & FLAG_O_NONBLOCK) == 0;
+    if (dont_wait) {
         flags &= ~FLAG_MSG_DONTWAIT;
-        if ((descriptor.flags & FLAG_O_NONBLOCK) == 0) {
+        if (toggle_non_block) {
             descriptor.socket->SetNonBlock(true);
         }
     }
@@ -850,10 +1145,14 @@ std::pair<s32, Errno> BSD::RecvFromImpl(s32 fd, u32 flags, std::vector<u8>& mess
     const auto [ret, bsd_errno] = Translate(descriptor.socket->RecvFrom(flags, message, p_addr_in));
 
     // Restore original state
-    if ((descriptor.flags & FLAG_O_NONBLOCK) == 0) {
+    if (toggle_non_block) {
         descriptor.socket->SetNonBlock(false);
     }
 
+    if (bsd_errno == Errno::AGAIN && !dont_wait && ShouldPark(descriptor, park)) {
+        ParkOnSocket(descriptor, park, Network::PollEvents::In, descriptor.recv_timeout_ms);
+    }
+
     if (p_addr_in) {
         if (ret < 0) {
             addr.clear();
@@ -864,18 +1163,34 @@ std::pair<s32, Errno> BSD::RecvFromImpl(s32 fd, u32 flags, std::vector<u8>& mess
         }
     }
 
+    RecordResult({ret, bsd_errno}, message.first(ret > 0 ? static_cast<size_t>(ret) : 0), park);
+    if (p_addr_in && ret >= 0) {
+        RecordResult({ret, bsd_errno}, addr, park);
+    }
     return {ret, bsd_errno};
 }
 
-std::pair<s32, Errno> BSD::SendImpl(s32 fd, u32 flags, std::span<const u8> message) {
+std::pair<s32, Errno> BSD::SendImpl(s32 fd, u32 flags, std::span<const u8> message,
+                                    ParkContext* park) {
     if (!IsFileDescriptorValid(fd)) {
         return {-1, Errno::BADF};
     }
-    return Translate(file_descriptors[fd]->socket->Send(message, flags));
+
+    if (std::pair<s32, Errno> replayed; ReplayResult(replayed, {})) {
+        return replayed;
+    }
+
+    FileDescriptor& descriptor = *file_descriptors[fd];
+    const auto result = Translate(descriptor.socket->Send(message, flags));
+    if (result.second == Errno::AGAIN && ShouldPark(descriptor, park)) {
+        ParkOnSocket(descriptor, park, Network::PollEvents::Out, descriptor.send_timeout_ms);
+    }
+    RecordResult(result, {}, park);
+    return result;
 }
 
 std::pair<s32, Errno> BSD::SendToImpl(s32 fd, u32 flags, std::span<const u8> message,
-                                      std::span<const u8> addr) {
+                                      std::span<const u8> addr, ParkContext* park) {
     if (!IsFileDescriptorValid(fd)) {
         return {-1, Errno::BADF};
     }
@@ -889,7 +1204,17 @@ std::pair<s32, Errno> BSD::SendToImpl(s32 fd, u32 flags, std::span<const u8> mes
         p_addr_in = &addr_in;
     }
 
-    return Translate(file_descriptors[fd]->socket->SendTo(flags, message, p_addr_in));
+    if (std::pair<s32, Errno> replayed; ReplayResult(replayed, {})) {
+        return replayed;
+    }
+
+    FileDescriptor& descriptor = *file_descriptors[fd];
+    const auto result = Translate(descriptor.socket->SendTo(flags, message, p_addr_in));
+    if (result.second == Errno::AGAIN && ShouldPark(descriptor, park)) {
+        ParkOnSocket(descriptor, park, Network::PollEvents::Out, descriptor.send_timeout_ms);
+    }
+    RecordResult(result, {}, park);
+    return result;
 }
 
 Errno BSD::CloseImpl(s32 fd) {
@@ -897,6 +1222,11 @@ Errno BSD::CloseImpl(s32 fd) {
         return Errno::BADF;
     }
 
+    if (reactor && file_descriptors[fd]->is_reactor_managed) {
+        // Complete requests parked on this socket, they will observe it as closed
+        reactor->Release(*file_descriptors[fd]->socket);
+    }
+
     const Errno bsd_errno = Translate(file_descriptors[fd]->socket->Close());
     if (bsd_errno != Errno::SUCCESS) {
         return bsd_errno;
@@ -927,7 +1257,27 @@ std::optional<std::shared_ptr<Network::SocketBase>> BSD::GetSocket(s32 fd) {
     if (!IsFileDescriptorValid(fd)) {
         return std::nullopt;
     }
-    return file_descriptors[fd]->socket;
+
+    // Callers operate on the host socket directly and expect its blocking mode to match the guest
+    const auto& socket = file_descriptors[fd]->socket;
+    for (auto& descriptor : file_descriptors) {
+        if (descriptor && descriptor->socket == socket && descriptor->is_reactor_managed) {
+            descriptor->is_reactor_managed = false;
+            socket->SetNonBlock((descriptor->flags & Network::FLAG_O_NONBLOCK) != 0);
+        }
+    }
+    return socket;
+}
+
+void BSD::SetDeferralEvent(Kernel::KEvent* deferral_event_) {
+    if (!Network::SocketReactor::IsSupported()) {
+        return;
+    }
+
+    deferral_event = deferral_event_;
+    reactor = std::make_unique<Network::SocketReactor>();
+    reactor_thread =
+        system.Kernel().RunOnHostCoreThread("bsdsocket:reactor", [this] { ReactorLoop(); });
 }
 
 s32 BSD::FindFreeFileDescriptorHandle() noexcept {
@@ -1021,6 +1371,12 @@ BSD::BSD(Core::System& system_, const char* name)
 }
 
 BSD::~BSD() {
+    if (reactor) {
+        reactor_stop = true;
+        reactor->Interrupt();
+        reactor_thread.join();
+    }
+
     if (auto room_member = room_network.GetRoomMember().lock()) {
         room_member->Unbind(proxy_packet_received);
     }
@@ -3,24 +3,37 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
+#include <unordered_map>
 #include <vector>
 
+#include "common/polyfill_thread.h"
+
 #include "common/common_types.h"
 #include "common/expected.h"
 #include "common/socket_types.h"
 #include "core/hle/service/service.h"
 #include "core/hle/service/sockets/sockets.h"
+#include "core/internal_network/network.h"
 #include "network/network.h"
 
 namespace Core {
 class System;
 }
 
+namespace Kernel {
+class KEvent;
+}
+
 namespace Network {
 class SocketBase;
 class Socket;
+class SocketReactor;
 } // namespace Network
 
 namespace Service::Sockets {
@@ -37,6 +50,10 @@ public:
     Errno CloseImpl(s32 fd);
     std::optional<std::shared_ptr<Network::SocketBase>> GetSocket(s32 fd);
 
+    /// Enables parking of blocking requests on the host socket reactor, when supported.
+    /// Parked requests are completed by signalling the server manager deferral event.
+    void SetDeferralEvent(Kernel::KEvent* deferral_event_);
+
 private:
     /// Maximum number of file descriptors
     static constexpr size_t MAX_FD = 128;
@@ -45,10 +62,37 @@ private:
         std::shared_ptr<Network::SocketBase> socket;
         s32 flags = 0;
         bool is_connection_based = false;
+        /// Host socket is kept non-blocking and guest blocking calls are parked on the reactor
+        bool is_reactor_managed = false;
+        /// Guest SO_SNDTIMEO and SO_RCVTIMEO in milliseconds, bounding parked requests
+        u32 send_timeout_ms = 0;
+        u32 recv_timeout_ms = 0;
+    };
+
+    /// Parking state handed to blocking work, nullptr when the reactor is not in use
+    struct ParkContext {
+        /// True when the request is re-executed after being woken up by the reactor
+        bool resumed{};
+        /// True when the request is re-executed because its wait deadline passed
+        bool timed_out{};
+        /// Filled by the work when the request would block and has to be parked
+        std::vector<Network::PollFD> wait_fds;
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+    };
+
+    struct ParkedRequest {
+        enum class State {
+            Waiting,
+            Ready,
+            TimedOut,
+        };
+
+        State state{State::Waiting};
+        std::optional<std::chrono::steady_clock::time_point> deadline;
     };
 
     struct PollWork {
-        void Execute(BSD* bsd);
+        void Execute(BSD* bsd, ParkContext* park);
         void Response(HLERequestContext& ctx);
 
         s32 nfds;
@@ -60,7 +104,7 @@ private:
     };
 
     struct AcceptWork {
-        void Execute(BSD* bsd);
+        void Execute(BSD* bsd, ParkContext* park);
         void Response(HLERequestContext& ctx);
 
         s32 fd;
@@ -70,7 +114,7 @@ private:
     };
 
     struct ConnectWork {
-        void Execute(BSD* bsd);
+        void Execute(BSD* bsd, ParkContext* park);
         void Response(HLERequestContext& ctx);
 
         s32 fd;
@@ -79,30 +123,30 @@ private:
     };
 
     struct RecvWork {
-        void Execute(BSD* bsd);
+        void Execute(BSD* bsd, ParkContext* park);
         void Response(HLERequestContext& ctx);
 
         s32 fd;
         u32 flags;
-        std::vector<u8> message;
+        std::span<u8> message;
         s32 ret{};
         Errno bsd_errno{};
     };
 
     struct RecvFromWork {
-        void Execute(BSD* bsd);
+        void Execute(BSD* bsd, ParkContext* park);
         void Response(HLERequestContext& ctx);
 
         s32 fd;
         u32 flags;
-        std::vector<u8> message;
+        std::span<u8> message;
         std::vector<u8> addr;
         s32 ret{};
         Errno bsd_errno{};
     };
 
     struct SendWork {
-        void Execute(BSD* bsd);
+        void Execute(BSD* bsd, ParkContext* park);
         void Response(HLERequestContext& ctx);
 
         s32 fd;
@@ -113,7 +157,7 @@ private:
     };
 
     struct SendToWork {
-        void Execute(BSD* bsd);
+        void Execute(BSD* bsd, ParkContext* park);
         void Response(HLERequestContext& ctx);
 
         s32 fd;
@@ -152,12 +196,24 @@ private:
     template <typename Work>
     void ExecuteWork(HLERequestContext& ctx, Work work);
 
+    bool ResumeParkedRequest(HLERequestContext& ctx, ParkContext& park);
+    bool ParkRequest(HLERequestContext& ctx, ParkContext& park);
+    void ReactorLoop();
+    bool ShouldPark(const FileDescriptor& descriptor, const ParkContext* park) const noexcept;
+    void ParkOnSocket(const FileDescriptor& descriptor, ParkContext* park,
+                      Network::PollEvents events, u32 timeout_ms) const;
+    void ManageWithReactor(FileDescriptor& descriptor);
+    bool ReplayResult(std::pair<s32, Errno>& out_result, std::span<u8> data);
+    void RecordResult(std::pair<s32, Errno> result, std::span<const u8> data,
+                      const ParkContext* park);
+
     std::pair<s32, Errno> SocketImpl(Domain domain, Type type, Protocol protocol);
     std::pair<s32, Errno> PollImpl(std::vector<u8>& write_buffer, std::span<const u8> read_buffer,
-                                   s32 nfds, s32 timeout);
-    std::pair<s32, Errno> AcceptImpl(s32 fd, std::vector<u8>& write_buffer);
+                                   s32 nfds, s32 timeout, ParkContext* park = nullptr);
+    std::pair<s32, Errno> AcceptImpl(s32 fd, std::vector<u8>& write_buffer,
+                                     ParkContext* park = nullptr);
     Errno BindImpl(s32 fd, std::span<const u8> addr);
-    Errno ConnectImpl(s32 fd, std::span<const u8> addr);
+    Errno ConnectImpl(s32 fd, std::span<const u8> addr, ParkContext* park = nullptr);
     Errno GetPeerNameImpl(s32 fd, std::vector<u8>& write_buffer);
     Errno GetSockNameImpl(s32 fd, std::vector<u8>& write_buffer);
     Errno ListenImpl(s32 fd, s32 backlog);
@@ -165,12 +221,14 @@ private:
     Errno GetSockOptImpl(s32 fd, u32 level, OptName optname, std::vector<u8>& optval);
     Errno SetSockOptImpl(s32 fd, u32 level, OptName optname, std::span<const u8> optval);
     Errno ShutdownImpl(s32 fd, s32 how);
-    std::pair<s32, Errno> RecvImpl(s32 fd, u32 flags, std::vector<u8>& message);
-    std::pair<s32, Errno> RecvFromImpl(s32 fd, u32 flags, std::vector<u8>& message,
-                                       std::vector<u8>& addr);
-    std::pair<s32, Errno> SendImpl(s32 fd, u32 flags, std::span<const u8> message);
+    std::pair<s32, Errno> RecvImpl(s32 fd, u32 flags, std::span<u8> message,
+                                   ParkContext* park = nullptr);
+    std::pair<s32, Errno> RecvFromImpl(s32 fd, u32 flags, std::span<u8> message,
+                                       std::vector<u8>& addr, ParkContext* park = nullptr);
+    std::pair<s32, Errno> SendImpl(s32 fd, u32 flags, std::span<const u8> message,
+                                   ParkContext* park = nullptr);
     std::pair<s32, Errno> SendToImpl(s32 fd, u32 flags, std::span<const u8> message,
-                                     std::span<const u8> addr);
+                                     std::span<const u8> addr, ParkContext* park = nullptr);
 
     s32 FindFreeFileDescriptorHandle() noexcept;
     bool IsFileDescriptorValid(s32 fd) const noexcept;
@@ -181,6 +239,14 @@ private:
 
     Network::RoomNetwork& room_network;
 
+    /// Host socket reactor, only created when the platform supports it
+    std::unique_ptr<Network::SocketReactor> reactor;
+    Kernel::KEvent* deferral_event{};
+    std::mutex parked_mutex;
+    std::unordered_map<const HLERequestContext*, ParkedRequest> parked_requests;
+    std::atomic_bool reactor_stop{};
+    std::jthread reactor_thread;
+
     /// Callback to parse and handle a received wifi packet.
     void OnProxyPacketReceived(const Network::ProxyPacket& packet);
 
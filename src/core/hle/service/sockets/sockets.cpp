@@ -12,8 +12,17 @@ namespace Service::Sockets {
 void LoopProcess(Core::System& system) {
     auto server_manager = std::make_unique<ServerManager>(system);
 
-    server_manager->RegisterNamedService("bsd:s", std::make_shared<BSD>(system, "bsd:s"));
-    server_manager->RegisterNamedService("bsd:u", std::make_shared<BSD>(system, "bsd:u"));
+    // Blocking socket requests are deferred and completed once the host socket is ready
+    Kernel::KEvent* deferral_event{};
+    server_manager->ManageDeferral(&deferral_event);
+
+    auto bsd_s = std::make_shared<BSD>(system, "bsd:s");
+    auto bsd_u = std::make_shared<BSD>(system, "bsd:u");
+    bsd_s->SetDeferralEvent(deferral_event);
+    bsd_u->SetDeferralEvent(deferral_event);
+
+    server_manager->RegisterNamedService("bsd:s", std::move(bsd_s));
+    server_manager->RegisterNamedService("bsd:u", std::move(bsd_u));
     server_manager->RegisterNamedService("bsdcfg", std::make_shared<BSDCFG>(system));
     server_manager->RegisterNamedService("nsd:a", std::make_shared<NSD>(system, "nsd:a"));
     server_manager->RegisterNamedService("nsd:u", std::make_shared<NSD>(system, "nsd:u"));
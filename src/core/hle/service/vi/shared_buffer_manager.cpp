@@ -406,7 +406,8 @@ Result SharedBufferManager::WriteAppletCaptureBuffer(bool* out_was_written, s32*
     // TODO: this could be optimized
     s64 e = -1280 * 768 * 4;
     for (auto& block : *m_buffer_page_group) {
-        u8* start = m_system.DeviceMemory().GetPointer<u8>(block.GetAddress());
+        u8* const begin = m_system.DeviceMemory().GetPointer<u8>(block.GetAddress());
+        u8* start = begin;
         u8* end = m_system.DeviceMemory().GetPointer<u8>(block.GetAddress() + block.GetSize());
 
         for (; start < end; start++) {
@@ -418,9 +419,9 @@ Result SharedBufferManager::WriteAppletCaptureBuffer(bool* out_was_written, s32*
             e++;
         }
 
-        m_system.GPU().Host1x().MemoryManager().ApplyOpOnPointer(start, scratch, [&](DAddr addr) {
-            m_system.GPU().InvalidateRegion(addr, end - start);
-        });
+        m_system.GPU().Host1x().MemoryManager().ApplyOpOnPointerRange(
+            begin, block.GetSize(), scratch,
+            [&](DAddr addr, size_t size) { m_system.GPU().InvalidateRegion(addr, size); });
     }
 
     *out_was_written = true;
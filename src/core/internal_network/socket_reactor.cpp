@@ -0,0 +1,257 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+
+#ifdef __linux__
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "core/internal_network/socket_reactor.h"
+#include "core/internal_network/sockets.h"
+
+namespace Network {
+
+#ifdef __linux__
+
+namespace {
+
+u32 TranslateToEpollEvents(PollEvents events) {
+    u32 result = 0;
+    if (True(events & (PollEvents::In | PollEvents::RdNorm))) {
+        result |= EPOLLIN;
+    }
+    if (True(events & (PollEvents::Pri | PollEvents::RdBand))) {
+        result |= EPOLLPRI;
+    }
+    if (True(events & (PollEvents::Out | PollEvents::WrBand))) {
+        result |= EPOLLOUT;
+    }
+    return result;
+}
+
+bool IsInterested(u32 epoll_events, PollEvents events) {
+    // Errors and hang ups complete every waiter, the retried operation will report them
+    if ((epoll_events & (EPOLLERR | EPOLLHUP)) != 0) {
+        return true;
+    }
+    return (epoll_events & TranslateToEpollEvents(events)) != 0;
+}
+
+Errno TranslateEpollError(int e) {
+    switch (e) {
+    case EBADF:
+        return Errno::BADF;
+    case EINVAL:
+    case EPERM:
+        return Errno::INVAL;
+    default:
+        LOG_ERROR(Network, "epoll error={} ({})", e, strerror(e));
+        return Errno::OTHER;
+    }
+}
+
+} // Anonymous namespace
+
+SocketReactor::SocketReactor() {
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    ASSERT_MSG(epoll_fd >= 0, "Failed to create socket reactor epoll instance");
+
+    wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    ASSERT_MSG(wakeup_fd >= 0, "Failed to create socket reactor wakeup event");
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wakeup_fd;
+    ASSERT(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &event) == 0);
+}
+
+SocketReactor::~SocketReactor() {
+    close(wakeup_fd);
+    close(epoll_fd);
+}
+
+bool SocketReactor::IsSupported() {
+    return true;
+}
+
+Errno SocketReactor::Arm(Token token, const SocketBase& socket, PollEvents events) {
+    const int fd = socket.GetFD();
+    if (fd < 0) {
+        return Errno::BADF;
+    }
+
+    std::scoped_lock lk{mutex};
+    auto& fd_interests = interests[fd];
+    const bool is_registered = !fd_interests.empty();
+    fd_interests.push_back(Interest{token, events});
+
+    const Errno result = UpdateRegistration(fd, is_registered);
+    if (result != Errno::SUCCESS) {
+        fd_interests.pop_back();
+        if (fd_interests.empty()) {
+            interests.erase(fd);
+        }
+        return result;
+    }
+
+    token_fds[token].push_back(fd);
+    return Errno::SUCCESS;
+}
+
+void SocketReactor::Disarm(Token token) {
+    std::scoped_lock lk{mutex};
+    const auto it = token_fds.find(token);
+    if (it == token_fds.end()) {
+        return;
+    }
+    for (const int fd : it->second) {
+        const auto fd_it = interests.find(fd);
+        if (fd_it == interests.end()) {
+            continue;
+        }
+        std::erase_if(fd_it->second, [token](const Interest& interest) {
+            return interest.token == token;
+        });
+        if (fd_it->second.empty()) {
+            interests.erase(fd_it);
+        }
+        UpdateRegistration(fd, true);
+    }
+    token_fds.erase(it);
+}
+
+void SocketReactor::Release(const SocketBase& socket) {
+    const int fd = socket.GetFD();
+    std::vector<Token> tokens;
+    {
+        std::scoped_lock lk{mutex};
+        const auto it = interests.find(fd);
+        if (it == interests.end()) {
+            return;
+        }
+        for (const Interest& interest : it->second) {
+            tokens.push_back(interest.token);
+        }
+    }
+    for (const Token token : tokens) {
+        Disarm(token);
+    }
+    {
+        std::scoped_lock lk{mutex};
+        released_tokens.insert(released_tokens.end(), tokens.begin(), tokens.end());
+    }
+    Interrupt();
+}
+
+void SocketReactor::Wait(std::vector<Token>& out_ready, s32 timeout) {
+    std::array<epoll_event, 64> events;
+    const int num_events = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()),
+                                      timeout);
+    if (num_events < 0 && errno != EINTR) {
+        LOG_ERROR(Network, "epoll_wait failed with error={} ({})", errno, strerror(errno));
+    }
+
+    std::vector<Token> ready;
+    {
+        std::scoped_lock lk{mutex};
+        ready = std::move(released_tokens);
+        released_tokens.clear();
+
+        for (int i = 0; i < num_events; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == wakeup_fd) {
+                u64 value;
+                [[maybe_unused]] const auto ret = read(wakeup_fd, &value, sizeof(value));
+                continue;
+            }
+            const auto it = interests.find(fd);
+            if (it == interests.end()) {
+                continue;
+            }
+            for (const Interest& interest : it->second) {
+                if (IsInterested(events[i].events, interest.events) &&
+                    std::find(ready.begin(), ready.end(), interest.token) == ready.end()) {
+                    ready.push_back(interest.token);
+                }
+            }
+        }
+    }
+
+    for (const Token token : ready) {
+        Disarm(token);
+    }
+    out_ready.insert(out_ready.end(), ready.begin(), ready.end());
+}
+
+void SocketReactor::Interrupt() {
+    const u64 value = 1;
+    [[maybe_unused]] const auto ret = write(wakeup_fd, &value, sizeof(value));
+}
+
+Errno SocketReactor::UpdateRegistration(int fd, bool is_registered) {
+    const auto it = interests.find(fd);
+    if (it == interests.end()) {
+        if (is_registered && epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr) != 0 &&
+            errno != EBADF && errno != ENOENT) {
+            return TranslateEpollError(errno);
+        }
+        return Errno::SUCCESS;
+    }
+
+    PollEvents combined{};
+    for (const Interest& interest : it->second) {
+        combined |= interest.events;
+    }
+
+    epoll_event event{};
+    event.events = TranslateToEpollEvents(combined);
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd, is_registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) != 0) {
+        // The host descriptor may have been closed and reused behind our back
+        if (is_registered && errno == ENOENT &&
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0) {
+            return Errno::SUCCESS;
+        }
+        return TranslateEpollError(errno);
+    }
+    return Errno::SUCCESS;
+}
+
+#else // ^^^ __linux__ ^^^ vvv !__linux__ vvv
+
+SocketReactor::SocketReactor() = default;
+
+SocketReactor::~SocketReactor() = default;
+
+bool SocketReactor::IsSupported() {
+    return false;
+}
+
+Errno SocketReactor::Arm(Token, const SocketBase&, PollEvents) {
+    UNIMPLEMENTED_MSG("Socket reactor is not supported on this platform");
+    return Errno::OTHER;
+}
+
+void SocketReactor::Disarm(Token) {}
+
+void SocketReactor::Release(const SocketBase&) {}
+
+void SocketReactor::Wait(std::vector<Token>&, s32) {}
+
+void SocketReactor::Interrupt() {}
+
+Errno SocketReactor::UpdateRegistration(int, bool) {
+    return Errno::OTHER;
+}
+
+#endif
+
+} // namespace Network
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/internal_network/network.h"
+
+namespace Network {
+
+class SocketBase;
+
+/**
+ * Readiness reactor over host sockets.
+ *
+ * Waiters register interest in a set of poll events on one or more sockets under an opaque token.
+ * Interest is one-shot: once any of the sockets armed under a token becomes ready, the token is
+ * reported by Wait and all of its registrations are dropped.
+ *
+ * On Linux this is backed by a single epoll instance. Other platforms report IsSupported() as
+ * false and callers are expected to keep using the blocking socket calls.
+ */
+class SocketReactor {
+public:
+    using Token = u64;
+
+    explicit SocketReactor();
+    ~SocketReactor();
+
+    SUYU_NON_COPYABLE(SocketReactor);
+    SUYU_NON_MOVEABLE(SocketReactor);
+
+    /// Returns true when the host platform has a reactor backend
+    [[nodiscard]] static bool IsSupported();
+
+    /// Registers one-shot interest in events on socket for token
+    Errno Arm(Token token, const SocketBase& socket, PollEvents events);
+
+    /// Drops every registration made under token
+    void Disarm(Token token);
+
+    /// Completes every waiter armed on socket, used before the socket is closed
+    void Release(const SocketBase& socket);
+
+    /**
+     * Waits up to timeout milliseconds (-1 for infinite) for armed sockets to become ready.
+     * Tokens that became ready are appended to out_ready and disarmed.
+     */
+    void Wait(std::vector<Token>& out_ready, s32 timeout);
+
+    /// Wakes up a thread blocked in Wait
+    void Interrupt();
+
+private:
+    struct Interest {
+        Token token;
+        PollEvents events;
+    };
+
+    /// Recomputes the host registration of fd from its interest list, must hold mutex
+    Errno UpdateRegistration(int fd, bool is_registered);
+
+    std::mutex mutex;
+    std::unordered_map<int, std::vector<Interest>> interests;
+    std::unordered_map<Token, std::vector<int>> token_fds;
+    std::vector<Token> released_tokens;
+
+    int epoll_fd = -1;
+    int wakeup_fd = -1;
+};
+
+} // namespace Network
@@ -351,6 +351,31 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    u8* GetWritableSpan(const Common::ProcessAddress dest_addr, const std::size_t size) {
+        // AARCH64 masks the upper 16 bit of all memory accesses
+        const u64 vaddr = GetInteger(dest_addr) & 0xffffffffffffULL;
+        if (size == 0 || !AddressSpaceContains(*current_page_table, vaddr, size)) {
+            return nullptr;
+        }
+
+        // Every page must be plain memory, rasterizer cached and debug pages have no pointer.
+        // Pages of one contiguous host allocation share the same pointer.
+        const auto& pointers = current_page_table->pointers;
+        const u64 first_page = vaddr >> SUYU_PAGEBITS;
+        const u64 last_page = (vaddr + size - 1) >> SUYU_PAGEBITS;
+        const uintptr_t pointer =
+            Common::PageTable::PageInfo::ExtractPointer(pointers[first_page].Raw());
+        if (pointer == 0) {
+            return nullptr;
+        }
+        for (u64 page = first_page + 1; page <= last_page; ++page) {
+            if (Common::PageTable::PageInfo::ExtractPointer(pointers[page].Raw()) != pointer) {
+                return nullptr;
+            }
+        }
+        return reinterpret_cast<u8*>(pointer + vaddr);
+    }
+
     template <bool UNSAFE>
     bool WriteBlockImpl(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
@@ -646,29 +671,15 @@ struct Memory::Impl {
             ASSERT_MSG(type != Common::PageType::Memory,
                        "Mapping memory page without a pointer @ {:016x}", base * SUYU_PAGESIZE);
 
-            while (base != end) {
-                page_table.pointers[base].Store(0, type);
-                page_table.backing_addr[base] = 0;
-                page_table.blocks[base] = 0;
-                base += 1;
-            }
+            page_table.UnmapRange(base, size, type);
         } else {
-            auto orig_base = base;
-            while (base != end) {
-                auto host_ptr =
-                    reinterpret_cast<uintptr_t>(system.DeviceMemory().GetPointer<u8>(target)) -
-                    (base << SUYU_PAGEBITS);
-                auto backing = GetInteger(target) - (base << SUYU_PAGEBITS);
-                page_table.pointers[base].Store(host_ptr, type);
-                page_table.backing_addr[base] = backing;
-                page_table.blocks[base] = orig_base << SUYU_PAGEBITS;
-
-                ASSERT_MSG(page_table.pointers[base].Pointer(),
-                           "memory mapping base yield a nullptr within the table");
-
-                base += 1;
-                target += SUYU_PAGESIZE;
-            }
+            // The range is backed by contiguous device memory, so every page stores the same
+            // relative pointer and backing address. Fill the entries in bulk.
+            const auto host_ptr =
+                reinterpret_cast<uintptr_t>(system.DeviceMemory().GetPointer<u8>(target));
+            ASSERT_MSG(host_ptr != 0, "memory mapping base yield a nullptr within the table");
+
+            page_table.MapRange(base, size, host_ptr, GetInteger(target), type);
         }
     }
 
@@ -871,8 +882,9 @@ struct Memory::Impl {
             }
         };
         auto& gpu = system.GPU();
-        gpu_device_memory->ApplyOpOnPointer(
-            p, scratch_buffers[core], [&](DAddr address) { gpu.InvalidateRegion(address, size); });
+        gpu_device_memory->ApplyOpOnPointerRange(
+            p, size, scratch_buffers[core],
+            [&](DAddr address, size_t range_size) { gpu.InvalidateRegion(address, range_size); });
     }
 
     Core::System& system;
@@ -1033,6 +1045,10 @@ u8* Memory::GetSpan(const VAddr src_addr, const std::size_t size) {
     return impl->GetSpan(src_addr, size);
 }
 
+u8* Memory::GetWritableSpan(const Common::ProcessAddress dest_addr, const std::size_t size) {
+    return impl->GetWritableSpan(dest_addr, size);
+}
+
 bool Memory::WriteBlock(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
     return impl->WriteBlock(dest_addr, src_buffer, size);
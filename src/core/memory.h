@@ -371,6 +371,18 @@ public:
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const VAddr src_addr, const std::size_t size);
 
+    /**
+     * Gets a host pointer through which a range of the current process' address space can be
+     * written directly, without going through WriteBlock.
+     *
+     * @param dest_addr The virtual address to start writing at.
+     * @param size      The size of the range in bytes.
+     *
+     * @returns A pointer to the host memory backing the range, or nullptr if the range is not
+     *          backed by contiguous host memory or any of its pages are cached by the rasterizer.
+     */
+    u8* GetWritableSpan(Common::ProcessAddress dest_addr, std::size_t size);
+
     /**
      * Writes a range of bytes into the current process' address space at the specified
      * virtual address.
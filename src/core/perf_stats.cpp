@@ -8,8 +8,10 @@
 #include <numeric>
 #include <sstream>
 #include <thread>
+#include <vector>
 #include <fmt/chrono.h>
 #include <fmt/format.h>
+#include "common/boot_trace.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
@@ -75,6 +77,12 @@ void PerfStats::EndSystemFrame() {
 
 void PerfStats::EndGameFrame() {
     game_frames.fetch_add(1, std::memory_order_relaxed);
+
+    // The boot is over once the title presents its first frame
+    if (Common::BootTrace::IsActive()) {
+        Common::BootTrace::Mark("FirstFrame");
+        Common::BootTrace::Finish();
+    }
 }
 
 double PerfStats::GetMeanFrametime() const {
@@ -89,6 +97,32 @@ double PerfStats::GetMeanFrametime() const {
     return sum / static_cast<double>(current_index - IgnoreFrames);
 }
 
+FrametimeSummary PerfStats::GetFrametimeSummary() const {
+    std::scoped_lock lock{object_mutex};
+
+    if (current_index <= IgnoreFrames) {
+        return {};
+    }
+
+    std::vector<double> frametimes(perf_history.begin() + IgnoreFrames,
+                                   perf_history.begin() + current_index);
+    std::sort(frametimes.begin(), frametimes.end());
+
+    const auto percentile = [&frametimes](double fraction) {
+        const auto index = static_cast<std::size_t>(fraction * (frametimes.size() - 1));
+        return frametimes[index];
+    };
+    const double sum = std::accumulate(frametimes.begin(), frametimes.end(), 0.0);
+
+    return {
+        .frames = frametimes.size(),
+        .mean = sum / static_cast<double>(frametimes.size()),
+        .median = percentile(0.5),
+        .p99 = percentile(0.99),
+        .max = frametimes.back(),
+    };
+}
+
 PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us) {
     std::scoped_lock lock{object_mutex};
 
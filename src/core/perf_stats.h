@@ -21,6 +21,27 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Average time from a host input event until the guest frame that read it, in seconds
+    double input_latency;
+    /// Ratio of RomFS reads served from the read-ahead cache
+    double romfs_prefetch_hit_rate;
+    /// RomFS bytes read ahead of the guest since the last query
+    u64 romfs_bytes_prefetched;
+    /// Shader cache lookups since the last query
+    u64 shader_lookups;
+    /// Shaders invalidated by guest writes, and writes to shader pages that missed every shader
+    u64 shader_invalidations;
+    u64 shader_false_invalidations;
+};
+
+struct FrametimeSummary {
+    /// Number of system frames summarised
+    std::size_t frames;
+    /// Frametime statistics, in milliseconds
+    double mean;
+    double median;
+    double p99;
+    double max;
 };
 
 /**
@@ -45,6 +66,11 @@ public:
      */
     double GetMeanFrametime() const;
 
+    /**
+     * Summarises the frametime distribution of the performance history, used by benchmark runs.
+     */
+    FrametimeSummary GetFrametimeSummary() const;
+
     /**
      * Gets the ratio between walltime and the emulated time of the previous system frame. This is
      * useful for scaling inputs or outputs moving between the two time domains.
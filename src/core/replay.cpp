@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "common/fs/file.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "core/replay.h"
+
+namespace Core {
+
+namespace {
+
+using namespace Common::Literals;
+
+constexpr u32 ReplayMagic = Common::MakeMagic('S', 'R', 'P', 'L');
+constexpr u32 ReplayVersion = 1;
+
+// Buffered records are written out once they grow past this size
+constexpr size_t RecordFlushThreshold = 1_MiB;
+
+struct ReplayHeader {
+    u32 magic;
+    u32 version;
+    u64 program_id;
+};
+static_assert(sizeof(ReplayHeader) == 0x10, "ReplayHeader has incorrect size.");
+
+struct RecordHeader {
+    u8 channel;
+    INSERT_PADDING_BYTES(3);
+    u32 size;
+};
+static_assert(sizeof(RecordHeader) == 0x8, "RecordHeader has incorrect size.");
+
+} // Anonymous namespace
+
+ReplaySession::ReplaySession() = default;
+
+ReplaySession::~ReplaySession() {
+    Stop();
+}
+
+bool ReplaySession::StartRecording(const std::filesystem::path& path) {
+    std::scoped_lock lk{mutex};
+
+    auto file = std::make_unique<Common::FS::IOFile>(path, Common::FS::FileAccessMode::Write,
+                                                     Common::FS::FileType::BinaryFile);
+    if (!file->IsOpen()) {
+        LOG_ERROR(Core, "Failed to create replay file {}", path.string());
+        return false;
+    }
+
+    LOG_INFO(Core, "Recording inputs to {}", path.string());
+    record_file = std::move(file);
+    record_buffer.clear();
+    is_header_written = false;
+    program_id = 0;
+    mode = Mode::Record;
+    return true;
+}
+
+bool ReplaySession::StartReplay(const std::filesystem::path& path) {
+    std::scoped_lock lk{mutex};
+
+    const Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                                  Common::FS::FileType::BinaryFile};
+    ReplayHeader header{};
+    if (!file.IsOpen() || !file.ReadObject(header) || header.magic != ReplayMagic ||
+        header.version != ReplayVersion) {
+        LOG_ERROR(Core, "Failed to load replay file {}", path.string());
+        return false;
+    }
+
+    for (auto& channel : replay_channels) {
+        channel.clear();
+    }
+
+    RecordHeader record{};
+    while (file.ReadObject(record)) {
+        std::vector<u8> payload(record.size);
+        if (file.ReadSpan<u8>(payload) != payload.size() ||
+            record.channel >= static_cast<u8>(Channel::Count)) {
+            LOG_ERROR(Core, "Replay file {} is truncated", path.string());
+            break;
+        }
+        replay_channels[record.channel].push_back(std::move(payload));
+    }
+
+    LOG_INFO(Core, "Replaying {} npad samples from {}",
+             replay_channels[static_cast<size_t>(Channel::Hid)].size(), path.string());
+    program_id = header.program_id;
+    has_desynced = false;
+    mode = Mode::Replay;
+    return true;
+}
+
+void ReplaySession::Stop() {
+    std::scoped_lock lk{mutex};
+    if (mode == Mode::Record) {
+        FlushRecording();
+        record_file.reset();
+    }
+    for (auto& channel : replay_channels) {
+        channel.clear();
+    }
+    mode = Mode::None;
+}
+
+u64 ReplaySession::GetProgramId() const {
+    std::scoped_lock lk{mutex};
+    return program_id;
+}
+
+void ReplaySession::SetProgramId(u64 program_id_) {
+    std::scoped_lock lk{mutex};
+    program_id = program_id_;
+}
+
+bool ReplaySession::IsReplayFinished() const {
+    std::scoped_lock lk{mutex};
+    return mode == Mode::Replay && replay_channels[static_cast<size_t>(Channel::Hid)].empty();
+}
+
+void ReplaySession::Record(Channel channel, std::span<const u8> payload) {
+    std::scoped_lock lk{mutex};
+    if (mode != Mode::Record) {
+        return;
+    }
+
+    const RecordHeader header{
+        .channel = static_cast<u8>(channel),
+        .size = static_cast<u32>(payload.size()),
+    };
+    const auto* header_bytes = reinterpret_cast<const u8*>(&header);
+    record_buffer.insert(record_buffer.end(), header_bytes, header_bytes + sizeof(header));
+    record_buffer.insert(record_buffer.end(), payload.begin(), payload.end());
+
+    if (record_buffer.size() >= RecordFlushThreshold) {
+        FlushRecording();
+    }
+}
+
+bool ReplaySession::Next(Channel channel, std::vector<u8>& out_payload) {
+    std::scoped_lock lk{mutex};
+    if (mode != Mode::Replay) {
+        return false;
+    }
+
+    auto& queue = replay_channels[static_cast<size_t>(channel)];
+    if (queue.empty()) {
+        if (!has_desynced && channel != Channel::Hid) {
+            LOG_ERROR(Core, "Replay ran out of recorded inputs on channel {}",
+                      static_cast<u32>(channel));
+            has_desynced = true;
+        }
+        return false;
+    }
+
+    out_payload = std::move(queue.front());
+    queue.pop_front();
+    return true;
+}
+
+void ReplaySession::FlushRecording() {
+    if (!record_file) {
+        return;
+    }
+    if (!is_header_written) {
+        // Records are only flushed once the title is running, so the program id is known here
+        const ReplayHeader header{
+            .magic = ReplayMagic,
+            .version = ReplayVersion,
+            .program_id = program_id,
+        };
+        if (!record_file->WriteObject(header)) {
+            LOG_ERROR(Core, "Failed to write replay file");
+        }
+        is_header_written = true;
+    }
+    if (record_file->WriteSpan<u8>(record_buffer) != record_buffer.size()) {
+        LOG_ERROR(Core, "Failed to write replay file");
+    }
+    record_buffer.clear();
+}
+
+} // namespace Core
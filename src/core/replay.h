@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+namespace Common::FS {
+class IOFile;
+}
+
+namespace Core {
+
+/**
+ * Records every external input the guest observes so a run can be reproduced.
+ *
+ * Each kind of input is kept in its own channel, consumed in the same order it was produced.
+ * Replays are only deterministic when both runs use single core mode, where guest time is
+ * derived from executed CPU ticks instead of the host clock.
+ */
+class ReplaySession {
+public:
+    enum class Mode : u32 {
+        None,
+        Record,
+        Replay,
+    };
+
+    enum class Channel : u8 {
+        /// Npad state read at every HID sample
+        Hid,
+        /// Host clock reads that seed guest visible time
+        Clock,
+        /// Results of host socket operations
+        Network,
+        Count,
+    };
+
+    explicit ReplaySession();
+    ~ReplaySession();
+
+    SUYU_NON_COPYABLE(ReplaySession);
+    SUYU_NON_MOVEABLE(ReplaySession);
+
+    /// Starts writing inputs to path, returns false if the file could not be created
+    bool StartRecording(const std::filesystem::path& path);
+
+    /// Loads the inputs recorded at path, returns false if the file is missing or invalid
+    bool StartReplay(const std::filesystem::path& path);
+
+    /// Flushes a recording to disk and returns to live input
+    void Stop();
+
+    [[nodiscard]] Mode GetMode() const {
+        return mode.load();
+    }
+
+    [[nodiscard]] bool IsRecording() const {
+        return mode == Mode::Record;
+    }
+
+    [[nodiscard]] bool IsReplaying() const {
+        return mode == Mode::Replay;
+    }
+
+    /// Returns true once a replay ran out of recorded npad samples
+    [[nodiscard]] bool IsReplayFinished() const;
+
+    /// Program id stored in the replay file
+    [[nodiscard]] u64 GetProgramId() const;
+
+    /// Sets the program id stored in a recording, the title is only known once it was loaded
+    void SetProgramId(u64 program_id_);
+
+    /// Appends payload to channel while recording
+    void Record(Channel channel, std::span<const u8> payload);
+
+    /// Pops the next payload of channel while replaying, returns false if there is none left
+    bool Next(Channel channel, std::vector<u8>& out_payload);
+
+    /// Records value, or replaces it with the recorded value when replaying
+    template <typename T>
+    void Process(Channel channel, T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (mode == Mode::Record) {
+            Record(channel, std::span{reinterpret_cast<const u8*>(&value), sizeof(T)});
+            return;
+        }
+        if (mode == Mode::Replay) {
+            std::vector<u8> payload;
+            if (Next(channel, payload) && payload.size() == sizeof(T)) {
+                std::memcpy(&value, payload.data(), sizeof(T));
+            }
+        }
+    }
+
+private:
+    void FlushRecording();
+
+    mutable std::mutex mutex;
+    std::atomic<Mode> mode{Mode::None};
+    u64 program_id{};
+
+    std::unique_ptr<Common::FS::IOFile> record_file;
+    std::vector<u8> record_buffer;
+    bool is_header_written{false};
+
+    std::array<std::deque<std::vector<u8>>, static_cast<size_t>(Channel::Count)> replay_channels;
+    bool has_desynced{false};
+};
+
+} // namespace Core
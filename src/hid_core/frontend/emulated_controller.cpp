@@ -813,6 +813,7 @@ void EmulatedController::SetButton(const Common::Input::CallbackStatus& callback
         controller.debug_pad_button_state.raw = 0;
         controller.home_button_state.raw = 0;
         controller.capture_button_state.raw = 0;
+        PublishNpadInputSnapshot();
         lock.unlock();
         TriggerOnChange(ControllerTriggerType::Button, false);
         return;
@@ -917,6 +918,7 @@ void EmulatedController::SetButton(const Common::Input::CallbackStatus& callback
         break;
     }
 
+    PublishNpadInputSnapshot();
     lock.unlock();
 
     if (player.connected) {
@@ -956,6 +958,7 @@ void EmulatedController::SetStick(const Common::Input::CallbackStatus& callback,
     if (is_configuring) {
         controller.analog_stick_state.left = {};
         controller.analog_stick_state.right = {};
+        PublishNpadInputSnapshot();
         return;
     }
 
@@ -980,6 +983,8 @@ void EmulatedController::SetStick(const Common::Input::CallbackStatus& callback,
         controller.npad_button_state.stick_r_down.Assign(controller.stick_values[index].down);
         break;
     }
+
+    PublishNpadInputSnapshot();
 }
 
 void EmulatedController::SetTrigger(const Common::Input::CallbackStatus& callback,
@@ -1006,6 +1011,7 @@ void EmulatedController::SetTrigger(const Common::Input::CallbackStatus& callbac
     if (is_configuring) {
         controller.gc_trigger_state.left = 0;
         controller.gc_trigger_state.right = 0;
+        PublishNpadInputSnapshot();
         return;
     }
 
@@ -1028,6 +1034,8 @@ void EmulatedController::SetTrigger(const Common::Input::CallbackStatus& callbac
         controller.npad_button_state.zr.Assign(trigger.pressed.value);
         break;
     }
+
+    PublishNpadInputSnapshot();
 }
 
 void EmulatedController::SetMotion(const Common::Input::CallbackStatus& callback,
@@ -1885,6 +1893,18 @@ DebugPadButton EmulatedController::GetDebugPadButtons() const {
     return controller.debug_pad_button_state;
 }
 
+NpadInputSnapshot EmulatedController::GetNpadInputSnapshot() const {
+    if (is_configuring) {
+        return {};
+    }
+
+    NpadInputSnapshot snapshot = npad_input_snapshot.Read();
+    if (turbo_button_state >= TURBO_BUTTON_DELAY) {
+        snapshot.npad_buttons.raw &= ~snapshot.turbo_buttons;
+    }
+    return snapshot;
+}
+
 AnalogSticks EmulatedController::GetSticks() const {
     std::scoped_lock lock{mutex};
 
@@ -1987,12 +2007,28 @@ void EmulatedController::StatusUpdate() {
     }
 }
 
+void EmulatedController::PublishNpadInputSnapshot() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    npad_input_snapshot.Write({
+        .npad_buttons = controller.npad_button_state,
+        .turbo_buttons = GetTurboButtons(),
+        .analog_sticks = controller.analog_stick_state,
+        .gc_triggers = controller.gc_trigger_state,
+        .event_timestamp_ns =
+            static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+    });
+}
+
 NpadButton EmulatedController::GetTurboButtonMask() const {
     // Apply no mask when disabled
     if (turbo_button_state < TURBO_BUTTON_DELAY) {
         return {NpadButton::All};
     }
 
+    return ~GetTurboButtons();
+}
+
+NpadButton EmulatedController::GetTurboButtons() const {
     NpadButtonState button_mask{};
     for (std::size_t index = 0; index < controller.button_values.size(); ++index) {
         if (!controller.button_values[index].turbo) {
@@ -2053,7 +2089,7 @@ NpadButton EmulatedController::GetTurboButtonMask() const {
         }
     }
 
-    return static_cast<NpadButton>(~button_mask.raw);
+    return button_mask.raw;
 }
 
 } // namespace Core::HID
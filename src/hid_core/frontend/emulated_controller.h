@@ -13,6 +13,7 @@
 #include "common/common_types.h"
 #include "common/input.h"
 #include "common/param_package.h"
+#include "common/seqlock.h"
 #include "common/settings.h"
 #include "common/vector_math.h"
 #include "hid_core/frontend/motion_input.h"
@@ -117,6 +118,17 @@ enum EmulatedDeviceIndex : u8 {
 
 using MotionState = std::array<ControllerMotion, 2>;
 
+// Fixed layout copy of the npad input, readable by HID without taking the controller mutex
+struct NpadInputSnapshot {
+    NpadButtonState npad_buttons{};
+    // Buttons with turbo enabled, masked out by the reader while turbo is in its off phase
+    NpadButton turbo_buttons{};
+    AnalogSticks analog_sticks{};
+    NpadGcTriggerState gc_triggers{};
+    // Host steady clock time of the driver event that produced this snapshot
+    u64 event_timestamp_ns{};
+};
+
 struct ControllerStatus {
     // Data from input_common
     ButtonValues button_values{};
@@ -331,6 +343,9 @@ public:
     /// Returns the latest status of button input for the debug pad service
     DebugPadButton GetDebugPadButtons() const;
 
+    /// Returns the latest npad buttons, sticks and triggers without blocking on input drivers
+    NpadInputSnapshot GetNpadInputSnapshot() const;
+
     /// Returns the latest status of stick input from the mouse
     AnalogSticks GetSticks() const;
 
@@ -568,7 +583,11 @@ private:
      */
     void TriggerOnChange(ControllerTriggerType type, bool is_service_update);
 
+    /// Copies the npad input state into npad_input_snapshot, must hold mutex
+    void PublishNpadInputSnapshot();
+
     NpadButton GetTurboButtonMask() const;
+    NpadButton GetTurboButtons() const;
 
     const NpadIdType npad_id_type;
     NpadStyleIndex npad_type{NpadStyleIndex::None};
@@ -635,6 +654,9 @@ private:
 
     // Stores the current status of all controller input
     ControllerStatus controller;
+
+    // Latest npad input published by the setters for lock-free readers
+    Common::SeqLock<NpadInputSnapshot> npad_input_snapshot;
 };
 
 } // namespace Core::HID
@@ -7,6 +7,7 @@
 #include "hid_core/frontend/emulated_devices.h"
 #include "hid_core/hid_core.h"
 #include "hid_core/hid_util.h"
+#include "hid_core/input_read_tracker.h"
 
 namespace Core::HID {
 
@@ -21,7 +22,8 @@ HIDCore::HIDCore()
       player_8{std::make_unique<EmulatedController>(NpadIdType::Player8)},
       other{std::make_unique<EmulatedController>(NpadIdType::Other)},
       handheld{std::make_unique<EmulatedController>(NpadIdType::Handheld)},
-      console{std::make_unique<EmulatedConsole>()}, devices{std::make_unique<EmulatedDevices>()} {}
+      console{std::make_unique<EmulatedConsole>()}, devices{std::make_unique<EmulatedDevices>()},
+      input_read_tracker{std::make_unique<InputReadTracker>()} {}
 
 HIDCore::~HIDCore() = default;
 
@@ -98,6 +100,14 @@ const EmulatedDevices* HIDCore::GetEmulatedDevices() const {
     return devices.get();
 }
 
+InputReadTracker& HIDCore::GetInputReadTracker() {
+    return *input_read_tracker;
+}
+
+const InputReadTracker& HIDCore::GetInputReadTracker() const {
+    return *input_read_tracker;
+}
+
 EmulatedController* HIDCore::GetEmulatedControllerByIndex(std::size_t index) {
     return GetEmulatedController(Service::HID::IndexToNpadIdType(index));
 }
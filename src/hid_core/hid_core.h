@@ -12,6 +12,7 @@ namespace Core::HID {
 class EmulatedConsole;
 class EmulatedController;
 class EmulatedDevices;
+class InputReadTracker;
 } // namespace Core::HID
 
 namespace Core::HID {
@@ -36,6 +37,9 @@ public:
     EmulatedDevices* GetEmulatedDevices();
     const EmulatedDevices* GetEmulatedDevices() const;
 
+    InputReadTracker& GetInputReadTracker();
+    const InputReadTracker& GetInputReadTracker() const;
+
     void SetSupportedStyleTag(NpadStyleTag style_tag);
     NpadStyleTag GetSupportedStyleTag() const;
 
@@ -82,6 +86,7 @@ private:
     std::unique_ptr<EmulatedController> handheld;
     std::unique_ptr<EmulatedConsole> console;
     std::unique_ptr<EmulatedDevices> devices;
+    std::unique_ptr<InputReadTracker> input_read_tracker;
     NpadStyleTag supported_style_tag{NpadStyleSet::All};
     NpadIdType last_active_controller{NpadIdType::Handheld};
 };
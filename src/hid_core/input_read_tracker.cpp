@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+
+#include "hid_core/input_read_tracker.h"
+
+namespace Core::HID {
+
+namespace {
+// Frames needed before the cadence is trusted
+constexpr u32 MinStableFrames = 8;
+// Frame periods outside this range are treated as loading screens or stalls
+constexpr s64 MinFramePeriodNs = 4'000'000;
+constexpr s64 MaxFramePeriodNs = 100'000'000;
+// Exponential moving average weight as a power of two
+constexpr s64 AverageShift = 3;
+} // Anonymous namespace
+
+void InputReadTracker::OnGuestFrame(s64 guest_time_ns) {
+    const auto host_now = std::chrono::steady_clock::now().time_since_epoch();
+    const u64 host_now_ns =
+        static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(host_now).count());
+
+    std::scoped_lock lock{mutex};
+
+    // Measure the first read of every new driver event
+    if (newest_written_event_ns != 0 && newest_written_event_ns != last_read_event_ns) {
+        const u64 latency_ns =
+            host_now_ns > newest_written_event_ns ? host_now_ns - newest_written_event_ns : 0;
+        last_read_event_ns = newest_written_event_ns;
+        latency.samples++;
+        latency.total_ns += latency_ns;
+        latency.max_ns = std::max(latency.max_ns, latency_ns);
+    }
+
+    const s64 period_ns = guest_time_ns - last_frame_ns;
+    last_frame_ns = guest_time_ns;
+    if (period_ns < MinFramePeriodNs || period_ns > MaxFramePeriodNs) {
+        stable_frames = 0;
+        frame_period_ns = 0;
+        frame_deviation_ns = 0;
+        return;
+    }
+    if (frame_period_ns == 0) {
+        frame_period_ns = period_ns;
+        return;
+    }
+
+    const s64 deviation_ns = std::abs(period_ns - frame_period_ns);
+    frame_period_ns += (period_ns - frame_period_ns) >> AverageShift;
+    frame_deviation_ns += (deviation_ns - frame_deviation_ns) >> AverageShift;
+
+    // A frame far off the average breaks the cadence, start learning again
+    if (deviation_ns > frame_period_ns / 4) {
+        stable_frames = 0;
+        return;
+    }
+    stable_frames = std::min(stable_frames + 1, MinStableFrames);
+}
+
+void InputReadTracker::OnSampleWritten(u64 event_timestamp_ns) {
+    std::scoped_lock lock{mutex};
+    newest_written_event_ns = std::max(newest_written_event_ns, event_timestamp_ns);
+}
+
+std::optional<s64> InputReadTracker::PredictNextRead(s64 guest_time_ns) const {
+    std::scoped_lock lock{mutex};
+    if (stable_frames < MinStableFrames || frame_deviation_ns > frame_period_ns / 8) {
+        return std::nullopt;
+    }
+
+    // Skip over frames the guest may have dropped since the last boundary
+    const s64 elapsed_ns = std::max<s64>(guest_time_ns - last_frame_ns, 0);
+    const s64 frames_ahead = elapsed_ns / frame_period_ns + 1;
+    return last_frame_ns + frames_ahead * frame_period_ns;
+}
+
+void InputReadTracker::Reset() {
+    std::scoped_lock lock{mutex};
+    last_frame_ns = 0;
+    frame_period_ns = 0;
+    frame_deviation_ns = 0;
+    stable_frames = 0;
+}
+
+InputReadTracker::LatencyStats InputReadTracker::GetAndResetLatencyStats() {
+    std::scoped_lock lock{mutex};
+    return std::exchange(latency, {});
+}
+
+} // namespace Core::HID
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+
+#include "common/common_types.h"
+
+namespace Core::HID {
+
+/**
+ * Learns when the guest is expected to read the HID shared memory.
+ *
+ * Games read the npad LIFOs directly from shared memory, which can't be observed. Most of them
+ * poll input once per frame right after acquiring the next framebuffer, so the cadence of those
+ * frame boundaries is used as the read signal. Once the cadence has been stable for a few frames
+ * HID can sample input just before the predicted read instead of on every polling period.
+ */
+class InputReadTracker {
+public:
+    struct LatencyStats {
+        u64 samples;
+        u64 total_ns;
+        u64 max_ns;
+    };
+
+    /// Called when the guest starts a new frame, guest_time_ns is the CoreTiming time
+    void OnGuestFrame(s64 guest_time_ns);
+
+    /// Called after a sample carrying a driver event at event_timestamp_ns was written
+    void OnSampleWritten(u64 event_timestamp_ns);
+
+    /// Returns the CoreTiming time of the next expected read, if the frame cadence is stable
+    std::optional<s64> PredictNextRead(s64 guest_time_ns) const;
+
+    /// Forgets the learned cadence, used when a new title is started
+    void Reset();
+
+    /// Time from a driver input event until the guest frame that read it, since the last call
+    LatencyStats GetAndResetLatencyStats();
+
+private:
+    mutable std::mutex mutex;
+
+    s64 last_frame_ns{};
+    s64 frame_period_ns{};
+    s64 frame_deviation_ns{};
+    u32 stable_frames{};
+
+    u64 newest_written_event_ns{};
+    u64 last_read_event_ns{};
+    LatencyStats latency{};
+};
+
+} // namespace Core::HID
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/service/ipc_helpers.h"
@@ -9,6 +10,7 @@
 #include "core/hle/service/sm/sm.h"
 #include "hid_core/hid_core.h"
 #include "hid_core/hid_util.h"
+#include "hid_core/input_read_tracker.h"
 #include "hid_core/resource_manager.h"
 
 #include "hid_core/resources/applet_resource.h"
@@ -47,6 +49,11 @@ constexpr auto default_update_ns = std::chrono::nanoseconds{4 * 1000 * 1000}; //
 constexpr auto mouse_keyboard_update_ns = std::chrono::nanoseconds{8 * 1000 * 1000}; // (8ms, 125Hz)
 constexpr auto motion_update_ns = std::chrono::nanoseconds{5 * 1000 * 1000};         // (5ms, 200Hz)
 
+// With just in time sampling the periodic npad update falls back to the hardware rate and the
+// sample the guest reads is taken this long before the predicted read.
+constexpr auto npad_jit_update_ns = std::chrono::nanoseconds{4 * 1000 * 1000}; // (4ms, 250Hz)
+constexpr auto npad_jit_lead_ns = std::chrono::nanoseconds{500 * 1000};        // (0.5ms)
+
 ResourceManager::ResourceManager(Core::System& system_,
                                  std::shared_ptr<HidFirmwareSettings> settings)
     : firmware_settings{settings}, system{system_}, service_context{system_, "hid"} {
@@ -59,6 +66,13 @@ ResourceManager::ResourceManager(Core::System& system_,
                                                       UpdateNpad(ns_late);
                                                       return std::nullopt;
                                                   });
+    npad_jit_update_event = Core::Timing::CreateEvent(
+        "HID::UpdatePadJitCallback",
+        [this](s64 time,
+               std::chrono::nanoseconds ns_late) -> std::optional<std::chrono::nanoseconds> {
+            UpdateNpadJustInTime(ns_late);
+            return std::nullopt;
+        });
     default_update_event = Core::Timing::CreateEvent(
         "HID::UpdateDefaultCallback",
         [this](s64 time,
@@ -84,6 +98,7 @@ ResourceManager::ResourceManager(Core::System& system_,
 
 ResourceManager::~ResourceManager() {
     system.CoreTiming().UnscheduleEvent(npad_update_event);
+    system.CoreTiming().UnscheduleEvent(npad_jit_update_event);
     system.CoreTiming().UnscheduleEvent(default_update_event);
     system.CoreTiming().UnscheduleEvent(mouse_keyboard_update_event);
     system.CoreTiming().UnscheduleEvent(motion_update_event);
@@ -97,6 +112,7 @@ void ResourceManager::Initialize() {
     }
 
     system.HIDCore().ReloadInputDevices();
+    system.HIDCore().GetInputReadTracker().Reset();
 
     input_event = service_context.CreateEvent("ResourceManager:InputEvent");
 
@@ -240,6 +256,7 @@ void ResourceManager::InitializeHidCommonSampler() {
         system.ServiceManager().GetService<Service::Set::ISystemSettingsServer>("set:sys", true);
     npad->SetNpadExternals(applet_resource, &shared_mutex, handheld_config, input_event,
                            &input_mutex, settings);
+    npad->SetReplaySession(&system.GetReplaySession());
 
     six_axis->SetAppletResource(applet_resource, &shared_mutex);
     mouse->SetAppletResource(applet_resource, &shared_mutex);
@@ -483,9 +500,46 @@ void ResourceManager::UpdateControllers(std::chrono::nanoseconds ns_late) {
 
 void ResourceManager::UpdateNpad(std::chrono::nanoseconds ns_late) {
     auto& core_timing = system.CoreTiming();
+    const s64 now_ns = core_timing.GetGlobalTimeNs().count();
+
+    if (Settings::values.hid_jit_sampling.GetValue()) {
+        const auto next_read_ns =
+            system.HIDCore().GetInputReadTracker().PredictNextRead(now_ns);
+        if (next_read_ns) {
+            ScheduleNpadJustInTime(now_ns, *next_read_ns);
+
+            // The read is covered by the just in time sample, coalesce the periodic ones down to
+            // the hardware rate so the LIFOs keep advancing
+            if (now_ns - last_npad_update_ns < npad_jit_update_ns.count()) {
+                return;
+            }
+        }
+    }
+
+    last_npad_update_ns = now_ns;
+    npad->OnUpdate(core_timing);
+}
+
+void ResourceManager::UpdateNpadJustInTime(std::chrono::nanoseconds ns_late) {
+    auto& core_timing = system.CoreTiming();
+    last_npad_update_ns = core_timing.GetGlobalTimeNs().count();
     npad->OnUpdate(core_timing);
 }
 
+void ResourceManager::ScheduleNpadJustInTime(s64 now_ns, s64 next_read_ns) {
+    const s64 sample_ns = next_read_ns - npad_jit_lead_ns.count();
+
+    // Only schedule once per read, and only when the next periodic update would be too early
+    if (next_read_ns == scheduled_npad_read_ns || sample_ns <= now_ns ||
+        sample_ns > now_ns + npad_update_ns.count()) {
+        return;
+    }
+
+    scheduled_npad_read_ns = next_read_ns;
+    system.CoreTiming().ScheduleEvent(std::chrono::nanoseconds{sample_ns - now_ns},
+                                      npad_jit_update_event);
+}
+
 void ResourceManager::UpdateMouseKeyboard(std::chrono::nanoseconds ns_late) {
     auto& core_timing = system.CoreTiming();
     mouse->OnUpdate(core_timing);
@@ -111,6 +111,7 @@ public:
 
     void UpdateControllers(std::chrono::nanoseconds ns_late);
     void UpdateNpad(std::chrono::nanoseconds ns_late);
+    void UpdateNpadJustInTime(std::chrono::nanoseconds ns_late);
     void UpdateMouseKeyboard(std::chrono::nanoseconds ns_late);
     void UpdateMotion(std::chrono::nanoseconds ns_late);
 
@@ -121,6 +122,7 @@ private:
     void InitializeTouchScreenSampler();
     void InitializeConsoleSixAxisSampler();
     void InitializeAHidSampler();
+    void ScheduleNpadJustInTime(s64 now_ns, s64 next_read_ns);
 
     bool is_initialized{false};
 
@@ -148,10 +150,15 @@ private:
     std::shared_ptr<SleepButton> sleep_button{nullptr};
     std::shared_ptr<UniquePad> unique_pad{nullptr};
     std::shared_ptr<Core::Timing::EventType> npad_update_event;
+    std::shared_ptr<Core::Timing::EventType> npad_jit_update_event;
     std::shared_ptr<Core::Timing::EventType> default_update_event;
     std::shared_ptr<Core::Timing::EventType> mouse_keyboard_update_event;
     std::shared_ptr<Core::Timing::EventType> motion_update_event;
 
+    // Just in time npad sampling state, only touched from CoreTiming callbacks
+    s64 last_npad_update_ns{};
+    s64 scheduled_npad_read_ns{};
+
     // TODO: Create these resources
     // std::shared_ptr<AudioControl> audio_control{nullptr};
     // std::shared_ptr<ButtonConfig> button_config{nullptr};
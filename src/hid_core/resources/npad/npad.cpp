@@ -11,6 +11,7 @@
 #include "common/logging/log.h"
 #include "common/settings.h"
 #include "core/core_timing.h"
+#include "core/replay.h"
 #include "core/hle/kernel/k_event.h"
 #include "core/hle/kernel/k_readable_event.h"
 #include "core/hle/service/kernel_helpers.h"
@@ -18,6 +19,7 @@
 #include "hid_core/hid_core.h"
 #include "hid_core/hid_result.h"
 #include "hid_core/hid_util.h"
+#include "hid_core/input_read_tracker.h"
 #include "hid_core/resources/applet_resource.h"
 #include "hid_core/resources/npad/npad.h"
 #include "hid_core/resources/npad/npad_vibration.h"
@@ -410,8 +412,18 @@ void NPad::RequestPadStateUpdate(u64 aruid, Core::HID::NpadIdType npad_id) {
 
     auto& pad_entry = controller.npad_pad_state;
     auto& trigger_entry = controller.npad_trigger_state;
-    const auto button_state = controller.device->GetNpadButtons();
-    const auto stick_state = controller.device->GetSticks();
+    // Read the published snapshot so sampling never waits on the input drivers
+    auto input_snapshot = controller.device->GetNpadInputSnapshot();
+    if (replay_session != nullptr && replay_session->GetMode() != Core::ReplaySession::Mode::None) {
+        replay_session->Process(Core::ReplaySession::Channel::Hid, input_snapshot);
+        if (replay_session->IsReplaying()) {
+            // Host timestamps of the recording are meaningless for this run's latency stats
+            input_snapshot.event_timestamp_ns = 0;
+        }
+    }
+    const auto& button_state = input_snapshot.npad_buttons;
+    const auto& stick_state = input_snapshot.analog_sticks;
+    controller.pending_event_timestamp_ns = input_snapshot.event_timestamp_ns;
 
     using btn = Core::HID::NpadButton;
     pad_entry.npad_buttons.raw = btn::None;
@@ -444,7 +456,7 @@ void NPad::RequestPadStateUpdate(u64 aruid, Core::HID::NpadIdType npad_id) {
     }
 
     if (controller_type == Core::HID::NpadStyleIndex::GameCube) {
-        const auto& trigger_state = controller.device->GetTriggers();
+        const auto& trigger_state = input_snapshot.gc_triggers;
         trigger_entry.l_analog = trigger_state.left;
         trigger_entry.r_analog = trigger_state.right;
         pad_entry.npad_buttons.zl.Assign(false);
@@ -613,10 +625,21 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
             npad->system_ext_lifo.WriteNextEntry(libnx_state);
 
             press_state |= static_cast<u64>(pad_state.npad_buttons.raw);
+            NotifySampleWritten(controller);
         }
     }
 }
 
+void NPad::NotifySampleWritten(NpadControllerData& controller) {
+    // Only report the first shared memory write after each driver event
+    const u64 event_timestamp_ns = controller.pending_event_timestamp_ns;
+    if (event_timestamp_ns == 0 || event_timestamp_ns == controller.last_event_timestamp_ns) {
+        return;
+    }
+    controller.last_event_timestamp_ns = event_timestamp_ns;
+    hid_core.GetInputReadTracker().OnSampleWritten(event_timestamp_ns);
+}
+
 Result NPad::SetSupportedNpadStyleSet(u64 aruid, Core::HID::NpadStyleSet supported_style_set) {
     std::scoped_lock lock{mutex};
     hid_core.SetSupportedStyleTag({supported_style_set});
@@ -1241,6 +1264,10 @@ Result NPad::GetLastActiveNpad(Core::HID::NpadIdType& out_npad_id) const {
     return ResultSuccess;
 }
 
+void NPad::SetReplaySession(Core::ReplaySession* replay_session_) {
+    replay_session = replay_session_;
+}
+
 NpadVibration* NPad::GetVibrationHandler() {
     return &vibration_handler;
 }
@@ -20,6 +20,10 @@
 #include "hid_core/resources/vibration/vibration_base.h"
 #include "hid_core/resources/vibration/vibration_device.h"
 
+namespace Core {
+class ReplaySession;
+}
+
 namespace Core::HID {
 class EmulatedController;
 enum class ControllerTriggerType;
@@ -136,6 +140,9 @@ public:
                           Kernel::KEvent* input_event, std::mutex* input_mutex,
                           std::shared_ptr<Service::Set::ISystemSettingsServer> settings);
 
+    // Npad samples are recorded to or replaced from this session when it is active
+    void SetReplaySession(Core::ReplaySession* replay_session_);
+
     AppletDetailedUiType GetAppletDetailedUiType(Core::HID::NpadIdType npad_id);
 
     Result SetNpadCaptureButtonAssignment(u64 aruid, Core::HID::NpadStyleSet npad_style_set,
@@ -178,12 +185,17 @@ private:
         NPadGenericState npad_libnx_state{};
         NpadGcTriggerState npad_trigger_state{};
         int callback_key{};
+
+        // Driver event timestamps reported to the InputReadTracker latency stats
+        u64 pending_event_timestamp_ns{};
+        u64 last_event_timestamp_ns{};
     };
 
     void ControllerUpdate(Core::HID::ControllerTriggerType type, std::size_t controller_idx);
     void InitNewlyAddedController(u64 aruid, Core::HID::NpadIdType npad_id);
     void RequestPadStateUpdate(u64 aruid, Core::HID::NpadIdType npad_id);
     void WriteEmptyEntry(NpadInternalState* npad);
+    void NotifySampleWritten(NpadControllerData& controller);
 
     NpadControllerData& GetControllerFromHandle(
         u64 aruid, const Core::HID::SixAxisSensorHandle& device_handle);
@@ -208,6 +220,7 @@ private:
     std::array<AbstractPad, MaxSupportedNpadIdTypes> abstracted_pads;
     NpadVibration vibration_handler{};
 
+    Core::ReplaySession* replay_session{nullptr};
     std::atomic<u64> press_state{};
     std::array<std::array<NpadControllerData, MaxSupportedNpadIdTypes>, AruidIndexMax>
         controller_data{};
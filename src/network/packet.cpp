@@ -24,29 +24,37 @@ static u64 ntohll(u64 x) {
 }
 #endif
 
+Packet::Packet(std::span<const u8> view_)
+    : view{reinterpret_cast<const char*>(view_.data()), view_.size()} {}
+
 void Packet::Append(const void* in_data, std::size_t size_in_bytes) {
+    if (!view.empty()) {
+        data.assign(view.begin(), view.end());
+        view = {};
+    }
     if (in_data && (size_in_bytes > 0)) {
-        std::size_t start = data.size();
-        data.resize(start + size_in_bytes);
-        std::memcpy(&data[start], in_data, size_in_bytes);
+        const auto* bytes = static_cast<const char*>(in_data);
+        data.insert(data.end(), bytes, bytes + size_in_bytes);
     }
 }
 
 void Packet::Read(void* out_data, std::size_t size_in_bytes) {
     if (out_data && CheckSize(size_in_bytes)) {
-        std::memcpy(out_data, &data[read_pos], size_in_bytes);
+        std::memcpy(out_data, GetContents().data() + read_pos, size_in_bytes);
         read_pos += size_in_bytes;
     }
 }
 
 void Packet::Clear() {
     data.clear();
+    view = {};
     read_pos = 0;
     is_valid = true;
 }
 
 const void* Packet::GetData() const {
-    return !data.empty() ? &data[0] : nullptr;
+    const auto contents = GetContents();
+    return !contents.empty() ? contents.data() : nullptr;
 }
 
 void Packet::IgnoreBytes(u32 length) {
@@ -54,11 +62,11 @@ void Packet::IgnoreBytes(u32 length) {
 }
 
 std::size_t Packet::GetDataSize() const {
-    return data.size();
+    return GetContents().size();
 }
 
 bool Packet::EndOfPacket() const {
-    return read_pos >= data.size();
+    return read_pos >= GetContents().size();
 }
 
 Packet::operator bool() const {
@@ -142,7 +150,7 @@ Packet& Packet::Read(char* out_data) {
 
     if ((length > 0) && CheckSize(length)) {
         // Then extract characters
-        std::memcpy(out_data, &data[read_pos], length);
+        std::memcpy(out_data, GetContents().data() + read_pos, length);
         out_data[length] = '\0';
 
         // Update reading position
@@ -160,7 +168,7 @@ Packet& Packet::Read(std::string& out_data) {
     out_data.clear();
     if ((length > 0) && CheckSize(length)) {
         // Then extract characters
-        out_data.assign(&data[read_pos], length);
+        out_data.assign(GetContents().data() + read_pos, length);
 
         // Update reading position
         read_pos += length;
@@ -253,8 +261,15 @@ Packet& Packet::Write(const std::string& in_data) {
     return *this;
 }
 
+std::span<const char> Packet::GetContents() const {
+    if (!view.empty()) {
+        return view;
+    }
+    return data;
+}
+
 bool Packet::CheckSize(std::size_t size) {
-    is_valid = is_valid && (read_pos + size <= data.size());
+    is_valid = is_valid && (read_pos + size <= GetContents().size());
 
     return is_valid;
 }
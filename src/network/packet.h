@@ -4,17 +4,28 @@
 #pragma once
 
 #include <array>
+#include <span>
+#include <type_traits>
 #include <vector>
 #include "common/common_types.h"
 
 namespace Network {
 
+class PacketPool;
+
 /// A class that serializes data for network transfer. It also handles endianness
 class Packet {
 public:
     Packet() = default;
     ~Packet() = default;
 
+    /**
+     * Creates a packet that reads the given bytes in place instead of copying them.
+     * The bytes must outlive the packet, appending to it copies them first.
+     * @param view Bytes to read, usually the data of a received ENetPacket
+     */
+    explicit Packet(std::span<const u8> view);
+
     /**
      * Append data to the end of the packet
      * @param data        Pointer to the sequence of bytes to append
@@ -102,6 +113,11 @@ public:
     Packet& Write(const std::array<T, S>& data);
 
 private:
+    friend class PacketPool;
+
+    /// Returns the bytes the packet reads from, either the view or the owned data
+    std::span<const char> GetContents() const;
+
     /**
      * Check if the packet can extract a given number of bytes
      * This function updates accordingly the state of the packet.
@@ -110,10 +126,16 @@ private:
      */
     bool CheckSize(std::size_t size);
 
+    /// Single byte values need no byte order conversion and are copied in bulk
+    template <typename T>
+    static constexpr bool IsByte =
+        sizeof(T) == 1 && std::is_trivially_copyable_v<T> && !std::is_same_v<T, bool>;
+
     // Member data
-    std::vector<char> data;   ///< Data stored in the packet
-    std::size_t read_pos = 0; ///< Current reading position in the packet
-    bool is_valid = true;     ///< Reading state of the packet
+    std::vector<char> data;     ///< Data stored in the packet
+    std::span<const char> view; ///< Data read in place, if the packet was created from a view
+    std::size_t read_pos = 0;   ///< Current reading position in the packet
+    bool is_valid = true;       ///< Reading state of the packet
 };
 
 template <typename T>
@@ -121,6 +143,17 @@ Packet& Packet::Read(std::vector<T>& out_data) {
     // First extract the size
     u32 size = 0;
     Read(size);
+
+    // Bytes need no conversion, so they are copied at once
+    if constexpr (IsByte<T>) {
+        if (!CheckSize(size)) {
+            out_data.clear();
+            return *this;
+        }
+        out_data.resize(size);
+        Read(out_data.data(), size);
+        return *this;
+    }
     out_data.resize(size);
 
     // Then extract the data
@@ -134,6 +167,10 @@ Packet& Packet::Read(std::vector<T>& out_data) {
 
 template <typename T, std::size_t S>
 Packet& Packet::Read(std::array<T, S>& out_data) {
+    if constexpr (IsByte<T>) {
+        Read(out_data.data(), S);
+        return *this;
+    }
     for (std::size_t i = 0; i < out_data.size(); ++i) {
         T character;
         Read(character);
@@ -147,6 +184,11 @@ Packet& Packet::Write(const std::vector<T>& in_data) {
     // First insert the size
     Write(static_cast<u32>(in_data.size()));
 
+    if constexpr (IsByte<T>) {
+        Append(in_data.data(), in_data.size());
+        return *this;
+    }
+
     // Then insert the data
     for (std::size_t i = 0; i < in_data.size(); ++i) {
         Write(in_data[i]);
@@ -156,6 +198,10 @@ Packet& Packet::Write(const std::vector<T>& in_data) {
 
 template <typename T, std::size_t S>
 Packet& Packet::Write(const std::array<T, S>& in_data) {
+    if constexpr (IsByte<T>) {
+        Append(in_data.data(), S);
+        return *this;
+    }
     for (std::size_t i = 0; i < in_data.size(); ++i) {
         Write(in_data[i]);
     }
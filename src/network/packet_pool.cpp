@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "common/literals.h"
+#include "enet/enet.h"
+#include "network/packet_pool.h"
+
+namespace Network {
+
+namespace {
+
+using namespace Common::Literals;
+
+// Buffers past this count are freed instead of being pooled
+constexpr std::size_t MaxPooledBuffers = 256;
+
+// Buffers grown by a rare large message are not worth keeping around
+constexpr std::size_t MaxPooledCapacity = 64_KiB;
+
+} // Anonymous namespace
+
+PacketPool::PacketPool() = default;
+
+PacketPool& PacketPool::Instance() {
+    // Never destroyed, ENet may still free packets while static objects are being destroyed
+    static PacketPool* const instance = new PacketPool;
+    return *instance;
+}
+
+Packet PacketPool::Acquire() {
+    Packet packet;
+    std::scoped_lock lk{mutex};
+    if (!free_buffers.empty()) {
+        packet.data = std::move(free_buffers.back());
+        free_buffers.pop_back();
+    }
+    return packet;
+}
+
+void PacketPool::Release(Packet&& packet) {
+    ReleaseBuffer(std::move(packet.data));
+    packet.Clear();
+}
+
+ENetPacket* PacketPool::CreateENetPacket(Packet&& packet, u32 flags) {
+    // The bytes behind a view are not owned by the packet, so they still have to be copied
+    if (!packet.view.empty()) {
+        ENetPacket* enet_packet =
+            enet_packet_create(packet.view.data(), packet.view.size(), flags);
+        packet.Clear();
+        return enet_packet;
+    }
+
+    std::unique_ptr<Buffer> slot;
+    {
+        std::scoped_lock lk{mutex};
+        if (!free_slots.empty()) {
+            slot = std::move(free_slots.back());
+            free_slots.pop_back();
+        }
+    }
+    if (!slot) {
+        slot = std::make_unique<Buffer>();
+    }
+    *slot = std::move(packet.data);
+    packet.Clear();
+
+    ENetPacket* enet_packet =
+        enet_packet_create(slot->data(), slot->size(), flags | ENET_PACKET_FLAG_NO_ALLOCATE);
+    if (enet_packet == nullptr) {
+        ReleaseBuffer(std::move(*slot));
+        return nullptr;
+    }
+    enet_packet->freeCallback = &PacketPool::FreeENetPacket;
+    enet_packet->userData = slot.release();
+    return enet_packet;
+}
+
+std::size_t PacketPool::GetFreeBufferCount() const {
+    std::scoped_lock lk{mutex};
+    return free_buffers.size();
+}
+
+void PacketPool::FreeENetPacket(ENetPacket* enet_packet) {
+    std::unique_ptr<Buffer> slot{static_cast<Buffer*>(enet_packet->userData)};
+    enet_packet->userData = nullptr;
+
+    auto& pool = Instance();
+    pool.ReleaseBuffer(std::move(*slot));
+    std::scoped_lock lk{pool.mutex};
+    if (pool.free_slots.size() < MaxPooledBuffers) {
+        pool.free_slots.push_back(std::move(slot));
+    }
+}
+
+void PacketPool::ReleaseBuffer(Buffer buffer) {
+    if (buffer.capacity() == 0 || buffer.capacity() > MaxPooledCapacity) {
+        return;
+    }
+    buffer.clear();
+    std::scoped_lock lk{mutex};
+    if (free_buffers.size() < MaxPooledBuffers) {
+        free_buffers.push_back(std::move(buffer));
+    }
+}
+
+} // namespace Network
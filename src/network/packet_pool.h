@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "common/common_types.h"
+#include "network/packet.h"
+
+typedef struct _ENetPacket ENetPacket;
+
+namespace Network {
+
+/**
+ * Recycles packet buffers, so building and sending a message does not allocate once the pool is
+ * warm. Packets are handed to ENet without copying and their buffer returns to the pool once ENet
+ * has delivered them.
+ */
+class PacketPool {
+public:
+    static PacketPool& Instance();
+
+    /// Returns an empty packet backed by a recycled buffer
+    [[nodiscard]] Packet Acquire();
+
+    /// Returns the buffer of a packet that is not going to be sent to the pool
+    void Release(Packet&& packet);
+
+    /**
+     * Wraps the contents of a packet in an ENetPacket without copying them
+     * @param packet Packet to send, its buffer is owned by ENet until the ENetPacket is destroyed
+     * @param flags ENet packet flags
+     */
+    [[nodiscard]] ENetPacket* CreateENetPacket(Packet&& packet, u32 flags);
+
+    /// Number of buffers ready to be acquired
+    [[nodiscard]] std::size_t GetFreeBufferCount() const;
+
+private:
+    using Buffer = std::vector<char>;
+
+    PacketPool();
+
+    static void FreeENetPacket(ENetPacket* enet_packet);
+
+    void ReleaseBuffer(Buffer buffer);
+
+    mutable std::mutex mutex;
+    std::vector<Buffer> free_buffers;
+
+    /// Heap slots that keep a buffer alive while ENet owns it, recycled as well
+    std::vector<std::unique_ptr<Buffer>> free_slots;
+};
+
+} // namespace Network
@@ -243,6 +243,9 @@ void Room::RoomImpl::ServerLoop() {
         if (enet_host_service(server, &event, 5) > 0) {
             switch (event.type) {
             case ENET_EVENT_TYPE_RECEIVE:
+                // Handlers may forward the packet itself. Hold a reference while they run, so ENet
+                // doesn't free an unreliable packet as soon as it is flushed to the other members.
+                ++event.packet->referenceCount;
                 switch (event.packet->data[0]) {
                 case IdJoinRequest:
                     HandleJoinRequest(&event);
@@ -273,7 +276,10 @@ void Room::RoomImpl::ServerLoop() {
                     HandleModGetBanListPacket(&event);
                     break;
                 }
-                enet_packet_destroy(event.packet);
+                // Forwarded packets are referenced by their peers and freed by ENet once sent
+                if (--event.packet->referenceCount == 0) {
+                    enet_packet_destroy(event.packet);
+                }
                 break;
             case ENET_EVENT_TYPE_DISCONNECT:
                 HandleClientDisconnection(event.peer);
@@ -300,8 +306,7 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
             return;
         }
     }
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     std::string nickname;
     packet.Read(nickname);
@@ -404,8 +409,7 @@ void Room::RoomImpl::HandleModKickPacket(const ENetEvent* event) {
         return;
     }
 
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
 
     std::string nickname;
@@ -446,8 +450,7 @@ void Room::RoomImpl::HandleModBanPacket(const ENetEvent* event) {
         return;
     }
 
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
 
     std::string nickname;
@@ -507,8 +510,7 @@ void Room::RoomImpl::HandleModUnbanPacket(const ENetEvent* event) {
         return;
     }
 
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
 
     std::string address;
@@ -813,8 +815,7 @@ IPv4Address Room::RoomImpl::GenerateFakeIPAddress() {
 }
 
 void Room::RoomImpl::HandleProxyPacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    Packet in_packet{std::span{event->packet->data, event->packet->dataLength}};
     in_packet.IgnoreBytes(sizeof(u8)); // Message type
 
     in_packet.IgnoreBytes(sizeof(u8));          // Domain
@@ -831,25 +832,17 @@ void Room::RoomImpl::HandleProxyPacket(const ENetEvent* event) {
     bool broadcast;
     in_packet.Read(broadcast); // Broadcast
 
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
-                                                 ENET_PACKET_FLAG_RELIABLE);
+    // The received packet is forwarded as is, ENet frees it once every member received it
+    ENetPacket* enet_packet = event->packet;
 
     const auto& destination_address = remote_ip;
     if (broadcast) { // Send the data to everyone except the sender
         std::lock_guard lock(member_mutex);
-        bool sent_packet = false;
         for (const auto& member : members) {
             if (member.peer != event->peer) {
-                sent_packet = true;
                 enet_peer_send(member.peer, 0, enet_packet);
             }
         }
-
-        if (!sent_packet) {
-            enet_packet_destroy(enet_packet);
-        }
     } else { // Send the data only to the destination client
         std::lock_guard lock(member_mutex);
         auto member = std::find_if(members.begin(), members.end(),
@@ -864,15 +857,13 @@ void Room::RoomImpl::HandleProxyPacket(const ENetEvent* event) {
                       "{}.{}.{}.{}",
                       destination_address[0], destination_address[1], destination_address[2],
                       destination_address[3]);
-            enet_packet_destroy(enet_packet);
         }
     }
     enet_host_flush(server);
 }
 
 void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    Packet in_packet{std::span{event->packet->data, event->packet->dataLength}};
 
     in_packet.IgnoreBytes(sizeof(u8)); // Message type
 
@@ -885,25 +876,17 @@ void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
     bool broadcast;
     in_packet.Read(broadcast); // Broadcast
 
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
-                                                 ENET_PACKET_FLAG_RELIABLE);
+    // The received packet is forwarded as is, ENet frees it once every member received it
+    ENetPacket* enet_packet = event->packet;
 
     const auto& destination_address = remote_ip;
     if (broadcast) { // Send the data to everyone except the sender
         std::lock_guard lock(member_mutex);
-        bool sent_packet = false;
         for (const auto& member : members) {
             if (member.peer != event->peer) {
-                sent_packet = true;
                 enet_peer_send(member.peer, 0, enet_packet);
             }
         }
-
-        if (!sent_packet) {
-            enet_packet_destroy(enet_packet);
-        }
     } else {
         std::lock_guard lock(member_mutex);
         auto member = std::find_if(members.begin(), members.end(),
@@ -918,15 +901,13 @@ void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
                       "{}.{}.{}.{}",
                       destination_address[0], destination_address[1], destination_address[2],
                       destination_address[3]);
-            enet_packet_destroy(enet_packet);
         }
     }
     enet_host_flush(server);
 }
 
 void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    Packet in_packet{std::span{event->packet->data, event->packet->dataLength}};
 
     in_packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     std::string message;
@@ -975,8 +956,7 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
 }
 
 void Room::RoomImpl::HandleGameInfoPacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    Packet in_packet{std::span{event->packet->data, event->packet->dataLength}};
 
     in_packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     GameInfo game_info;
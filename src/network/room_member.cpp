@@ -2,14 +2,15 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <atomic>
-#include <list>
 #include <mutex>
 #include <set>
 #include <thread>
+#include <vector>
 #include "common/assert.h"
 #include "common/socket_types.h"
 #include "enet/enet.h"
 #include "network/packet.h"
+#include "network/packet_pool.h"
 #include "network/room_member.h"
 
 namespace Network {
@@ -44,8 +45,8 @@ public:
     std::mutex network_mutex; ///< Mutex that controls access to the `client` variable.
     /// Thread that receives and dispatches network packets
     std::unique_ptr<std::thread> loop_thread;
-    std::mutex send_list_mutex;  ///< Mutex that controls access to the `send_list` variable.
-    std::list<Packet> send_list; ///< A list that stores all packets to send the async
+    std::mutex send_list_mutex;    ///< Mutex that controls access to the `send_list` variable.
+    std::vector<Packet> send_list; ///< A list that stores all packets to send the async
 
     template <typename T>
     using CallbackSet = std::set<CallbackHandle<T>>;
@@ -162,6 +163,9 @@ bool RoomMember::RoomMemberImpl::IsConnected() const {
 }
 
 void RoomMember::RoomMemberImpl::MemberLoop() {
+    // Swapped with the send list, both keep their capacity between iterations
+    std::vector<Packet> packets;
+
     // Receive packets while the connection is open
     while (IsConnected()) {
         std::lock_guard lock(network_mutex);
@@ -257,16 +261,16 @@ void RoomMember::RoomMemberImpl::MemberLoop() {
                 break;
             }
         }
-        std::list<Packet> packets;
         {
             std::lock_guard send_lock(send_list_mutex);
             packets.swap(send_list);
         }
-        for (const auto& packet : packets) {
-            ENetPacket* enetPacket = enet_packet_create(packet.GetData(), packet.GetDataSize(),
-                                                        ENET_PACKET_FLAG_RELIABLE);
+        for (auto& packet : packets) {
+            ENetPacket* enetPacket = PacketPool::Instance().CreateENetPacket(
+                std::move(packet), ENET_PACKET_FLAG_RELIABLE);
             enet_peer_send(server, 0, enetPacket);
         }
+        packets.clear();
         enet_host_flush(client);
     }
     Disconnect();
@@ -296,8 +300,7 @@ void RoomMember::RoomMemberImpl::SendJoinRequest(const std::string& nickname_,
 }
 
 void RoomMember::RoomMemberImpl::HandleRoomInformationPacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -341,8 +344,7 @@ void RoomMember::RoomMemberImpl::HandleRoomInformationPacket(const ENetEvent* ev
 }
 
 void RoomMember::RoomMemberImpl::HandleJoinPacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -353,8 +355,7 @@ void RoomMember::RoomMemberImpl::HandleJoinPacket(const ENetEvent* event) {
 
 void RoomMember::RoomMemberImpl::HandleProxyPackets(const ENetEvent* event) {
     ProxyPacket proxy_packet{};
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -384,8 +385,7 @@ void RoomMember::RoomMemberImpl::HandleProxyPackets(const ENetEvent* event) {
 
 void RoomMember::RoomMemberImpl::HandleLdnPackets(const ENetEvent* event) {
     LDNPacket ldn_packet{};
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -404,8 +404,7 @@ void RoomMember::RoomMemberImpl::HandleLdnPackets(const ENetEvent* event) {
 }
 
 void RoomMember::RoomMemberImpl::HandleChatPacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8));
@@ -418,8 +417,7 @@ void RoomMember::RoomMemberImpl::HandleChatPacket(const ENetEvent* event) {
 }
 
 void RoomMember::RoomMemberImpl::HandleStatusMessagePacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8));
@@ -434,8 +432,7 @@ void RoomMember::RoomMemberImpl::HandleStatusMessagePacket(const ENetEvent* even
 }
 
 void RoomMember::RoomMemberImpl::HandleModBanListResponsePacket(const ENetEvent* event) {
-    Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    Packet packet{std::span{event->packet->data, event->packet->dataLength}};
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8));
@@ -625,7 +622,7 @@ bool RoomMember::IsConnected() const {
 }
 
 void RoomMember::SendProxyPacket(const ProxyPacket& proxy_packet) {
-    Packet packet;
+    Packet packet = PacketPool::Instance().Acquire();
     packet.Write(static_cast<u8>(IdProxyPacket));
 
     packet.Write(static_cast<u8>(proxy_packet.local_endpoint.family));
@@ -644,7 +641,7 @@ void RoomMember::SendProxyPacket(const ProxyPacket& proxy_packet) {
 }
 
 void RoomMember::SendLdnPacket(const LDNPacket& ldn_packet) {
-    Packet packet;
+    Packet packet = PacketPool::Instance().Acquire();
     packet.Write(static_cast<u8>(IdLdnPacket));
 
     packet.Write(static_cast<u8>(ldn_packet.type));
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <iterator>
 #include <string>
 #include <tuple>
 
@@ -204,6 +205,17 @@ void Precolor(const IR::Program& program) {
     }
 }
 
+// Rough average of the emitted code per IR instruction, used to size the code buffer up front
+constexpr size_t BytesPerInstruction = 40;
+
+size_t CountInstructions(const IR::Program& program) {
+    size_t num_insts{};
+    for (const IR::Block* const block : program.blocks) {
+        num_insts += block->size();
+    }
+    return num_insts;
+}
+
 void EmitCode(EmitContext& ctx, const IR::Program& program) {
     const auto eval{
         [&](const IR::U1& cond) { return ScalarS32{ctx.reg_alloc.Consume(IR::Value{cond})}; }};
@@ -402,6 +414,7 @@ std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, I
                       Bindings& bindings) {
     EmitContext ctx{program, bindings, profile, runtime_info};
     Precolor(program);
+    ctx.code.reserve(CountInstructions(program) * BytesPerInstruction);
     EmitCode(ctx, program);
     std::string header{StageHeader(program.stage)};
     SetupOptions(program, profile, runtime_info, header);
@@ -458,7 +471,7 @@ std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, I
     }
     header += "TEMP ";
     for (size_t index = 0; index < ctx.reg_alloc.NumUsedRegisters(); ++index) {
-        header += fmt::format("R{},", index);
+        fmt::format_to(std::back_inserter(header), "R{},", index);
     }
     if (program.local_memory_size > 0) {
         header += fmt::format("lmem[{}],", Common::DivCeil(program.local_memory_size, 4U));
@@ -473,7 +486,7 @@ std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, I
     header += "RC;"
               "LONG TEMP ";
     for (size_t index = 0; index < ctx.reg_alloc.NumUsedLongRegisters(); ++index) {
-        header += fmt::format("D{},", index);
+        fmt::format_to(std::back_inserter(header), "D{},", index);
     }
     header += "DC;";
     if (program.info.uses_fswzadd) {
@@ -492,9 +505,13 @@ std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, I
     if (ctx.uses_y_direction) {
         header += "PARAM y_direction[1]={state.material.front.ambient};";
     }
-    ctx.code.insert(0, header);
-    ctx.code += "END";
-    return ctx.code;
+    // Assemble the program once instead of shifting the whole body to prepend the header
+    std::string source;
+    source.reserve(header.size() + ctx.code.size() + 3);
+    source += header;
+    source += ctx.code;
+    source += "END";
+    return source;
 }
 
 } // namespace Shader::Backend::GLASM
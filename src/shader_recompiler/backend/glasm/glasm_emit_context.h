@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
@@ -35,24 +36,26 @@ public:
                          const RuntimeInfo& runtime_info_);
 
     template <typename... Args>
-    void Add(const char* format_str, IR::Inst& inst, Args&&... args) {
-        code += fmt::format(fmt::runtime(format_str), reg_alloc.Define(inst),
-                            std::forward<Args>(args)...);
+    void Add(fmt::format_string<Register, Args...> format_str, IR::Inst& inst, Args&&... args) {
+        // The format string was checked at compile time, format straight into the code buffer
+        const Register ret{reg_alloc.Define(inst)};
+        fmt::vformat_to(std::back_inserter(code), format_str, fmt::make_format_args(ret, args...));
         // TODO: Remove this
         code += '\n';
     }
 
     template <typename... Args>
-    void LongAdd(const char* format_str, IR::Inst& inst, Args&&... args) {
-        code += fmt::format(fmt::runtime(format_str), reg_alloc.LongDefine(inst),
-                            std::forward<Args>(args)...);
+    void LongAdd(fmt::format_string<Register, Args...> format_str, IR::Inst& inst,
+                 Args&&... args) {
+        const Register ret{reg_alloc.LongDefine(inst)};
+        fmt::vformat_to(std::back_inserter(code), format_str, fmt::make_format_args(ret, args...));
         // TODO: Remove this
         code += '\n';
     }
 
     template <typename... Args>
-    void Add(const char* format_str, Args&&... args) {
-        code += fmt::format(fmt::runtime(format_str), std::forward<Args>(args)...);
+    void Add(fmt::format_string<Args...> format_str, Args&&... args) {
+        fmt::format_to(std::back_inserter(code), format_str, std::forward<Args>(args)...);
         // TODO: Remove this
         code += '\n';
     }
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <iterator>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -130,6 +131,17 @@ void Precolor(const IR::Program& program) {
     }
 }
 
+// Rough average of the emitted code per IR instruction, used to size the code buffer up front
+constexpr size_t BytesPerInstruction = 48;
+
+size_t CountInstructions(const IR::Program& program) {
+    size_t num_insts{};
+    for (const IR::Block* const block : program.blocks) {
+        num_insts += block->size();
+    }
+    return num_insts;
+}
+
 void EmitCode(EmitContext& ctx, const IR::Program& program) {
     for (const IR::AbstractSyntaxNode& node : program.syntax_list) {
         switch (node.type) {
@@ -218,9 +230,9 @@ std::string EmitGLSL(const Profile& profile, const RuntimeInfo& runtime_info, IR
                      Bindings& bindings) {
     EmitContext ctx{program, bindings, profile, runtime_info};
     Precolor(program);
+    ctx.code.reserve(CountInstructions(program) * BytesPerInstruction);
     EmitCode(ctx, program);
     const std::string version{fmt::format("#version 460{}\n", GlslVersionSpecifier(ctx))};
-    ctx.header.insert(0, version);
     if (program.shared_memory_size > 0) {
         const auto requested_size{program.shared_memory_size};
         const auto max_size{profile.gl_max_compute_smem_size};
@@ -244,9 +256,14 @@ std::string EmitGLSL(const Profile& profile, const RuntimeInfo& runtime_info, IR
         ctx.header += "bool shfl_in_bounds;";
         ctx.header += "uint shfl_result;";
     }
-    ctx.code.insert(0, ctx.header);
-    ctx.code += '}';
-    return ctx.code;
+    // Assemble the shader once instead of shifting the whole body to prepend the header
+    std::string source;
+    source.reserve(version.size() + ctx.header.size() + ctx.code.size() + 1);
+    source += version;
+    source += ctx.header;
+    source += ctx.code;
+    source += '}';
+    return source;
 }
 
 } // namespace Shader::Backend::GLSL
@@ -12,7 +12,7 @@
 
 namespace Shader::Backend::GLSL {
 namespace {
-std::string TypePrefix(GlslVarType type) {
+std::string_view TypePrefix(GlslVarType type) {
     switch (type) {
     case GlslVarType::U1:
         return "b_";
@@ -93,12 +93,18 @@ std::string MakeImm(const IR::Value& value) {
 }
 } // Anonymous namespace
 
-std::string VarAlloc::Representation(u32 index, GlslVarType type) const {
-    const auto prefix{TypePrefix(type)};
-    return fmt::format("{}{}", prefix, index);
+const std::string& VarAlloc::Representation(u32 index, GlslVarType type) const {
+    auto& names{var_names[static_cast<size_t>(type)]};
+    if (index >= names.size()) {
+        const auto prefix{TypePrefix(type)};
+        for (size_t next = names.size(); next <= index; ++next) {
+            names.push_back(fmt::format("{}{}", prefix, next));
+        }
+    }
+    return names[index];
 }
 
-std::string VarAlloc::Representation(Id id) const {
+const std::string& VarAlloc::Representation(Id id) const {
     return Representation(id.index, id.type);
 }
 
@@ -119,16 +125,16 @@ std::string VarAlloc::Define(IR::Inst& inst, IR::Type type) {
     return Define(inst, RegType(type));
 }
 
-std::string VarAlloc::PhiDefine(IR::Inst& inst, IR::Type type) {
+std::string_view VarAlloc::PhiDefine(IR::Inst& inst, IR::Type type) {
     return AddDefine(inst, RegType(type));
 }
 
-std::string VarAlloc::AddDefine(IR::Inst& inst, GlslVarType type) {
+std::string_view VarAlloc::AddDefine(IR::Inst& inst, GlslVarType type) {
     if (inst.HasUses()) {
         inst.SetDefinition<Id>(Alloc(type));
         return Representation(inst.Definition<Id>());
     } else {
-        return "";
+        return {};
     }
 }
 
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <array>
 #include <bitset>
+#include <deque>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "common/bit_field.h"
@@ -66,8 +69,8 @@ public:
 
     /// Used to assign variables used by the IR. May return a blank string if
     /// the instruction's result is unused in the IR.
-    std::string AddDefine(IR::Inst& inst, GlslVarType type);
-    std::string PhiDefine(IR::Inst& inst, IR::Type type);
+    std::string_view AddDefine(IR::Inst& inst, GlslVarType type);
+    std::string_view PhiDefine(IR::Inst& inst, IR::Type type);
 
     std::string Consume(const IR::Value& value);
     std::string ConsumeInst(IR::Inst& inst);
@@ -76,14 +79,15 @@ public:
     std::string GetGlslType(IR::Type type) const;
 
     const UseTracker& GetUseTracker(GlslVarType type) const;
-    std::string Representation(u32 index, GlslVarType type) const;
+    /// Returns the interned name of a variable, valid for the lifetime of the allocator
+    const std::string& Representation(u32 index, GlslVarType type) const;
 
 private:
     GlslVarType RegType(IR::Type type) const;
     Id Alloc(GlslVarType type);
     void Free(Id id);
     UseTracker& GetUseTracker(GlslVarType type);
-    std::string Representation(Id id) const;
+    const std::string& Representation(Id id) const;
 
     UseTracker var_bool{};
     UseTracker var_f16x2{};
@@ -99,6 +103,10 @@ private:
     UseTracker var_f64{};
     UseTracker var_precf32{};
     UseTracker var_precf64{};
+
+    /// Variable names by type and index, a deque keeps them in place as it grows
+    mutable std::array<std::deque<std::string>, static_cast<size_t>(GlslVarType::Void) + 1>
+        var_names;
 };
 
 } // namespace Shader::Backend::GLSL
@@ -162,8 +162,15 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
         Settings, astc_recompression, tr("ASTC Recompression Method:"),
         tr("Almost all desktop and laptop dedicated GPUs lack support for ASTC textures, forcing "
            "the emulator to decompress to an intermediate format any card supports, RGBA8.\n"
-           "This option recompresses RGBA8 to either the BC1 or BC3 format, saving VRAM but "
+           "This option recompresses RGBA8 to either the BC1, BC3 or BC7 format, saving VRAM but "
            "negatively affecting image quality."));
+    INSERT(Settings, astc_recompression_quality, tr("ASTC Recompression Quality:"),
+           tr("Trades recompression speed for image quality.\nFast encodes textures the quickest, "
+              "High takes the longest but produces the most accurate BC3 and BC7 textures."));
+    INSERT(Settings, use_disk_texture_cache, tr("Use disk texture cache"),
+           tr("Saves decoded and recompressed textures to storage, so they do not have to be "
+              "decoded again on following game boots.\nUses up to the configured amount of disk "
+              "space per game."));
     INSERT(Settings, vram_usage_mode, tr("VRAM Usage Mode:"),
            tr("Selects whether the emulator should prefer to conserve memory or make maximum usage "
               "of available video memory for performance. Has no effect on integrated graphics. "
@@ -200,6 +207,14 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            tr("Enables asynchronous shader compilation, which may reduce shader stutter.\nThis "
               "feature "
               "is experimental."));
+    INSERT(Settings, nvdec_frame_threading, tr("Use frame threading for CPU video decoding"),
+           tr("Decodes several video frames in parallel when NVDEC emulation runs on the CPU.\n"
+              "Improves video playback speed, but frames are only output once later frames are "
+              "submitted, which may drop frames in some games."));
+    INSERT(Settings, use_parallel_command_recording,
+           tr("Record commands in parallel (Vulkan only)"),
+           tr("Splits render passes with many draws and records them on several CPU threads.\n"
+              "Can improve performance in draw heavy games on CPUs with many cores."));
     INSERT(Settings, use_fast_gpu_time, tr("Use Fast GPU Time (Hack)"),
            tr("Enables Fast GPU Time. This option will force most games to run at their highest "
               "native resolution."));
@@ -207,6 +222,11 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            tr("Enables GPU vendor-specific pipeline cache.\nThis option can improve shader loading "
               "time significantly in cases where the Vulkan driver does not store pipeline cache "
               "files internally."));
+    INSERT(Settings, use_graphics_pipeline_library,
+           tr("Use graphics pipeline libraries (Vulkan only, experimental)"),
+           tr("Links pipelines from precompiled parts so draws don't wait for shaders to build, "
+              "then swaps in an optimized pipeline.\nIt has not been validated on most drivers "
+              "yet and may break graphics."));
     INSERT(
         Settings, enable_compute_pipelines, tr("Enable Compute Pipelines (Intel Vulkan Only)"),
         tr("Enable compute pipelines, required by some games.\nThis setting only exists for Intel "
@@ -319,7 +339,14 @@ std::unique_ptr<ComboboxTranslationMap> ComboboxEnumeration(QWidget* parent) {
              PAIR(AstcRecompression, Uncompressed, tr("Uncompressed (Best quality)")),
              PAIR(AstcRecompression, Bc1, tr("BC1 (Low quality)")),
              PAIR(AstcRecompression, Bc3, tr("BC3 (Medium quality)")),
+             PAIR(AstcRecompression, Bc7, tr("BC7 (High quality)")),
          }});
+    translations->insert({Settings::EnumMetadata<Settings::AstcRecompressionQuality>::Index(),
+                          {
+                              PAIR(AstcRecompressionQuality, Fast, tr("Fast")),
+                              PAIR(AstcRecompressionQuality, Balanced, tr("Balanced")),
+                              PAIR(AstcRecompressionQuality, High, tr("High")),
+                          }});
     translations->insert({Settings::EnumMetadata<Settings::VramUsageMode>::Index(),
                           {
                               PAIR(VramUsageMode, Conservative, tr("Conservative")),
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <chrono>
+#include <ctime>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <regex>
@@ -9,13 +11,16 @@
 #include <string>
 #include <thread>
 
+#include <SDL.h>
 #include <fmt/ostream.h>
 
+#include "common/boot_trace.h"
 #include "common/detached_tasks.h"
 #include "common/logging/backend.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/nvidia_flags.h"
+#include "common/polyfill_thread.h"
 #include "common/scm_rev.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
@@ -32,6 +37,8 @@
 #include "core/hle/service/am/service/library_applet_creator.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
+#include "core/perf_stats.h"
+#include "core/replay.h"
 #include "frontend_common/config.h"
 #include "input_common/main.h"
 #include "network/network.h"
@@ -80,6 +87,9 @@ static void PrintHelp(const char* argv0) {
                  "-m, --multiplayer=nick:password@address:port"
                  " Nickname, password, address and port for multiplayer\n"
                  "-p, --program         Pass following string as arguments to executable\n"
+                 "-r, --record          Record all inputs of the session to the specified file\n"
+                 "-R, --replay          Replay the inputs recorded in the specified file in\n"
+                 "                      single core mode and print a benchmark report at the end\n"
                  "-u, --user            Select a specific user profile from 0 to 7\n"
                  "-v, --version         Output version information and exit\n"
                  "-l, "
@@ -90,6 +100,26 @@ static void PrintHelp(const char* argv0) {
                  "                      the applet_id.\n";
 }
 
+static void PrintBenchmarkReport(Core::System& system,
+                                 std::chrono::steady_clock::time_point wall_start,
+                                 std::clock_t cpu_start) {
+    const auto wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                         wall_start)
+                               .count();
+    const auto cpu_time = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    const auto frametimes = system.GetPerfStats().GetFrametimeSummary();
+
+    std::cout << fmt::format("Benchmark report\n"
+                             "  Wall time:  {:.3f} s\n"
+                             "  CPU time:   {:.3f} s ({:.0f}% of wall time)\n"
+                             "  Frames:     {}\n"
+                             "  Frametime:  mean {:.3f} ms, median {:.3f} ms, p99 {:.3f} ms, "
+                             "max {:.3f} ms\n",
+                             wall_time, cpu_time, wall_time > 0 ? cpu_time / wall_time * 100 : 0,
+                             frametimes.frames, frametimes.mean, frametimes.median,
+                             frametimes.p99, frametimes.max);
+}
+
 static void PrintVersion() {
     std::cout << "suyu" << Common::g_scm_branch << " " << Common::g_scm_desc << std::endl;
 }
@@ -219,6 +249,8 @@ int main(int argc, char** argv) {
     std::optional<std::string> config_path;
     std::string program_args;
     std::optional<int> selected_user;
+    std::optional<std::string> record_path;
+    std::optional<std::string> replay_path;
 
     bool use_multiplayer = false;
     bool fullscreen = false;
@@ -237,6 +269,8 @@ int main(int argc, char** argv) {
         {"applet-params", optional_argument, 0, 'l'},
         {"multiplayer", required_argument, 0, 'm'},
         {"program", optional_argument, 0, 'p'},
+        {"record", required_argument, 0, 'r'},
+        {"replay", required_argument, 0, 'R'},
         {"user", required_argument, 0, 'u'},
         {"version", no_argument, 0, 'v'},
         {0, 0, 0, 0},
@@ -244,7 +278,7 @@ int main(int argc, char** argv) {
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::c:u:l::", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhvp::c:u:l::r:R:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'c':
@@ -320,6 +354,12 @@ int main(int argc, char** argv) {
                 program_args = argv[optind];
                 ++optind;
                 break;
+            case 'r':
+                record_path = optarg;
+                break;
+            case 'R':
+                replay_path = optarg;
+                break;
             case 'u':
                 selected_user = atoi(optarg);
                 break;
@@ -353,6 +393,18 @@ int main(int argc, char** argv) {
         Settings::values.current_user = std::clamp(*selected_user, 0, 7);
     }
 
+    if (record_path && replay_path) {
+        std::cout << "Only one of --record and --replay can be used at a time\n";
+        return -1;
+    }
+    if (record_path || replay_path) {
+        // Guest time only follows executed CPU ticks in single core mode
+        Settings::values.use_multi_core.SetValue(false);
+    }
+    if (replay_path) {
+        Settings::values.use_speed_limit.SetValue(false);
+    }
+
 #ifdef _WIN32
     LocalFree(argv_w);
 #endif
@@ -372,22 +424,41 @@ int main(int argc, char** argv) {
     Core::System system{};
     system.Initialize();
 
+    auto& replay_session = system.GetReplaySession();
+    if (record_path && !replay_session.StartRecording(*record_path)) {
+        return -1;
+    }
+    if (replay_path && !replay_session.StartReplay(*replay_path)) {
+        return -1;
+    }
+
     InputCommon::InputSubsystem input_subsystem{};
 
     // Apply the command line arguments
     system.ApplySettings();
+    system.StartBootTrace();
+
+    // Key derivation does not depend on the window, load the keys while it is being created
+    auto key_loading = std::async(std::launch::async, [] {
+        Common::BootTrace::Scope scope{"LoadKeys"};
+        Core::Crypto::KeyManager::Instance();
+    });
 
     std::unique_ptr<EmuWindow_SDL2> emu_window;
-    switch (Settings::values.renderer_backend.GetValue()) {
-    case Settings::RendererBackend::OpenGL:
-        emu_window = std::make_unique<EmuWindow_SDL2_GL>(&input_subsystem, system, fullscreen);
-        break;
-    case Settings::RendererBackend::Vulkan:
-        emu_window = std::make_unique<EmuWindow_SDL2_VK>(&input_subsystem, system, fullscreen);
-        break;
-    case Settings::RendererBackend::Null:
-        emu_window = std::make_unique<EmuWindow_SDL2_Null>(&input_subsystem, system, fullscreen);
-        break;
+    {
+        Common::BootTrace::Scope scope{"CreateWindow"};
+        switch (Settings::values.renderer_backend.GetValue()) {
+        case Settings::RendererBackend::OpenGL:
+            emu_window = std::make_unique<EmuWindow_SDL2_GL>(&input_subsystem, system, fullscreen);
+            break;
+        case Settings::RendererBackend::Vulkan:
+            emu_window = std::make_unique<EmuWindow_SDL2_VK>(&input_subsystem, system, fullscreen);
+            break;
+        case Settings::RendererBackend::Null:
+            emu_window =
+                std::make_unique<EmuWindow_SDL2_Null>(&input_subsystem, system, fullscreen);
+            break;
+        }
     }
 
 #ifdef _WIN32
@@ -397,6 +468,7 @@ int main(int argc, char** argv) {
 
     system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
     system.SetFilesystem(std::make_shared<FileSys::RealVfsFilesystem>());
+    key_loading.wait();
     system.GetFileSystemController().CreateFactories(*system.GetFilesystem());
     system.GetUserChannel().clear();
 
@@ -467,18 +539,28 @@ int main(int argc, char** argv) {
         }
     }
 
+    if (replay_session.IsRecording()) {
+        replay_session.SetProgramId(system.GetApplicationProcessProgramID());
+    } else if (replay_session.IsReplaying() &&
+               replay_session.GetProgramId() != system.GetApplicationProcessProgramID()) {
+        LOG_WARNING(Frontend, "Replay was recorded with program {:016X}, running {:016X}",
+                    replay_session.GetProgramId(), system.GetApplicationProcessProgramID());
+    }
+
     // Core is loaded, start the GPU (makes the GPU contexts current to this thread)
     system.GPU().Start();
     system.GetCpuManager().OnGpuReady();
 
     if (Settings::values.use_disk_shader_cache.GetValue()) {
+        Common::BootTrace::Scope scope{"LoadShaderCache"};
         system.Renderer().ReadRasterizer()->LoadDiskResources(
             system.GetApplicationProcessProgramID(), std::stop_token{},
             [](VideoCore::LoadCallbackStage, size_t value, size_t total) {});
     }
 
     system.RegisterExitCallback([&] {
-        // Just exit right away.
+        // Just exit right away, after flushing any recorded inputs.
+        replay_session.Stop();
         exit(0);
     });
 
@@ -490,11 +572,33 @@ int main(int argc, char** argv) {
     if (system.DebuggerEnabled()) {
         system.InitializeDebugger();
     }
+
+    const auto benchmark_start = std::chrono::steady_clock::now();
+    const std::clock_t benchmark_cpu_start = std::clock();
+    std::jthread replay_watcher;
+    if (replay_session.IsReplaying()) {
+        // Close the window once every recorded sample has been fed to the guest
+        replay_watcher = std::jthread([&replay_session](std::stop_token stop_token) {
+            while (!stop_token.stop_requested() && !replay_session.IsReplayFinished()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds{100});
+            }
+            SDL_Event quit_event{};
+            quit_event.type = SDL_QUIT;
+            SDL_PushEvent(&quit_event);
+        });
+    }
+
     while (emu_window->IsOpen()) {
         emu_window->WaitEvent();
     }
     system.DetachDebugger();
     void(system.Pause());
+
+    if (replay_session.IsReplaying()) {
+        PrintBenchmarkReport(system, benchmark_start, benchmark_cpu_start);
+    }
+    replay_watcher = {};
+    replay_session.Stop();
     system.ShutdownMainProcess();
 
 #ifdef __unix__
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <functional>
 #include <memory>
@@ -12,9 +13,11 @@
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
 
 #include "common/common_types.h"
 #include "common/fiber.h"
+#include "common/fiber_stack_pool.h"
 
 namespace Common {
 
@@ -310,4 +313,83 @@ TEST_CASE("Fibers::Rewind", "[common]") {
     REQUIRE(test_control.rewinded);
 }
 
+namespace {
+
+// Touches a good part of the stack, so pages discarded by the pool are faulted back in
+u32 DeepRecursion(u32 depth) {
+    volatile u8 frame[1024];
+    frame[0] = static_cast<u8>(depth);
+    if (depth == 0) {
+        return frame[0];
+    }
+    return DeepRecursion(depth - 1) + frame[0];
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Fibers::StackPool", "[common]") {
+    auto thread_fiber = Fiber::ThreadToFiber();
+    const auto run_fiber = [&thread_fiber] {
+        u32 result{};
+        std::shared_ptr<Fiber> fiber;
+        fiber = std::make_shared<Fiber>([&] {
+            result = DeepRecursion(256);
+            Fiber::YieldTo(fiber, *thread_fiber);
+        });
+        Fiber::YieldTo(thread_fiber, *fiber);
+        return result;
+    };
+    const u32 expected = run_fiber();
+
+    // Stacks of destroyed fibers are reused, and work like freshly mapped ones
+    const auto before = FiberStackPool::Instance().GetStatistics();
+    REQUIRE(before.num_free > 0);
+    REQUIRE(run_fiber() == expected);
+    const auto after = FiberStackPool::Instance().GetStatistics();
+    REQUIRE(after.reused > before.reused);
+    REQUIRE(after.allocated == before.allocated);
+
+    thread_fiber->Exit();
+}
+
+TEST_CASE("Fibers::Benchmark", "[common][.benchmark]") {
+    constexpr u32 num_fibers = 20000;
+    constexpr u32 num_switches = 1000000;
+
+    const auto print = [](const char* name, auto start, u32 count) {
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        fmt::print("{:<24} {:>8.1f} ns\n", name, elapsed.count() / count);
+    };
+    auto thread_fiber = Fiber::ThreadToFiber();
+
+    // Like a short-lived guest thread, uses some stack on a fresh fiber and exits
+    auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < num_fibers; ++i) {
+        std::shared_ptr<Fiber> fiber;
+        fiber = std::make_shared<Fiber>([&] {
+            DeepRecursion(16);
+            Fiber::YieldTo(fiber, *thread_fiber);
+        });
+        Fiber::YieldTo(thread_fiber, *fiber);
+    }
+    print("Fiber create/destroy", start, num_fibers);
+
+    std::shared_ptr<Fiber> fiber;
+    fiber = std::make_shared<Fiber>([&] {
+        while (true) {
+            Fiber::YieldTo(fiber, *thread_fiber);
+        }
+    });
+    start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < num_switches; ++i) {
+        Fiber::YieldTo(thread_fiber, *fiber);
+    }
+    print("Fiber switch round trip", start, num_switches);
+
+    const auto stats = FiberStackPool::Instance().GetStatistics();
+    fmt::print("Stacks mapped: {}, reused: {}\n", stats.allocated, stats.reused);
+    thread_fiber->Exit();
+}
+
 } // namespace Common
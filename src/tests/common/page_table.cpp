@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+
+namespace {
+
+constexpr u64 PageSize = 0x1000;
+
+// Maps num_pages pages at virt_addr to physically contiguous memory at phys_addr
+void Map(Common::PageTable& page_table, u64 virt_addr, u64 phys_addr, u64 num_pages) {
+    for (u64 i = 0; i < num_pages; ++i) {
+        page_table.backing_addr[virt_addr / PageSize + i] = phys_addr - virt_addr;
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("PageTable: Traversal merges contiguous pages", "[common]") {
+    Common::PageTable page_table;
+    page_table.Resize(24, 12);
+
+    // 32 contiguous pages, then a discontiguous page
+    Map(page_table, 0x100000, 0x80000000, 32);
+    Map(page_table, 0x120000, 0x90000000, 1);
+
+    Common::PageTable::TraversalContext context;
+    Common::PageTable::TraversalEntry entry;
+
+    // Blocks are naturally aligned, the first entry points at the requested address
+    REQUIRE(page_table.BeginTraversal(&entry, &context, 0x101234));
+    REQUIRE(entry.phys_addr == 0x80001234);
+    REQUIRE(entry.block_size == Common::PageTable::MaxTraversalBlockSize);
+
+    REQUIRE(page_table.ContinueTraversal(&entry, &context));
+    REQUIRE(entry.phys_addr == 0x80010000);
+    REQUIRE(entry.block_size == Common::PageTable::MaxTraversalBlockSize);
+
+    REQUIRE(page_table.ContinueTraversal(&entry, &context));
+    REQUIRE(entry.phys_addr == 0x90000000);
+    REQUIRE(entry.block_size == PageSize);
+
+    REQUIRE(!page_table.ContinueTraversal(&entry, &context));
+}
+
+TEST_CASE("PageTable: Traversal respects physical alignment", "[common]") {
+    Common::PageTable page_table;
+    page_table.Resize(24, 12);
+
+    // Virtually aligned to 64 KiB, but physically only to two pages
+    Map(page_table, 0x200000, 0x80002000, 8);
+
+    Common::PageTable::TraversalContext context;
+    Common::PageTable::TraversalEntry entry;
+
+    REQUIRE(page_table.BeginTraversal(&entry, &context, 0x200000));
+    for (u64 i = 0; i < 4; ++i) {
+        if (i != 0) {
+            REQUIRE(page_table.ContinueTraversal(&entry, &context));
+        }
+        REQUIRE(entry.phys_addr == 0x80002000 + i * PageSize * 2);
+        REQUIRE(entry.block_size == PageSize * 2);
+    }
+    REQUIRE(!page_table.ContinueTraversal(&entry, &context));
+}
+
+TEST_CASE("PageTable: MapRange fills contiguous entries", "[common]") {
+    Common::PageTable page_table;
+    page_table.Resize(24, 12);
+
+    constexpr uintptr_t HostPointer = 0x7f0000000000;
+    page_table.MapRange(0x10, 4, HostPointer, 0x80000000, Common::PageType::Memory);
+
+    for (u64 page = 0x10; page < 0x14; ++page) {
+        const u64 addr = page * PageSize;
+        REQUIRE(page_table.pointers[page].Type() == Common::PageType::Memory);
+        REQUIRE(page_table.pointers[page].Pointer() + addr == HostPointer + addr - 0x10000);
+        REQUIRE(page_table.backing_addr[page] + addr == 0x80000000 + addr - 0x10000);
+        REQUIRE(page_table.blocks[page] == 0x10000);
+    }
+    REQUIRE(page_table.pointers[0x14].Type() == Common::PageType::Unmapped);
+
+    page_table.UnmapRange(0x11, 2, Common::PageType::Unmapped);
+    REQUIRE(page_table.pointers[0x10].Type() == Common::PageType::Memory);
+    REQUIRE(page_table.pointers[0x11].Type() == Common::PageType::Unmapped);
+    REQUIRE(page_table.pointers[0x12].Pointer() == 0);
+    REQUIRE(page_table.backing_addr[0x12] == 0);
+    REQUIRE(page_table.pointers[0x13].Type() == Common::PageType::Memory);
+}
+
+TEST_CASE("PageTable::Benchmark", "[common][.benchmark]") {
+    Common::PageTable page_table;
+    page_table.Resize(39, 12);
+
+    // 1 GiB of guest memory, as mapped by a large heap
+    constexpr u64 num_pages = 0x40000;
+    constexpr u32 iterations = 16;
+    constexpr uintptr_t host_pointer = 0x7f0000000000;
+
+    const auto print = [](const char* name, auto start) {
+        const std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+        fmt::print("{:<24} {:>8.1f} us\n", name, elapsed.count() / iterations);
+    };
+
+    // Like the old per page mapping loop, a sequentially consistent store per page
+    auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        for (u64 page = 0; page < num_pages; ++page) {
+            page_table.pointers[page].Store(host_pointer, Common::PageType::Memory);
+            page_table.backing_addr[page] = 0x80000000;
+            page_table.blocks[page] = 0;
+        }
+    }
+    print("Map 1 GiB per page", start);
+
+    start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        page_table.MapRange(0, num_pages, host_pointer, 0x80000000, Common::PageType::Memory);
+    }
+    print("Map 1 GiB as a range", start);
+    REQUIRE(page_table.pointers[num_pages - 1].Type() == Common::PageType::Memory);
+}
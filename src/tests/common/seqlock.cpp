@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "common/common_types.h"
+#include "common/seqlock.h"
+
+namespace Common {
+
+namespace {
+// Odd sized payload so the last storage word is only partially used
+struct Payload {
+    std::array<u32, 5> values;
+    u8 tag;
+};
+} // Anonymous namespace
+
+TEST_CASE("SeqLock: Basic Tests", "[common]") {
+    SeqLock<Payload> lock;
+
+    REQUIRE(lock.Generation() == 1U);
+    REQUIRE(lock.Read().values == std::array<u32, 5>{});
+
+    lock.Write(Payload{{1, 2, 3, 4, 5}, 6});
+    REQUIRE(lock.Generation() == 2U);
+
+    Payload value{};
+    REQUIRE(lock.TryRead(value));
+    REQUIRE(value.values == std::array<u32, 5>{1, 2, 3, 4, 5});
+    REQUIRE(value.tag == 6);
+}
+
+TEST_CASE("SeqLock: Threaded Test", "[common]") {
+    SeqLock<Payload> lock;
+    std::atomic_bool done{false};
+
+    // Every field of a published payload holds the same value, a torn read would mix them
+    std::thread writer([&lock, &done] {
+        for (u32 i = 1; i <= 100000; ++i) {
+            Payload payload{};
+            payload.values.fill(i);
+            payload.tag = static_cast<u8>(i);
+            lock.Write(payload);
+        }
+        done = true;
+    });
+
+    u32 last = 0;
+    while (!done) {
+        const Payload value = lock.Read();
+        for (const u32 field : value.values) {
+            REQUIRE(field == value.values[0]);
+        }
+        REQUIRE(value.tag == static_cast<u8>(value.values[0]));
+        REQUIRE(value.values[0] >= last);
+        last = value.values[0];
+    }
+
+    writer.join();
+    REQUIRE(lock.Read().values[0] == 100000U);
+}
+
+} // namespace Common
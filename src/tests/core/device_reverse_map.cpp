@@ -0,0 +1,259 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/scratch_buffer.h"
+#include "core/device_reverse_map.h"
+
+namespace {
+
+using Core::DeviceReverseMap;
+
+constexpr u64 PageSize = DeviceReverseMap::PAGE_SIZE;
+
+std::vector<u64> Lookup(const DeviceReverseMap& map, u64 address) {
+    Common::ScratchBuffer<u32> buffer;
+    std::vector<u64> result;
+    map.ForEach(address, buffer, [&](u64 device_address) { result.push_back(device_address); });
+    return result;
+}
+
+// The compressed array and linked alias list the device memory manager used before the reverse
+// map, kept as the baseline of the benchmark
+class LegacyReverseMap {
+public:
+    explicit LegacyReverseMap(size_t num_pages) : compressed_device_addr(num_pages) {}
+
+    void Map(size_t page, u32 new_dev) {
+        std::scoped_lock lk{mapping_guard};
+        const u32 base_dev = compressed_device_addr[page];
+        if (base_dev == 0) {
+            compressed_device_addr[page] = new_dev;
+            return;
+        }
+        u32 start_id = base_dev & MULTI_MASK;
+        if ((base_dev >> MULTI_FLAG_BITS) == 0) {
+            start_id = Register(base_dev);
+            compressed_device_addr[page] = MULTI_FLAG | start_id;
+        }
+        Register(new_dev, start_id);
+    }
+
+    template <typename Func>
+    void ForEach(u64 address, Common::ScratchBuffer<u32>& buffer, Func&& operation) {
+        const u64 subbits = address & DeviceReverseMap::PAGE_MASK;
+        const u32 base = compressed_device_addr[address >> DeviceReverseMap::PAGE_BITS];
+        if ((base >> MULTI_FLAG_BITS) == 0) {
+            operation((static_cast<u64>(base) << DeviceReverseMap::PAGE_BITS) + subbits);
+            return;
+        }
+        GatherDeviceAddresses(buffer, address);
+        for (u32 value : buffer) {
+            operation((static_cast<u64>(value) << DeviceReverseMap::PAGE_BITS) + subbits);
+        }
+    }
+
+private:
+    static constexpr u32 MULTI_FLAG_BITS = 31;
+    static constexpr u32 MULTI_FLAG = 1U << MULTI_FLAG_BITS;
+    static constexpr u32 MULTI_MASK = ~MULTI_FLAG;
+
+    struct Entry {
+        u32 next_entry{};
+        u32 value{};
+    };
+
+    void GatherDeviceAddresses(Common::ScratchBuffer<u32>& buffer, u64 address) {
+        std::scoped_lock lk{mapping_guard};
+        const u32 backing = compressed_device_addr[address >> DeviceReverseMap::PAGE_BITS];
+        if ((backing >> MULTI_FLAG_BITS) == 0) {
+            buffer.resize(1);
+            buffer[0] = backing;
+            return;
+        }
+        buffer.resize(8);
+        buffer.resize(0);
+        size_t index = 0;
+        const Entry* current = &storage[(backing & MULTI_MASK) - 1];
+        while (true) {
+            buffer.resize(index + 1);
+            buffer[index++] = current->value;
+            if (current->next_entry == 0) {
+                break;
+            }
+            current = &storage[current->next_entry - 1];
+        }
+    }
+
+    u32 Register(u32 value) {
+        storage.push_back({.next_entry = 0, .value = value});
+        return static_cast<u32>(storage.size());
+    }
+
+    void Register(u32 value, u32 start_entry) {
+        const u32 entry_id = Register(value);
+        Entry* current = &storage[start_entry - 1];
+        while (current->next_entry != 0) {
+            current = &storage[current->next_entry - 1];
+        }
+        current->next_entry = entry_id;
+    }
+
+    std::vector<u32> compressed_device_addr;
+    std::deque<Entry> storage;
+    std::mutex mapping_guard;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("DeviceReverseMap: Single mappings", "[core]") {
+    DeviceReverseMap map(0x100);
+    map.Map(0x10, 0x800);
+
+    REQUIRE(map.SingleMapping(0x10) == 0x800);
+    REQUIRE(Lookup(map, 0x10123) == std::vector<u64>{0x800123});
+    REQUIRE(Lookup(map, 0x11000).empty());
+
+    map.Unmap(0x10, 0x800);
+    REQUIRE(map.SingleMapping(0x10) == 0);
+    REQUIRE(Lookup(map, 0x10123).empty());
+}
+
+TEST_CASE("DeviceReverseMap: Aliased mappings", "[core]") {
+    DeviceReverseMap map(0x100);
+    map.Map(0x20, 0x800);
+    map.Map(0x20, 0x900);
+    map.Map(0x20, 0xA00);
+
+    REQUIRE(map.SingleMapping(0x20) == 0);
+    std::vector<u64> result = Lookup(map, 0x20010);
+    std::ranges::sort(result);
+    REQUIRE(result == std::vector<u64>{0x800010, 0x900010, 0xA00010});
+
+    // Removing aliases collapses the page back into a direct entry
+    map.Unmap(0x20, 0x900);
+    result = Lookup(map, 0x20010);
+    std::ranges::sort(result);
+    REQUIRE(result == std::vector<u64>{0x800010, 0xA00010});
+
+    map.Unmap(0x20, 0x800);
+    REQUIRE(map.SingleMapping(0x20) == 0xA00);
+
+    // Freed links are recycled by later aliases
+    map.Map(0x30, 0xB00);
+    map.Map(0x30, 0xC00);
+    result = Lookup(map, 0x30000);
+    std::ranges::sort(result);
+    REQUIRE(result == std::vector<u64>{0xB00000, 0xC00000});
+    REQUIRE(map.SingleMapping(0x20) == 0xA00);
+}
+
+TEST_CASE("DeviceReverseMap: Ranges merge contiguous pages", "[core]") {
+    DeviceReverseMap map(0x100);
+    for (u32 i = 0; i < 4; ++i) {
+        map.Map(0x40 + i, 0x1000 + i);
+    }
+    // A discontiguous device page, an unmapped page, then an aliased page
+    map.Map(0x44, 0x2000);
+    map.Map(0x46, 0x3000);
+    map.Map(0x46, 0x4000);
+
+    Common::ScratchBuffer<u32> buffer;
+    std::vector<std::pair<u64, size_t>> ranges;
+    map.ForEachRange(0x40800, 7 * PageSize - 0x800, buffer,
+                     [&](u64 address, size_t size) { ranges.emplace_back(address, size); });
+
+    REQUIRE(ranges.size() == 4);
+    REQUIRE(ranges[0] == std::pair<u64, size_t>{0x1000800, 4 * PageSize - 0x800});
+    REQUIRE(ranges[1] == std::pair<u64, size_t>{0x2000000, PageSize});
+    std::ranges::sort(ranges.begin() + 2, ranges.end());
+    REQUIRE(ranges[2] == std::pair<u64, size_t>{0x3000000, PageSize});
+    REQUIRE(ranges[3] == std::pair<u64, size_t>{0x4000000, PageSize});
+}
+
+TEST_CASE("DeviceReverseMap::Benchmark", "[core][.benchmark]") {
+    // 1 GiB of physical memory mapped once, as most GPU buffers are
+    constexpr size_t num_pages = 0x40000;
+    constexpr u32 iterations = 16;
+    DeviceReverseMap map(num_pages);
+    LegacyReverseMap legacy_map(num_pages);
+    for (size_t page = 0; page < num_pages; ++page) {
+        map.Map(page, static_cast<u32>(0x100000 + page));
+        legacy_map.Map(page, static_cast<u32>(0x100000 + page));
+    }
+
+    const auto print = [](const char* name, auto start) {
+        const std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+        fmt::print("{:<32} {:>10.1f} us\n", name, elapsed.count() / iterations);
+    };
+
+    Common::ScratchBuffer<u32> buffer;
+    u64 num_calls = 0;
+
+    // Baseline, the gather the device memory manager did before the reverse map
+    auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        for (size_t page = 0; page < num_pages; ++page) {
+            legacy_map.ForEach(page * PageSize, buffer, [&](u64) { ++num_calls; });
+        }
+    }
+    print("Old gather 1 GiB per page", start);
+    REQUIRE(num_calls == num_pages * iterations);
+
+    // Like the per page invalidation, one lookup and one callback per page
+    num_calls = 0;
+    start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        for (size_t page = 0; page < num_pages; ++page) {
+            map.ForEach(page * PageSize, buffer, [&](u64) { ++num_calls; });
+        }
+    }
+    print("Invalidate 1 GiB per page", start);
+    REQUIRE(num_calls == num_pages * iterations);
+
+    num_calls = 0;
+    start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        map.ForEachRange(0, num_pages * PageSize, buffer, [&](u64, size_t) { ++num_calls; });
+    }
+    print("Invalidate 1 GiB as a range", start);
+    REQUIRE(num_calls == iterations);
+
+    // Alias every 16th page, each alias forces a locked gather
+    for (size_t page = 0; page < num_pages; page += 16) {
+        map.Map(page, static_cast<u32>(0x200000 + page));
+        legacy_map.Map(page, static_cast<u32>(0x200000 + page));
+    }
+    start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        for (size_t page = 0; page < num_pages; ++page) {
+            legacy_map.ForEach(page * PageSize, buffer, [&](u64) { ++num_calls; });
+        }
+    }
+    print("Old gather aliased per page", start);
+
+    start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        for (size_t page = 0; page < num_pages; ++page) {
+            map.ForEach(page * PageSize, buffer, [&](u64) { ++num_calls; });
+        }
+    }
+    print("Invalidate aliased per page", start);
+
+    start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        map.ForEachRange(0, num_pages * PageSize, buffer, [&](u64, size_t) { ++num_calls; });
+    }
+    print("Invalidate aliased as a range", start);
+}
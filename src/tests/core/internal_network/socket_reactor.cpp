@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/internal_network/network.h"
+#include "core/internal_network/socket_reactor.h"
+#include "core/internal_network/sockets.h"
+
+namespace {
+
+struct LoopbackPair {
+    Network::Socket listener;
+    Network::Socket client;
+    std::unique_ptr<Network::SocketBase> server;
+};
+
+void OpenLoopbackPair(LoopbackPair& pair) {
+    REQUIRE(pair.listener.Initialize(Network::Domain::INET, Network::Type::STREAM,
+                                     Network::Protocol::TCP) == Network::Errno::SUCCESS);
+    REQUIRE(pair.listener.Bind(Network::SockAddrIn{Network::Domain::INET, {127, 0, 0, 1}, 0}) ==
+            Network::Errno::SUCCESS);
+    REQUIRE(pair.listener.Listen(1) == Network::Errno::SUCCESS);
+
+    const auto [addr, sockname_errno] = pair.listener.GetSockName();
+    REQUIRE(sockname_errno == Network::Errno::SUCCESS);
+
+    REQUIRE(pair.client.Initialize(Network::Domain::INET, Network::Type::STREAM,
+                                   Network::Protocol::TCP) == Network::Errno::SUCCESS);
+    REQUIRE(pair.client.Connect(addr) == Network::Errno::SUCCESS);
+
+    auto [accepted, accept_errno] = pair.listener.Accept();
+    REQUIRE(accept_errno == Network::Errno::SUCCESS);
+    pair.server = std::move(accepted.socket);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Network::SocketReactor", "[core]") {
+    if (!Network::SocketReactor::IsSupported()) {
+        return;
+    }
+
+    Network::NetworkInstance network_instance;
+    Network::SocketReactor reactor;
+
+    LoopbackPair pair;
+    OpenLoopbackPair(pair);
+    REQUIRE(pair.server->SetNonBlock(true) == Network::Errno::SUCCESS);
+
+    std::vector<Network::SocketReactor::Token> ready;
+
+    // Nothing was sent yet, the wait must time out without reporting the token
+    REQUIRE(reactor.Arm(1, *pair.server, Network::PollEvents::In) == Network::Errno::SUCCESS);
+    reactor.Wait(ready, 0);
+    REQUIRE(ready.empty());
+
+    const std::array<u8, 4> message{1, 2, 3, 4};
+    REQUIRE(pair.client.Send(message, 0).first == static_cast<s32>(message.size()));
+
+    reactor.Wait(ready, 1000);
+    REQUIRE(ready == std::vector<Network::SocketReactor::Token>{1});
+
+    // Interest is one-shot
+    ready.clear();
+    reactor.Wait(ready, 0);
+    REQUIRE(ready.empty());
+
+    std::array<u8, 4> received{};
+    REQUIRE(pair.server->Recv(0, received).first == static_cast<s32>(received.size()));
+    REQUIRE(received == message);
+
+    // Releasing a socket completes the waiters parked on it
+    REQUIRE(reactor.Arm(2, *pair.server, Network::PollEvents::In) == Network::Errno::SUCCESS);
+    reactor.Release(*pair.server);
+    reactor.Wait(ready, 1000);
+    REQUIRE(ready == std::vector<Network::SocketReactor::Token>{2});
+}
+
+TEST_CASE("Network::SocketReactor loopback", "[core][.benchmark]") {
+    if (!Network::SocketReactor::IsSupported()) {
+        return;
+    }
+
+    Network::NetworkInstance network_instance;
+    Network::SocketReactor reactor;
+
+    LoopbackPair pair;
+    OpenLoopbackPair(pair);
+    REQUIRE(pair.server->SetNonBlock(true) == Network::Errno::SUCCESS);
+
+    // Echo every message back from a peer thread so each iteration is a full round trip
+    std::jthread echo([&pair](std::stop_token stop_token) {
+        std::array<u8, 64 * 1024> buffer;
+        while (!stop_token.stop_requested()) {
+            const auto [received, recv_errno] = pair.client.Recv(0, buffer);
+            if (received <= 0) {
+                return;
+            }
+            pair.client.Send(std::span<const u8>(buffer.data(), received), 0);
+        }
+    });
+
+    std::vector<Network::SocketReactor::Token> ready;
+    const auto round_trip = [&](std::span<u8> message) {
+        REQUIRE(pair.server->Send(message, 0).first == static_cast<s32>(message.size()));
+        size_t total = 0;
+        while (total < message.size()) {
+            const auto [received, recv_errno] = pair.server->Recv(0, message.subspan(total));
+            if (received > 0) {
+                total += static_cast<size_t>(received);
+                continue;
+            }
+            REQUIRE(recv_errno == Network::Errno::AGAIN);
+            reactor.Arm(0, *pair.server, Network::PollEvents::In);
+            ready.clear();
+            reactor.Wait(ready, -1);
+        }
+        return total;
+    };
+
+    std::vector<u8> small(64);
+    BENCHMARK("Round trip latency, 64 bytes") {
+        return round_trip(small);
+    };
+
+    std::vector<u8> large(32 * 1024);
+    BENCHMARK("Round trip throughput, 32 KiB") {
+        return round_trip(large);
+    };
+
+    pair.client.Shutdown(Network::ShutdownHow::RDWR);
+    echo.request_stop();
+}
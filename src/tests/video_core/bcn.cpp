@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <bc_decoder.h>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "video_core/textures/bcn.h"
+
+namespace {
+
+using Tegra::Texture::BCN::Quality;
+
+constexpr u32 Width = 256;
+constexpr u32 Height = 256;
+
+// Smooth gradients with a little noise and a varying alpha channel, like a typical game texture
+std::vector<u8> MakeImage(u32 width, u32 height) {
+    std::vector<u8> image(width * height * 4);
+    u32 seed = 12345;
+    for (u32 y = 0; y < height; ++y) {
+        for (u32 x = 0; x < width; ++x) {
+            seed = seed * 1103515245 + 12345;
+            const u8 noise = static_cast<u8>((seed >> 16) & 7);
+            u8* const texel = &image[(y * width + x) * 4];
+            texel[0] = static_cast<u8>(x + noise);
+            texel[1] = static_cast<u8>(y + noise);
+            texel[2] = static_cast<u8>((x ^ y) / 2 + noise);
+            texel[3] = static_cast<u8>(255 - x / 2);
+        }
+    }
+    return image;
+}
+
+std::vector<u8> DecodeBC7(const std::vector<u8>& blocks, u32 width, u32 height) {
+    std::vector<u8> image(width * height * 4);
+    const u8* block = blocks.data();
+    for (u32 y = 0; y < height; y += 4) {
+        for (u32 x = 0; x < width; x += 4) {
+            bcn::DecodeBc7(block, image.data() + (y * width + x) * 4, x, y, width, height);
+            block += 16;
+        }
+    }
+    return image;
+}
+
+double PSNR(const std::vector<u8>& lhs, const std::vector<u8>& rhs) {
+    double sum = 0.0;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        const double delta = static_cast<double>(lhs[i]) - static_cast<double>(rhs[i]);
+        sum += delta * delta;
+    }
+    const double mse = sum / static_cast<double>(lhs.size());
+    return mse == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("BCN: BC7 round trip", "[video_core]") {
+    const std::vector<u8> image = MakeImage(Width, Height);
+    std::vector<u8> blocks(Width * Height);
+
+    double previous_psnr = 0.0;
+    for (const Quality quality : {Quality::Fast, Quality::Balanced, Quality::High}) {
+        Tegra::Texture::BCN::CompressBC7(image, Width, Height, 1, blocks, quality);
+        const double psnr = PSNR(image, DecodeBC7(blocks, Width, Height));
+        REQUIRE(psnr > 35.0);
+        REQUIRE(psnr >= previous_psnr);
+        previous_psnr = psnr;
+    }
+
+    // A solid block is encoded exactly
+    std::vector<u8> solid(4 * 4 * 4);
+    for (size_t i = 0; i < solid.size(); i += 4) {
+        solid[i + 0] = 12;
+        solid[i + 1] = 200;
+        solid[i + 2] = 97;
+        solid[i + 3] = 255;
+    }
+    std::vector<u8> block(16);
+    Tegra::Texture::BCN::CompressBC7(solid, 4, 4, 1, block, Quality::High);
+    const auto decoded = DecodeBC7(block, 4, 4);
+    for (size_t i = 0; i < solid.size(); ++i) {
+        REQUIRE(std::abs(static_cast<int>(decoded[i]) - static_cast<int>(solid[i])) <= 1);
+    }
+}
+
+TEST_CASE("BCN: Recompression throughput", "[video_core][.benchmark]") {
+    constexpr u32 Size = 1024;
+    const std::vector<u8> image = MakeImage(Size, Size);
+    std::vector<u8> blocks(Size * Size);
+
+    const auto run = [&](const char* name, auto&& compress) {
+        const auto start = std::chrono::steady_clock::now();
+        compress();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        fmt::print("{:<20} {:>8.1f} MTexel/s\n", name, Size * Size / elapsed.count() / 1e6);
+    };
+    run("BC1 fast", [&] { Tegra::Texture::BCN::CompressBC1(image, Size, Size, 1, blocks); });
+    run("BC3 fast", [&] { Tegra::Texture::BCN::CompressBC3(image, Size, Size, 1, blocks); });
+    run("BC3 high", [&] {
+        Tegra::Texture::BCN::CompressBC3(image, Size, Size, 1, blocks, Quality::High);
+    });
+    for (const auto& [name, quality] : {std::pair{"BC7 fast", Quality::Fast},
+                                        std::pair{"BC7 balanced", Quality::Balanced},
+                                        std::pair{"BC7 high", Quality::High}}) {
+        run(name, [&] { Tegra::Texture::BCN::CompressBC7(image, Size, Size, 1, blocks, quality); });
+        fmt::print("{:<20} {:>8.2f} dB\n", "", PSNR(image, DecodeBC7(blocks, Size, Size)));
+    }
+
+    const auto stats = Tegra::Texture::BCN::GetCompressionStatistics();
+    fmt::print("Saved {} MiB of {} MiB, {:.1f} MTexel/s overall\n", stats.SavedBytes() >> 20,
+               stats.input_bytes >> 20, stats.MegaTexelsPerSecond());
+}
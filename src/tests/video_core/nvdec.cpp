@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/settings.h"
+#include "video_core/host1x/ffmpeg/ffmpeg.h"
+
+namespace {
+
+using Tegra::Host1x::NvdecCommon::VideoCodec;
+using Clock = std::chrono::steady_clock;
+
+struct Bitstream {
+    VideoCodec codec;
+    std::vector<std::vector<u8>> packets;
+};
+
+template <typename T>
+T Read(const std::vector<u8>& data, size_t offset) {
+    T value{};
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+// Splits a VP8 or VP9 IVF file into its frames
+bool ReadIvf(const char* path, Bitstream& out_bitstream) {
+    std::ifstream file{path, std::ios::binary};
+    const std::vector<u8> data{std::istreambuf_iterator<char>{file}, {}};
+    if (data.size() < 32 || std::memcmp(data.data(), "DKIF", 4) != 0) {
+        return false;
+    }
+    if (std::memcmp(data.data() + 8, "VP80", 4) == 0) {
+        out_bitstream.codec = VideoCodec::VP8;
+    } else if (std::memcmp(data.data() + 8, "VP90", 4) == 0) {
+        out_bitstream.codec = VideoCodec::VP9;
+    } else {
+        return false;
+    }
+
+    size_t offset = Read<u16>(data, 6);
+    while (offset + 12 <= data.size()) {
+        const u32 size = Read<u32>(data, offset);
+        offset += 12;
+        if (offset + size > data.size()) {
+            break;
+        }
+        out_bitstream.packets.emplace_back(data.begin() + offset, data.begin() + offset + size);
+        offset += size;
+    }
+    return !out_bitstream.packets.empty();
+}
+
+// Decodes the whole bitstream like the nvdec decoder thread, returns the number of frames
+size_t Decode(const Bitstream& bitstream, bool frame_threading) {
+    Settings::values.nvdec_frame_threading.SetValue(frame_threading);
+
+    FFmpeg::DecodeApi decode_api;
+    REQUIRE(decode_api.Initialize(bitstream.codec));
+    REQUIRE(decode_api.UsingFrameThreading() == frame_threading);
+
+    std::deque<Clock::time_point> submit_times;
+    std::chrono::duration<double, std::milli> total_latency{};
+    size_t num_frames = 0;
+    const auto receive = [&] {
+        while (!submit_times.empty()) {
+            if (!decode_api.ReceiveFrame()) {
+                return;
+            }
+            total_latency += Clock::now() - submit_times.front();
+            submit_times.pop_front();
+            ++num_frames;
+        }
+    };
+
+    const auto start = Clock::now();
+    for (const auto& packet : bitstream.packets) {
+        submit_times.push_back(Clock::now());
+        if (decode_api.SendPacket(packet)) {
+            receive();
+        }
+    }
+    // Drain the frames still held by the decoder threads
+    decode_api.SendPacket({});
+    receive();
+
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    const double frames = static_cast<double>(num_frames);
+    fmt::print("{:<20} {:>8.1f} fps {:>8.2f} ms latency\n",
+               frame_threading ? "Frame threading" : "Slice threading", frames / elapsed.count(),
+               num_frames != 0 ? total_latency.count() / frames : 0.0);
+    return num_frames;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Nvdec: Software decode throughput", "[video_core][.benchmark]") {
+    // Sample bitstreams are not shipped with the tests, point this at a VP8 or VP9 IVF file
+    const char* const path = std::getenv("SUYU_NVDEC_BENCHMARK_IVF");
+    if (path == nullptr) {
+        WARN("Set SUYU_NVDEC_BENCHMARK_IVF to an IVF file to run this benchmark");
+        return;
+    }
+    Bitstream bitstream;
+    REQUIRE(ReadIvf(path, bitstream));
+
+    Settings::values.nvdec_emulation.SetValue(Settings::NvdecEmulation::Cpu);
+    const size_t num_frames = Decode(bitstream, false);
+    REQUIRE(Decode(bitstream, true) == num_frames);
+
+    Settings::values.nvdec_emulation.SetValue(Settings::NvdecEmulation::Gpu);
+    Settings::values.nvdec_frame_threading.SetValue(false);
+}
@@ -1,8 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <fmt/format.h>
+
 #include "common/assert.h"
 #include "common/settings.h"
+#include "common/thread.h"
 #include "video_core/host1x/codecs/decoder.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/memory_manager.h"
@@ -12,31 +15,98 @@ namespace Tegra {
 Decoder::Decoder(Host1x::Host1x& host1x_, s32 id_, const Host1x::NvdecCommon::NvdecRegisters& regs_,
                  Host1x::FrameQueue& frame_queue_)
     : host1x(host1x_), memory_manager{host1x.GMMU()}, regs{regs_}, id{id_}, frame_queue{
-                                                                                frame_queue_} {}
+                                                                                frame_queue_} {
+    decode_thread = std::jthread([this](std::stop_token stop_token) { DecodeThread(stop_token); });
+}
 
-Decoder::~Decoder() = default;
+Decoder::~Decoder() {
+    decode_thread.request_stop();
+    decode_thread.join();
+
+    // Release VIC from waiting on frames that will never be decoded or output
+    frame_queue.EndDecode(id, requests.size() + pending_outputs.size());
+}
 
 void Decoder::Decode() {
     if (!initialized) {
         return;
     }
 
+    // Compose the frame from the guest state now, the registers change with the next submit.
     const auto packet_data = ComposeFrame();
-    // Send assembled bitstream to decoder.
-    if (!decode_api.SendPacket(packet_data)) {
+    DecodeRequest request{
+        .bitstream = std::vector<u8>(packet_data.begin(), packet_data.end()),
+        .is_interlaced = IsInterlaced(),
+        // Only receive/store visible frames.
+        .is_hidden = vp9_hidden_frame,
+    };
+    if (request.is_interlaced) {
+        auto [luma_top, luma_bottom, chroma_top, chroma_bottom] = GetInterlacedOffsets();
+        request.luma_offsets = {luma_top, luma_bottom};
+    } else {
+        auto [luma_offset, chroma_offset] = GetProgressiveOffsets();
+        request.luma_offsets[0] = luma_offset;
+    }
+
+    frame_queue.BeginDecode(id);
+    {
+        std::scoped_lock l{request_mutex};
+        requests.push_back(std::move(request));
+    }
+    request_cv.notify_one();
+}
+
+void Decoder::DecodeThread(std::stop_token stop_token) {
+    Common::SetCurrentThreadName(fmt::format("NvdecDecoder{}", id).c_str());
+
+    while (!stop_token.stop_requested()) {
+        DecodeRequest request;
+        {
+            std::unique_lock l{request_mutex};
+            Common::CondvarWait(request_cv, l, stop_token, [this] { return !requests.empty(); });
+            if (stop_token.stop_requested()) {
+                return;
+            }
+            request = std::move(requests.front());
+            requests.pop_front();
+        }
+
+        DecodeRequestImpl(request);
+    }
+}
+
+void Decoder::DecodeRequestImpl(DecodeRequest& request) {
+    // Send assembled bitstream to decoder. Dropped and hidden frames have no output to wait for.
+    if (!decode_api.SendPacket(request.bitstream) || request.is_hidden) {
+        frame_queue.EndDecode(id);
         return;
     }
 
-    // Only receive/store visible frames.
-    if (vp9_hidden_frame) {
+    if (!decode_api.UsingFrameThreading()) {
+        // Receive output frames from decoder.
+        PushFrame(request, decode_api.ReceiveFrame());
         return;
     }
 
-    // Receive output frames from decoder.
-    auto frame = decode_api.ReceiveFrame();
+    // Frame threaded decoders output frames in submission order once enough packets were sent,
+    // so match each output with the oldest request still waiting for one.
+    request.bitstream.clear();
+    pending_outputs.push_back(std::move(request));
+    while (!pending_outputs.empty()) {
+        auto frame = decode_api.ReceiveFrame();
+        if (!frame) {
+            break;
+        }
+        PushFrame(pending_outputs.front(), std::move(frame));
+        pending_outputs.pop_front();
+    }
+}
+
+void Decoder::PushFrame(const DecodeRequest& request, std::shared_ptr<FFmpeg::Frame>&& frame) {
+    const bool decode_order = decode_api.UsingDecodeOrder();
 
-    if (IsInterlaced()) {
-        auto [luma_top, luma_bottom, chroma_top, chroma_bottom] = GetInterlacedOffsets();
+    if (request.is_interlaced) {
+        const auto [luma_top, luma_bottom] = request.luma_offsets;
         auto frame_copy = frame;
 
         if (!frame.get()) {
@@ -45,7 +115,7 @@ void Decoder::Decode() {
                       luma_top, luma_bottom);
         }
 
-        if (UsingDecodeOrder()) {
+        if (decode_order) {
             frame_queue.PushDecodeOrder(id, luma_top, std::move(frame));
             frame_queue.PushDecodeOrder(id, luma_bottom, std::move(frame_copy));
         } else {
@@ -53,19 +123,22 @@ void Decoder::Decode() {
             frame_queue.PushPresentOrder(id, luma_bottom, std::move(frame_copy));
         }
     } else {
-        auto [luma_offset, chroma_offset] = GetProgressiveOffsets();
+        const auto luma_offset = request.luma_offsets[0];
 
         if (!frame.get()) {
             LOG_ERROR(HW_GPU, "Nvdec {} failed to decode progressive frame for luma 0x{:X}", id,
                       luma_offset);
         }
 
-        if (UsingDecodeOrder()) {
+        if (decode_order) {
             frame_queue.PushDecodeOrder(id, luma_offset, std::move(frame));
         } else {
             frame_queue.PushPresentOrder(id, luma_offset, std::move(frame));
         }
     }
+
+    // With frame threading the output arrives after later submissions, only now is it decoded
+    frame_queue.EndDecode(id);
 }
 
 } // namespace Tegra
@@ -3,14 +3,19 @@
 
 #pragma once
 
+#include <array>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string_view>
 #include <unordered_map>
 #include <queue>
+#include <vector>
 
 #include "common/common_types.h"
+#include "common/polyfill_thread.h"
 #include "video_core/host1x/ffmpeg/ffmpeg.h"
 #include "video_core/host1x/nvdec_common.h"
 
@@ -25,13 +30,9 @@ class Decoder {
 public:
     virtual ~Decoder();
 
-    /// Call decoders to construct headers, decode AVFrame with ffmpeg
+    /// Call decoders to construct headers, and queue the frame to be decoded with ffmpeg
     void Decode();
 
-    bool UsingDecodeOrder() const {
-        return decode_api.UsingDecodeOrder();
-    }
-
     /// Returns the value of current_codec
     [[nodiscard]] Host1x::NvdecCommon::VideoCodec GetCurrentCodec() const {
         return codec;
@@ -59,6 +60,31 @@ protected:
     FFmpeg::DecodeApi decode_api;
     bool initialized{};
     bool vp9_hidden_frame{};
+
+private:
+    /// A composed frame, waiting to be decoded on the decoder thread
+    struct DecodeRequest {
+        std::vector<u8> bitstream;
+        std::array<u64, 2> luma_offsets{};
+        bool is_interlaced{};
+        bool is_hidden{};
+    };
+
+    /// Decodes requests as they are submitted, and pushes the output frames to the frame queue
+    void DecodeThread(std::stop_token stop_token);
+
+    void DecodeRequestImpl(DecodeRequest& request);
+
+    void PushFrame(const DecodeRequest& request, std::shared_ptr<FFmpeg::Frame>&& frame);
+
+    std::mutex request_mutex;
+    std::condition_variable_any request_cv;
+    std::deque<DecodeRequest> requests;
+
+    /// Requests sent to a frame threaded decoder, waiting for their output frame
+    std::deque<DecodeRequest> pending_outputs;
+
+    std::jthread decode_thread;
 };
 
 } // namespace Tegra
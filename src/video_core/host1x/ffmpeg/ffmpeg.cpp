@@ -206,17 +206,35 @@ void DecoderContext::InitializeHardwareDecoder(const HardwareContext& context,
 }
 
 bool DecoderContext::OpenContext(const Decoder& decoder) {
+    // Frame threading delays the output by a frame per thread, so it can only be used when frames
+    // are drained as they become available. Hardware decoding and the direct H.264 path below
+    // bypass the threading machinery.
+    if (Settings::values.nvdec_frame_threading.GetValue() && !m_codec_context->hw_device_ctx &&
+        !UsingDirectDecode()) {
+        m_codec_context->thread_type |= FF_THREAD_FRAME;
+        m_frame_threading = true;
+    }
+
     if (const int ret = avcodec_open2(m_codec_context, decoder.GetCodec(), nullptr); ret < 0) {
         LOG_ERROR(HW_GPU, "avcodec_open2 error: {}", AVError(ret));
         return false;
     }
 
     if (!m_codec_context->hw_device_ctx) {
-        LOG_INFO(HW_GPU, "Using FFmpeg software decoding");
+        LOG_INFO(HW_GPU, "Using FFmpeg software decoding{}",
+                 m_frame_threading ? " with frame threading" : "");
     }
 
     return true;
 }
+
+bool DecoderContext::UsingDirectDecode() const {
+#ifndef ANDROID
+    return !m_codec_context->hw_device_ctx && m_codec_context->codec_id == AV_CODEC_ID_H264;
+#else
+    return false;
+#endif
+}
 #ifndef ANDROID
 // Nasty but allows linux builds to pass.
 // Requires double checks when FFMPEG gets updated.
@@ -378,13 +396,13 @@ static av_always_inline const FFCodec* ffcodec(const AVCodec* codec) {
 } // namespace
 #endif
 bool DecoderContext::SendPacket(const Packet& packet) {
-    m_temp_frame = std::make_shared<Frame>();
     m_got_frame = 0;
 
 // Android can randomly crash when calling decode directly, so skip.
 // TODO update ffmpeg and hope that fixes it.
 #ifndef ANDROID
-    if (!m_codec_context->hw_device_ctx && m_codec_context->codec_id == AV_CODEC_ID_H264) {
+    if (UsingDirectDecode()) {
+        m_temp_frame = std::make_shared<Frame>();
         m_decode_order = true;
         auto* codec{ffcodec(m_decoder.GetCodec())};
         if (const int ret = codec->cb.decode(m_codec_context, m_temp_frame->GetFrame(),
@@ -409,7 +427,7 @@ std::shared_ptr<Frame> DecoderContext::ReceiveFrame() {
     // Android can randomly crash when calling decode directly, so skip.
     // TODO update ffmpeg and hope that fixes it.
 #ifndef ANDROID
-    if (!m_codec_context->hw_device_ctx && m_codec_context->codec_id == AV_CODEC_ID_H264) {
+    if (UsingDirectDecode()) {
         m_decode_order = true;
         auto* codec{ffcodec(m_decoder.GetCodec())};
         int ret{0};
@@ -430,10 +448,17 @@ std::shared_ptr<Frame> DecoderContext::ReceiveFrame() {
     } else
 #endif
     {
+        // Output frames are handed to the caller, allocate a new one unless the last receive failed
+        if (!m_temp_frame) {
+            m_temp_frame = std::make_shared<Frame>();
+        }
 
         const auto ReceiveImpl = [&](AVFrame* frame) {
             if (const int ret = avcodec_receive_frame(m_codec_context, frame); ret < 0) {
-                LOG_ERROR(HW_GPU, "avcodec_receive_frame error: {}", AVError(ret));
+                // With frame threading, frames are not ready until enough packets were sent
+                if (!m_frame_threading || (ret != AVERROR(EAGAIN) && ret != AVERROR_EOF)) {
+                    LOG_ERROR(HW_GPU, "avcodec_receive_frame error: {}", AVError(ret));
+                }
                 return false;
             }
 
@@ -454,6 +479,7 @@ std::shared_ptr<Frame> DecoderContext::ReceiveFrame() {
                                                          intermediate_frame.GetFrame(), 0);
                 ret < 0) {
                 LOG_ERROR(HW_GPU, "av_hwframe_transfer_data error: {}", AVError(ret));
+                m_temp_frame.reset();
                 return {};
             }
         } else {
@@ -185,12 +185,20 @@ public:
         return m_decode_order;
     }
 
+    bool UsingFrameThreading() const {
+        return m_frame_threading;
+    }
+
 private:
+    /// Returns true when packets are decoded by calling the codec directly, in decode order
+    bool UsingDirectDecode() const;
+
     const Decoder& m_decoder;
     AVCodecContext* m_codec_context{};
     s32 m_got_frame{};
     std::shared_ptr<Frame> m_temp_frame{};
     bool m_decode_order{};
+    bool m_frame_threading{};
 };
 
 class DecodeApi {
@@ -208,6 +216,11 @@ public:
         return m_decoder_context->UsingDecodeOrder();
     }
 
+    /// Returns true when frames may be output several packets after they were sent
+    bool UsingFrameThreading() const {
+        return m_decoder_context->UsingFrameThreading();
+    }
+
     bool SendPacket(std::span<const u8> packet_data);
     std::shared_ptr<Frame> ReceiveFrame();
 
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
@@ -38,29 +41,40 @@ public:
         std::scoped_lock l{m_mutex};
         m_presentation_order.erase(fd);
         m_decode_order.erase(fd);
+        m_pending_decodes.erase(fd);
+        m_cv.notify_all();
     }
 
-    s32 VicFindNvdecFdFromOffset(u64 search_offset) {
+    /// Announces a frame submitted to the decoder thread of an nvdec, which will push its output
+    void BeginDecode(s32 fd) {
         std::scoped_lock l{m_mutex};
-        // Vic does not know which nvdec is producing frames for it, so search all the fds here for
-        // the given offset.
-        for (auto& map : m_presentation_order) {
-            for (auto& [offset, frame] : map.second) {
-                if (offset == search_offset) {
-                    return map.first;
-                }
-            }
-        }
+        ++m_pending_decodes[fd];
+    }
 
-        for (auto& map : m_decode_order) {
-            for (auto& [offset, frame] : map.second) {
-                if (offset == search_offset) {
-                    return map.first;
-                }
-            }
+    /// Marks submitted frames of an nvdec as decoded, after their output was pushed
+    void EndDecode(s32 fd, size_t count = 1) {
+        std::scoped_lock l{m_mutex};
+        auto it = m_pending_decodes.find(fd);
+        if (it == m_pending_decodes.end()) {
+            return;
         }
+        it->second -= std::min(it->second, count);
+        if (it->second == 0) {
+            m_pending_decodes.erase(it);
+        }
+        m_cv.notify_all();
+    }
 
-        return -1;
+    s32 VicFindNvdecFdFromOffset(u64 search_offset) {
+        std::unique_lock l{m_mutex};
+        // Vic does not know which nvdec is producing frames for it, so search all the fds here for
+        // the given offset. Frames still being decoded may hold it, so wait for them.
+        s32 fd = -1;
+        m_cv.wait_for(l, MaxFrameWait, [&] {
+            fd = FindNvdecFdLocked(search_offset);
+            return fd != -1 || m_pending_decodes.empty();
+        });
+        return fd;
     }
 
     void PushPresentOrder(s32 fd, u64 offset, std::shared_ptr<FFmpeg::Frame>&& frame) {
@@ -70,6 +84,7 @@ public:
             return;
         }
         map->second.emplace_back(offset, std::move(frame));
+        m_cv.notify_all();
     }
 
     void PushDecodeOrder(s32 fd, u64 offset, std::shared_ptr<FFmpeg::Frame>&& frame) {
@@ -79,6 +94,7 @@ public:
             return;
         }
         map->second.insert_or_assign(offset, std::move(frame));
+        m_cv.notify_all();
     }
 
     std::shared_ptr<FFmpeg::Frame> GetFrame(s32 fd, u64 offset) {
@@ -86,7 +102,12 @@ public:
             return {};
         }
 
-        std::scoped_lock l{m_mutex};
+        std::unique_lock l{m_mutex};
+        // Wait until the frame is ready, or the nvdec has no frames left in flight
+        m_cv.wait_for(l, MaxFrameWait, [&] {
+            return HasFrameLocked(fd, offset) || !m_pending_decodes.contains(fd);
+        });
+
         auto present_map = m_presentation_order.find(fd);
         if (present_map != m_presentation_order.end() && present_map->second.size() > 0) {
             return GetPresentOrderLocked(fd);
@@ -101,6 +122,37 @@ public:
     }
 
 private:
+    // Frame threaded decoders only output a frame once later packets arrive, which a game may
+    // only submit after VIC consumed the frame. Give up on it instead of blocking the channel.
+    static constexpr std::chrono::milliseconds MaxFrameWait{100};
+
+    s32 FindNvdecFdLocked(u64 search_offset) const {
+        for (auto& map : m_presentation_order) {
+            for (auto& [offset, frame] : map.second) {
+                if (offset == search_offset) {
+                    return map.first;
+                }
+            }
+        }
+
+        for (auto& map : m_decode_order) {
+            if (map.second.contains(search_offset)) {
+                return map.first;
+            }
+        }
+
+        return -1;
+    }
+
+    bool HasFrameLocked(s32 fd, u64 offset) const {
+        auto present_map = m_presentation_order.find(fd);
+        if (present_map != m_presentation_order.end() && present_map->second.size() > 0) {
+            return true;
+        }
+        auto decode_map = m_decode_order.find(fd);
+        return decode_map != m_decode_order.end() && decode_map->second.contains(offset);
+    }
+
     std::shared_ptr<FFmpeg::Frame> GetPresentOrderLocked(s32 fd) {
         auto map = m_presentation_order.find(fd);
         if (map == m_presentation_order.end() || map->second.size() == 0) {
@@ -126,8 +178,10 @@ private:
     using FramePtr = std::shared_ptr<FFmpeg::Frame>;
 
     std::mutex m_mutex{};
+    std::condition_variable m_cv;
     std::unordered_map<s32, std::deque<std::pair<u64, FramePtr>>> m_presentation_order;
     std::unordered_map<s32, std::unordered_map<u64, FramePtr>> m_decode_order;
+    std::unordered_map<s32, size_t> m_pending_decodes;
 };
 
 enum class ChannelType : u32 {
@@ -25,6 +25,17 @@ struct ChannelState;
 }
 } // namespace Tegra
 
+namespace VideoCommon {
+struct ShaderCacheStatistics {
+    u64 lookups{};
+    u64 lookup_misses{};
+    /// Shaders removed because guest memory they were read from was written
+    u64 invalidations{};
+    /// Writes to a page holding shaders that did not overlap any of them
+    u64 false_invalidations{};
+};
+} // namespace VideoCommon
+
 namespace VideoCore {
 
 enum class LoadCallbackStage {
@@ -172,5 +183,10 @@ public:
     virtual bool HasDrawTransformFeedback() {
         return false;
     }
+
+    /// Returns the shader cache counters since the last call and resets them
+    [[nodiscard]] virtual VideoCommon::ShaderCacheStatistics GetAndResetShaderCacheStatistics() {
+        return {};
+    }
 };
 } // namespace VideoCore
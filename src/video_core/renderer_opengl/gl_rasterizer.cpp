@@ -152,9 +152,14 @@ void RasterizerOpenGL::SyncVertexInstances() {
 
 void RasterizerOpenGL::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                          const VideoCore::DiskResourceLoadCallback& callback) {
+    texture_cache.LoadDiskResources(title_id);
     shader_cache.LoadDiskResources(title_id, stop_loading, callback);
 }
 
+VideoCommon::ShaderCacheStatistics RasterizerOpenGL::GetAndResetShaderCacheStatistics() {
+    return shader_cache.GetAndResetStatistics();
+}
+
 void RasterizerOpenGL::Clear(u32 layer_count) {
     MICROPROFILE_SCOPE(OpenGL_Clears);
 
@@ -258,6 +258,9 @@ FormatInfo SurfaceFormat(const Device& device, FormatType format_type, bool with
         case Settings::AstcRecompression::Bc3:
             tuple.format = is_srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
             break;
+        case Settings::AstcRecompression::Bc7:
+            tuple.format = is_srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+            break;
         }
     }
     // Transcode on hardware that doesn't support BCn natively
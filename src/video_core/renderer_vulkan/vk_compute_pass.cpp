@@ -322,6 +322,7 @@ std::pair<VkBuffer, VkDeviceSize> Uint8Pass::Assemble(u32 num_vertices, VkBuffer
     compute_pass_descriptor_queue.AddBuffer(src_buffer, src_offset, num_vertices);
     compute_pass_descriptor_queue.AddBuffer(staging.buffer, staging.offset, staging_size);
     const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
+    compute_pass_descriptor_queue.CountSetUpdate();
 
     scheduler.RequestOutsideRenderPassOperationContext();
     scheduler.Record([this, descriptor_data, num_vertices](vk::CommandBuffer cmdbuf) {
@@ -380,6 +381,7 @@ std::pair<VkBuffer, VkDeviceSize> QuadIndexedPass::Assemble(
     compute_pass_descriptor_queue.AddBuffer(src_buffer, src_offset, input_size);
     compute_pass_descriptor_queue.AddBuffer(staging.buffer, staging.offset, staging_size);
     const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
+    compute_pass_descriptor_queue.CountSetUpdate();
 
     scheduler.RequestOutsideRenderPassOperationContext();
     scheduler.Record([this, descriptor_data, num_tri_vertices, base_vertex, index_shift,
@@ -421,6 +423,7 @@ void ConditionalRenderingResolvePass::Resolve(VkBuffer dst_buffer, VkBuffer src_
     compute_pass_descriptor_queue.AddBuffer(src_buffer, src_offset, compare_size);
     compute_pass_descriptor_queue.AddBuffer(dst_buffer, 0, sizeof(u32));
     const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
+    compute_pass_descriptor_queue.CountSetUpdate();
 
     scheduler.RequestOutsideRenderPassOperationContext();
     scheduler.Record([this, descriptor_data](vk::CommandBuffer cmdbuf) {
@@ -478,6 +481,7 @@ void QueriesPrefixScanPass::Run(VkBuffer accumulation_buffer, VkBuffer dst_buffe
         compute_pass_descriptor_queue.AddBuffer(dst_buffer, 0, number_of_sums * sizeof(u64));
         compute_pass_descriptor_queue.AddBuffer(accumulation_buffer, 0, sizeof(u64));
         const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
+        compute_pass_descriptor_queue.CountSetUpdate();
         size_t used_offset = offset;
         offset += runs_to_do;
 
@@ -585,6 +589,7 @@ void ASTCDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
                                                 image.guest_size_bytes - swizzle.buffer_offset);
         compute_pass_descriptor_queue.AddImage(image.StorageImageView(swizzle.level));
         const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
+        compute_pass_descriptor_queue.CountSetUpdate();
 
         // To unswizzle the ASTC data
         const auto params = MakeBlockLinearSwizzle2DParams(swizzle, image.info);
@@ -691,6 +696,7 @@ void MSAACopyPass::CopyImage(Image& dst_image, Image& src_image,
         compute_pass_descriptor_queue.AddImage(
             dst_image.StorageImageView(copy.dst_subresource.base_level));
         const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
+        compute_pass_descriptor_queue.CountSetUpdate();
 
         const Common::Vec3<u32> num_dispatches = {
             Common::DivCeil(copy.extent.width, 8U),
@@ -10,10 +10,12 @@
 #include "video_core/renderer_vulkan/pipeline_helper.h"
 
 #include "common/bit_field.h"
+#include "common/cityhash.h"
 #include "video_core/renderer_vulkan/maxwell_to_vk.h"
 #include "video_core/renderer_vulkan/pipeline_statistics.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/renderer_vulkan/vk_render_pass_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
@@ -174,6 +176,31 @@ bool Passes(const std::array<vk::ShaderModule, NUM_STAGES>& modules,
     return true;
 }
 
+// Hashes the state consumed by the shader stage libraries. Vertex input and color blending state,
+// and the state that changes the generated shaders, are left out.
+u64 MakeLibraryKey(const FixedPipelineState& state, u64 shader_hash) {
+    struct LibraryKeyData {
+        u64 shader_hash;
+        u32 raw1;
+        u32 raw2;
+        u32 dynamic_raw1;
+        u32 dynamic_raw2;
+        std::array<u8, Maxwell::NumRenderTargets> color_formats;
+        std::array<u16, Maxwell::NumViewports> viewport_swizzles;
+    };
+    static_assert(std::has_unique_object_representations_v<LibraryKeyData>);
+    const LibraryKeyData data{
+        .shader_hash = shader_hash,
+        .raw1 = state.raw1,
+        .raw2 = state.raw2,
+        .dynamic_raw1 = state.dynamic_state.raw1,
+        .dynamic_raw2 = state.extended_dynamic_state ? 0 : state.dynamic_state.raw2,
+        .color_formats = state.color_formats,
+        .viewport_swizzles = state.viewport_swizzles,
+    };
+    return Common::CityHash64(reinterpret_cast<const char*>(&data), sizeof(data));
+}
+
 using ConfigureFuncPtr = void (*)(GraphicsPipeline*, bool);
 
 template <typename Spec, typename... Specs>
@@ -234,17 +261,28 @@ ConfigureFuncPtr ConfigureFunc(const std::array<vk::ShaderModule, NUM_STAGES>& m
 }
 } // Anonymous namespace
 
+void GraphicsPipelineLibraryCache::Report(u64 fast_linked_draws, u64 optimized_draws) {
+    std::scoped_lock lock{mutex};
+    LOG_INFO(Render_Vulkan,
+             "Graphics pipeline libraries: {} built, {} reused; pipelines: {} fast-linked, {} "
+             "optimized; draws: {} fast-linked, {} optimized",
+             num_built, num_reused, num_fast_linked.load(std::memory_order::relaxed),
+             num_optimized.load(std::memory_order::relaxed), fast_linked_draws, optimized_draws);
+}
+
 GraphicsPipeline::GraphicsPipeline(
     Scheduler& scheduler_, BufferCache& buffer_cache_, TextureCache& texture_cache_,
     vk::PipelineCache& pipeline_cache_, VideoCore::ShaderNotify* shader_notify,
     const Device& device_, DescriptorPool& descriptor_pool,
     GuestDescriptorQueue& guest_descriptor_queue_, Common::ThreadWorker* worker_thread,
     PipelineStatistics* pipeline_statistics, RenderPassCache& render_pass_cache,
-    const GraphicsPipelineCacheKey& key_, std::array<vk::ShaderModule, NUM_STAGES> stages,
+    GraphicsPipelineLibraryCache* library_cache_, const GraphicsPipelineCacheKey& key_,
+    u64 shader_hash, std::array<vk::ShaderModule, NUM_STAGES> stages,
     const std::array<const Shader::Info*, NUM_STAGES>& infos)
     : key{key_}, device{device_}, texture_cache{texture_cache_}, buffer_cache{buffer_cache_},
       pipeline_cache(pipeline_cache_), scheduler{scheduler_},
-      guest_descriptor_queue{guest_descriptor_queue_}, spv_modules{std::move(stages)} {
+      guest_descriptor_queue{guest_descriptor_queue_}, spv_modules{std::move(stages)},
+      library_cache{library_cache_}, library_key{MakeLibraryKey(key.state, shader_hash)} {
     if (shader_notify) {
         shader_notify->MarkShaderBuilding();
     }
@@ -258,7 +296,8 @@ GraphicsPipeline::GraphicsPipeline(
         std::ranges::copy(info->constant_buffer_used_sizes, uniform_buffer_sizes[stage].begin());
         num_textures += Shader::NumDescriptors(info->texture_descriptors);
     }
-    auto func{[this, shader_notify, &render_pass_cache, &descriptor_pool, pipeline_statistics] {
+    auto func{[this, shader_notify, &render_pass_cache, &descriptor_pool, pipeline_statistics,
+                worker_thread] {
         DescriptorLayoutBuilder builder{MakeBuilder(device, stage_infos)};
         uses_push_descriptor = builder.CanUsePushDescriptor();
         descriptor_set_layout = builder.CreateDescriptorSetLayout(uses_push_descriptor);
@@ -272,19 +311,39 @@ GraphicsPipeline::GraphicsPipeline(
 
         const VkRenderPass render_pass{render_pass_cache.Get(MakeRenderPassKey(key.state))};
         Validate();
-        MakePipeline(render_pass);
-        if (pipeline_statistics) {
-            pipeline_statistics->Collect(*pipeline);
+        if (library_cache) {
+            fast_linked_pipeline = MakePipeline(render_pass, true);
+            bound_pipeline.store(*fast_linked_pipeline, std::memory_order::release);
+            library_cache->MarkFastLinked();
+        } else {
+            pipeline = MakePipeline(render_pass, false);
+            bound_pipeline.store(*pipeline, std::memory_order::release);
+            is_optimized = true;
+            if (pipeline_statistics) {
+                pipeline_statistics->Collect(*pipeline);
+            }
         }
-
-        std::scoped_lock lock{build_mutex};
-        is_built = true;
-        build_condvar.notify_one();
-        if (shader_notify) {
-            shader_notify->MarkShaderComplete();
+        {
+            std::scoped_lock lock{build_mutex};
+            is_built = true;
+            build_condvar.notify_one();
+            if (shader_notify) {
+                shader_notify->MarkShaderComplete();
+            }
+        }
+        if (library_cache && worker_thread) {
+            // Draws use the fast-linked pipeline until the optimized one replaces it
+            worker_thread->QueueWork([this, render_pass] {
+                pipeline = MakePipeline(render_pass, false);
+                bound_pipeline.store(*pipeline, std::memory_order::release);
+                is_optimized = true;
+                library_cache->MarkOptimized();
+            });
         }
     }};
-    if (worker_thread) {
+    // Linking cached libraries is cheap enough to do right away, without skipping the draw
+    const bool is_cached{library_cache && library_cache->Contains(library_key)};
+    if (worker_thread && !is_cached) {
         worker_thread->QueueWork(std::move(func));
     } else {
         func();
@@ -502,13 +561,14 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
     const bool is_rescaling{texture_cache.IsRescaling()};
     const bool update_rescaling{scheduler.UpdateRescaling(is_rescaling)};
     const bool bind_pipeline{scheduler.UpdateGraphicsPipeline(this)};
-    const void* const descriptor_data{guest_descriptor_queue.UpdateData()};
+    const std::span descriptor_data{guest_descriptor_queue.UpdateSpan()};
     scheduler.Record([this, descriptor_data, bind_pipeline, rescaling_data = rescaling.Data(),
                       is_rescaling, update_rescaling,
                       uses_render_area = render_area.uses_render_area,
                       render_area_data = render_area.words](vk::CommandBuffer cmdbuf) {
         if (bind_pipeline) {
-            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline);
+            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                bound_pipeline.load(std::memory_order::acquire));
         }
         cmdbuf.PushConstants(*pipeline_layout, VK_SHADER_STAGE_ALL_GRAPHICS,
                              RESCALING_LAYOUT_WORDS_OFFSET, sizeof(rescaling_data),
@@ -530,18 +590,30 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
         }
         if (uses_push_descriptor) {
             cmdbuf.PushDescriptorSetWithTemplateKHR(*descriptor_update_template, *pipeline_layout,
-                                                    0, descriptor_data);
+                                                    0, descriptor_data.data());
+            guest_descriptor_queue.CountWrite(DescriptorWrite::Push, descriptor_data.size());
+            return;
+        }
+        MasterSemaphore& master_semaphore{scheduler.GetMasterSemaphore()};
+        VkDescriptorSet descriptor_set{
+            descriptor_set_reuse.Find(master_semaphore, descriptor_data)};
+        if (descriptor_set) {
+            guest_descriptor_queue.CountWrite(DescriptorWrite::Reuse, descriptor_data.size());
         } else {
-            const VkDescriptorSet descriptor_set{descriptor_allocator.Commit()};
+            const u64 tick{master_semaphore.CurrentTick()};
+            descriptor_set = descriptor_allocator.Commit();
             const vk::Device& dev{device.GetLogical()};
-            dev.UpdateDescriptorSet(descriptor_set, *descriptor_update_template, descriptor_data);
-            cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline_layout, 0,
-                                      descriptor_set, nullptr);
+            dev.UpdateDescriptorSet(descriptor_set, *descriptor_update_template,
+                                    descriptor_data.data());
+            descriptor_set_reuse.Remember(descriptor_set, tick, descriptor_data);
+            guest_descriptor_queue.CountWrite(DescriptorWrite::Update, descriptor_data.size());
         }
+        cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline_layout, 0,
+                                  descriptor_set, nullptr);
     });
 }
 
-void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
+vk::Pipeline GraphicsPipeline::MakePipeline(VkRenderPass render_pass, bool fast_link) {
     FixedPipelineState::DynamicState dynamic{};
     if (!key.state.extended_dynamic_state) {
         dynamic = key.state.dynamic_state;
@@ -875,27 +947,104 @@ void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
         */
     }
     VkPipelineCreateFlags flags{};
-    if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
+    if (device.IsKhrPipelineExecutablePropertiesEnabled() && !fast_link) {
         flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
     }
-    pipeline = device.GetLogical().CreateGraphicsPipeline(
+    const VkGraphicsPipelineCreateInfo pipeline_ci{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = flags,
+        .stageCount = static_cast<u32>(shader_stages.size()),
+        .pStages = shader_stages.data(),
+        .pVertexInputState = &vertex_input_ci,
+        .pInputAssemblyState = &input_assembly_ci,
+        .pTessellationState = &tessellation_ci,
+        .pViewportState = &viewport_ci,
+        .pRasterizationState = &rasterization_ci,
+        .pMultisampleState = &multisample_ci,
+        .pDepthStencilState = &depth_stencil_ci,
+        .pColorBlendState = &color_blend_ci,
+        .pDynamicState = &dynamic_state_ci,
+        .layout = *pipeline_layout,
+        .renderPass = render_pass,
+        .subpass = 0,
+        .basePipelineHandle = nullptr,
+        .basePipelineIndex = 0,
+    };
+    if (fast_link) {
+        return LinkLibraries(pipeline_ci);
+    }
+    return device.GetLogical().CreateGraphicsPipeline(pipeline_ci, *pipeline_cache);
+}
+
+vk::Pipeline GraphicsPipeline::LinkLibraries(const VkGraphicsPipelineCreateInfo& pipeline_ci) {
+    const auto make_library{[&](VkGraphicsPipelineLibraryFlagsEXT library_flags) {
+        // State outside of the library subset is ignored, but shader stages must be filtered
+        static_vector<VkPipelineShaderStageCreateInfo, 5> stages;
+        for (const auto& stage : std::span(pipeline_ci.pStages, pipeline_ci.stageCount)) {
+            const bool is_fragment{stage.stage == VK_SHADER_STAGE_FRAGMENT_BIT};
+            const VkGraphicsPipelineLibraryFlagsEXT stage_library{
+                is_fragment ? VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT
+                            : VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT};
+            if ((library_flags & stage_library) != 0) {
+                stages.push_back(stage);
+            }
+        }
+        const VkGraphicsPipelineLibraryCreateInfoEXT library_ci{
+            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+            .pNext = nullptr,
+            .flags = library_flags,
+        };
+        VkGraphicsPipelineCreateInfo ci{pipeline_ci};
+        ci.pNext = &library_ci;
+        ci.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+        ci.stageCount = static_cast<u32>(stages.size());
+        ci.pStages = stages.empty() ? nullptr : stages.data();
+        return device.GetLogical().CreateGraphicsPipeline(ci, *pipeline_cache);
+    }};
+    const auto& shader_libraries{library_cache->Get(library_key, [&] {
+        return GraphicsPipelineLibraryCache::Libraries{
+            .pre_rasterization =
+                make_library(VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT),
+            .fragment_shader = make_library(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT),
+        };
+    })};
+    vertex_input_library =
+        make_library(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT);
+    fragment_output_library =
+        make_library(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT);
+
+    const std::array libraries{
+        *vertex_input_library,
+        *shader_libraries.pre_rasterization,
+        *shader_libraries.fragment_shader,
+        *fragment_output_library,
+    };
+    const VkPipelineLibraryCreateInfoKHR link_ci{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+        .pNext = nullptr,
+        .libraryCount = static_cast<u32>(libraries.size()),
+        .pLibraries = libraries.data(),
+    };
+    // Linking without VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT is the fast path
+    return device.GetLogical().CreateGraphicsPipeline(
         {
             .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = flags,
-            .stageCount = static_cast<u32>(shader_stages.size()),
-            .pStages = shader_stages.data(),
-            .pVertexInputState = &vertex_input_ci,
-            .pInputAssemblyState = &input_assembly_ci,
-            .pTessellationState = &tessellation_ci,
-            .pViewportState = &viewport_ci,
-            .pRasterizationState = &rasterization_ci,
-            .pMultisampleState = &multisample_ci,
-            .pDepthStencilState = &depth_stencil_ci,
-            .pColorBlendState = &color_blend_ci,
-            .pDynamicState = &dynamic_state_ci,
+            .pNext = &link_ci,
+            .flags = 0,
+            .stageCount = 0,
+            .pStages = nullptr,
+            .pVertexInputState = nullptr,
+            .pInputAssemblyState = nullptr,
+            .pTessellationState = nullptr,
+            .pViewportState = nullptr,
+            .pRasterizationState = nullptr,
+            .pMultisampleState = nullptr,
+            .pDepthStencilState = nullptr,
+            .pColorBlendState = nullptr,
+            .pDynamicState = nullptr,
             .layout = *pipeline_layout,
-            .renderPass = render_pass,
+            .renderPass = pipeline_ci.renderPass,
             .subpass = 0,
             .basePipelineHandle = nullptr,
             .basePipelineIndex = 0,
@@ -9,6 +9,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <type_traits>
+#include <unordered_map>
 
 #include "common/thread_worker.h"
 #include "shader_recompiler/shader_info.h"
@@ -17,6 +18,7 @@
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
+#include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
 namespace VideoCore {
@@ -65,6 +67,64 @@ class RescalingPushConstant;
 class RenderAreaPushConstant;
 class Scheduler;
 
+/**
+ * Shader stages of graphics pipelines compiled as pipeline libraries.
+ *
+ * Libraries are keyed by the compiled shaders and the state consumed by the shader stages, so
+ * pipelines that only differ in vertex input or color blending state share them. Such pipelines
+ * are fast-linked from the cached libraries when they are first used, and replaced by optimized
+ * monolithic pipelines built in the background.
+ */
+class GraphicsPipelineLibraryCache {
+public:
+    struct Libraries {
+        vk::Pipeline pre_rasterization;
+        vk::Pipeline fragment_shader;
+    };
+
+    [[nodiscard]] bool Contains(u64 key) {
+        std::scoped_lock lock{mutex};
+        return libraries.contains(key);
+    }
+
+    /// Returns the libraries of a key, building them when they are not cached yet
+    template <typename Func>
+    const Libraries& Get(u64 key, Func&& build) {
+        {
+            std::scoped_lock lock{mutex};
+            if (const auto it = libraries.find(key); it != libraries.end()) {
+                ++num_reused;
+                return it->second;
+            }
+        }
+        // Build without holding the lock, another thread may have built the same libraries
+        Libraries built{build()};
+        std::scoped_lock lock{mutex};
+        const auto [it, is_new] = libraries.try_emplace(key, std::move(built));
+        ++(is_new ? num_built : num_reused);
+        return it->second;
+    }
+
+    void MarkFastLinked() noexcept {
+        num_fast_linked.fetch_add(1, std::memory_order::relaxed);
+    }
+
+    void MarkOptimized() noexcept {
+        num_optimized.fetch_add(1, std::memory_order::relaxed);
+    }
+
+    /// Logs how many pipelines were fast-linked and optimized, with the given draw counts
+    void Report(u64 fast_linked_draws, u64 optimized_draws);
+
+private:
+    std::mutex mutex;
+    std::unordered_map<u64, Libraries> libraries;
+    u64 num_built{};
+    u64 num_reused{};
+    std::atomic<u64> num_fast_linked{};
+    std::atomic<u64> num_optimized{};
+};
+
 class GraphicsPipeline {
     static constexpr size_t NUM_STAGES = Tegra::Engines::Maxwell3D::Regs::MaxShaderStage;
 
@@ -75,7 +135,8 @@ public:
         const Device& device, DescriptorPool& descriptor_pool,
         GuestDescriptorQueue& guest_descriptor_queue, Common::ThreadWorker* worker_thread,
         PipelineStatistics* pipeline_statistics, RenderPassCache& render_pass_cache,
-        const GraphicsPipelineCacheKey& key, std::array<vk::ShaderModule, NUM_STAGES> stages,
+        GraphicsPipelineLibraryCache* library_cache, const GraphicsPipelineCacheKey& key,
+        u64 shader_hash, std::array<vk::ShaderModule, NUM_STAGES> stages,
         const std::array<const Shader::Info*, NUM_STAGES>& infos);
 
     GraphicsPipeline& operator=(GraphicsPipeline&&) noexcept = delete;
@@ -103,6 +164,11 @@ public:
         return is_built.load(std::memory_order::relaxed);
     }
 
+    /// Returns true when the pipeline is not fast-linked, or its optimized version replaced it
+    [[nodiscard]] bool IsOptimized() const noexcept {
+        return is_optimized.load(std::memory_order::relaxed);
+    }
+
     template <typename Spec>
     static auto MakeConfigureSpecFunc() {
         return [](GraphicsPipeline* pl, bool is_indexed) { pl->ConfigureImpl<Spec>(is_indexed); };
@@ -120,7 +186,9 @@ private:
     void ConfigureDraw(const RescalingPushConstant& rescaling,
                        const RenderAreaPushConstant& render_are);
 
-    void MakePipeline(VkRenderPass render_pass);
+    vk::Pipeline MakePipeline(VkRenderPass render_pass, bool fast_link);
+
+    vk::Pipeline LinkLibraries(const VkGraphicsPipelineCreateInfo& pipeline_ci);
 
     void Validate();
 
@@ -148,13 +216,24 @@ private:
 
     vk::DescriptorSetLayout descriptor_set_layout;
     DescriptorAllocator descriptor_allocator;
+    DescriptorSetReuse descriptor_set_reuse;
     vk::PipelineLayout pipeline_layout;
     vk::DescriptorUpdateTemplate descriptor_update_template;
     vk::Pipeline pipeline;
 
+    GraphicsPipelineLibraryCache* library_cache{};
+    u64 library_key{};
+    vk::Pipeline vertex_input_library;
+    vk::Pipeline fragment_output_library;
+    vk::Pipeline fast_linked_pipeline;
+
+    /// Pipeline bound by draws, the fast-linked pipeline until the optimized one is built
+    std::atomic<VkPipeline> bound_pipeline{};
+
     std::condition_variable build_condvar;
     std::mutex build_mutex;
     std::atomic_bool is_built{false};
+    std::atomic_bool is_optimized{false};
     bool uses_push_descriptor{false};
 };
 
@@ -182,7 +182,8 @@ RasterizerVulkan::RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra
     : gpu{gpu_}, device_memory{device_memory_}, device{device_},
       memory_allocator{memory_allocator_}, state_tracker{state_tracker_}, scheduler{scheduler_},
       staging_pool(device, memory_allocator, scheduler), descriptor_pool(device, scheduler),
-      guest_descriptor_queue(device, scheduler), compute_pass_descriptor_queue(device, scheduler),
+      guest_descriptor_queue(device, scheduler, "Guest"),
+      compute_pass_descriptor_queue(device, scheduler, "Compute pass"),
       blit_image(device, scheduler, state_tracker, descriptor_pool), render_pass_cache(device),
       texture_cache_runtime{
           device,     scheduler,         memory_allocator, staging_pool,
@@ -214,6 +215,7 @@ void RasterizerVulkan::PrepareDraw(bool is_indexed, Func&& draw_func) {
     FlushWork();
     gpu_memory->FlushCaching();
 
+    scheduler.MarkDrawStart(CanSplitRenderPass());
     query_cache.NotifySegment(true);
 
     GraphicsPipeline* const pipeline{pipeline_cache.CurrentGraphicsPipeline()};
@@ -307,6 +309,7 @@ void RasterizerVulkan::DrawTexture() {
     };
     FlushWork();
 
+    scheduler.MarkDrawStart(CanSplitRenderPass());
     query_cache.NotifySegment(true);
 
     std::scoped_lock l{texture_cache.mutex};
@@ -355,6 +358,7 @@ void RasterizerVulkan::Clear(u32 layer_count) {
     FlushWork();
     gpu_memory->FlushCaching();
 
+    scheduler.MarkDrawStart(CanSplitRenderPass());
     query_cache.NotifySegment(true);
     query_cache.CounterEnable(VideoCommon::QueryType::ZPassPixelCount64,
                               maxwell3d->regs.zpass_pixel_count_enable);
@@ -841,9 +845,14 @@ std::optional<FramebufferTextureInfo> RasterizerVulkan::AccelerateDisplay(
 
 void RasterizerVulkan::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                          const VideoCore::DiskResourceLoadCallback& callback) {
+    texture_cache.LoadDiskResources(title_id);
     pipeline_cache.LoadDiskResources(title_id, stop_loading, callback);
 }
 
+VideoCommon::ShaderCacheStatistics RasterizerVulkan::GetAndResetShaderCacheStatistics() {
+    return pipeline_cache.GetAndResetStatistics();
+}
+
 void RasterizerVulkan::FlushWork() {
 #ifdef ANDROID
     static constexpr u32 DRAWS_TO_DISPATCH = 1024;
@@ -926,6 +935,17 @@ bool AccelerateDMA::BufferToImage(const Tegra::DMA::ImageCopy& copy_info,
     return DmaBufferImageCopy<true>(copy_info, buffer_operand, image_operand);
 }
 
+bool RasterizerVulkan::CanSplitRenderPass() const {
+    // Queries, transform feedback and conditional rendering can't span secondary command buffers
+    const auto& regs = maxwell3d->regs;
+    const bool is_rendering_unconditional =
+        regs.render_enable_override == Maxwell::RenderEnable::Override::AlwaysRender ||
+        (regs.render_enable_override == Maxwell::RenderEnable::Override::UseRenderEnable &&
+         regs.render_enable.mode == Maxwell::RenderEnable::Mode::True);
+    return regs.zpass_pixel_count_enable == 0 && regs.transform_feedback_enabled == 0 &&
+           is_rendering_unconditional;
+}
+
 void RasterizerVulkan::UpdateDynamicStates() {
     auto& regs = maxwell3d->regs;
     UpdateViewportsState(regs);
@@ -127,6 +127,7 @@ public:
                                   std::span<const u8> memory) override;
     void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback) override;
+    VideoCommon::ShaderCacheStatistics GetAndResetShaderCacheStatistics() override;
 
     void InitializeChannel(Tegra::Control::ChannelState& channel) override;
 
@@ -150,6 +151,9 @@ private:
 
     void FlushWork();
 
+    /// Returns true when the render pass can be split before the next draw
+    bool CanSplitRenderPass() const;
+
     void UpdateDynamicStates();
 
     void HandleTransformFeedback();
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -8,7 +10,9 @@
 
 #include "video_core/renderer_vulkan/vk_query_cache.h"
 
+#include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #include "video_core/renderer_vulkan/vk_command_pool.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
@@ -22,6 +26,67 @@ namespace Vulkan {
 
 MICROPROFILE_DECLARE(Vulkan_WaitForWorker);
 
+namespace {
+
+/// Number of draws recorded in a render pass segment before a new segment is started
+constexpr u32 DRAWS_PER_SEGMENT = 64;
+
+/// Render passes are only recorded in parallel when they have this many segments, the first
+/// segment is always recorded inline
+constexpr u32 MIN_PARALLEL_SEGMENTS = 3;
+
+void RecordBeginRenderPass(vk::CommandBuffer cmdbuf, VkRenderPass renderpass,
+                           VkFramebuffer framebuffer_handle, VkExtent2D render_area,
+                           VkSubpassContents contents) {
+    const VkRenderPassBeginInfo renderpass_bi{
+        .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+        .pNext = nullptr,
+        .renderPass = renderpass,
+        .framebuffer = framebuffer_handle,
+        .renderArea =
+            {
+                .offset = {.x = 0, .y = 0},
+                .extent = render_area,
+            },
+        .clearValueCount = 0,
+        .pClearValues = nullptr,
+    };
+    cmdbuf.BeginRenderPass(renderpass_bi, contents);
+}
+
+void RecordEndRenderPass(vk::CommandBuffer cmdbuf, size_t num_images,
+                         const std::array<VkImage, 9>& images,
+                         const std::array<VkImageSubresourceRange, 9>& ranges) {
+    std::array<VkImageMemoryBarrier, 9> barriers;
+    for (size_t i = 0; i < num_images; ++i) {
+        barriers[i] = VkImageMemoryBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask =
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+                             VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                             VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = images[i],
+            .subresourceRange = ranges[i],
+        };
+    }
+    cmdbuf.EndRenderPass();
+    cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                               VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                           VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, nullptr,
+                           vk::Span(barriers.data(), num_images));
+}
+
+} // Anonymous namespace
+
 void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
                                          vk::CommandBuffer upload_cmdbuf) {
     auto command = first;
@@ -35,6 +100,26 @@ void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
     command_offset = 0;
     first = nullptr;
     last = nullptr;
+    renderpass_begin.reset();
+    renderpass_end.reset();
+    renderpass_end_command = nullptr;
+    draw_start = nullptr;
+    has_draw_start = false;
+    is_renderpass_part = false;
+    begins_segment = false;
+}
+
+void Scheduler::CommandChunk::ExecuteRenderPassCommands(vk::CommandBuffer cmdbuf,
+                                                        vk::CommandBuffer upload_cmdbuf) {
+    auto command = first;
+    while (command != renderpass_end_command) {
+        auto next = command->GetNext();
+        command->Execute(cmdbuf, upload_cmdbuf);
+        command->~Command();
+        command = next;
+    }
+    // The remaining commands were recorded after the render pass, ExecuteAll runs them
+    first = command;
 }
 
 Scheduler::Scheduler(const Device& device_, StateTracker& state_tracker_)
@@ -43,10 +128,35 @@ Scheduler::Scheduler(const Device& device_, StateTracker& state_tracker_)
       command_pool{std::make_unique<CommandPool>(*master_semaphore, device)} {
     AcquireNewChunk();
     AllocateWorkerCommandBuffer();
+    if (Settings::values.use_parallel_command_recording.GetValue()) {
+        const size_t num_threads = std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 2,
+                                                      MAX_RECORDING_THREADS);
+        recorder = std::make_unique<Common::StatefulThreadWorker<RecordingThread>>(
+            num_threads, "VulkanRecorder", [this] {
+                return RecordingThread{
+                    .command_pool = std::make_unique<CommandPool>(
+                        *master_semaphore, device, VK_COMMAND_BUFFER_LEVEL_SECONDARY),
+                    .statistics = &recording_statistics[num_recording_threads++],
+                };
+            });
+    }
     worker_thread = std::jthread([this](std::stop_token token) { WorkerThread(token); });
 }
 
-Scheduler::~Scheduler() = default;
+Scheduler::~Scheduler() {
+    if (!recorder) {
+        return;
+    }
+    LOG_INFO(Render_Vulkan, "{} render passes were recorded in parallel",
+             num_parallel_renderpasses.load(std::memory_order_relaxed));
+    for (size_t i = 0; i < num_recording_threads.load(); ++i) {
+        const RecordingStatistics& statistics = recording_statistics[i];
+        LOG_INFO(Render_Vulkan, "Recording thread {}: {} segments in {:.1f} ms", i,
+                 statistics.segments.load(std::memory_order_relaxed),
+                 static_cast<double>(statistics.recording_ns.load(std::memory_order_relaxed)) /
+                     1e6);
+    }
+}
 
 u64 Scheduler::Flush(VkSemaphore signal_semaphore, VkSemaphore wait_semaphore) {
     // When flushing, we only send data to the worker thread; no waiting is necessary.
@@ -65,6 +175,10 @@ void Scheduler::Finish(VkSemaphore signal_semaphore, VkSemaphore wait_semaphore)
 
 void Scheduler::WaitWorker() {
     MICROPROFILE_SCOPE(Vulkan_WaitForWorker);
+    if (recorder) {
+        // Segmented render passes are only recorded once they end
+        EndRenderPass();
+    }
     DispatchWork();
 
     // Ensure the queue is drained.
@@ -78,7 +192,7 @@ void Scheduler::WaitWorker() {
 }
 
 void Scheduler::DispatchWork() {
-    if (chunk->Empty()) {
+    if (chunk->Empty() && !chunk->IsRenderPassPart()) {
         return;
     }
     {
@@ -87,6 +201,13 @@ void Scheduler::DispatchWork() {
     }
     event_cv.notify_all();
     AcquireNewChunk();
+    if (recorder && state.renderpass) {
+        if (in_draw_setup) {
+            // Part of the draw setup was dispatched, it can't be moved out of the render pass
+            renderpass_splittable = false;
+        }
+        chunk->MarkRenderPassPart();
+    }
 }
 
 void Scheduler::RequestRenderpass(const Framebuffer* framebuffer) {
@@ -96,34 +217,59 @@ void Scheduler::RequestRenderpass(const Framebuffer* framebuffer) {
     if (renderpass == state.renderpass && framebuffer_handle == state.framebuffer &&
         render_area.width == state.render_area.width &&
         render_area.height == state.render_area.height) {
+        in_draw_setup = false;
         return;
     }
     EndRenderPass();
+    in_draw_setup = false;
+    if (recorder) {
+        // Keep the commands recorded before the render pass out of its chunks
+        DispatchWork();
+        chunk->MarkRenderPassBegin({
+            .renderpass = renderpass,
+            .framebuffer = framebuffer_handle,
+            .render_area = render_area,
+        });
+        renderpass_splittable = draw_can_split;
+        num_renderpass_segments = 1;
+        num_segment_draws = 0;
+    } else {
+        Record([renderpass, framebuffer_handle, render_area](vk::CommandBuffer cmdbuf) {
+            RecordBeginRenderPass(cmdbuf, renderpass, framebuffer_handle, render_area,
+                                  VK_SUBPASS_CONTENTS_INLINE);
+        });
+    }
     state.renderpass = renderpass;
     state.framebuffer = framebuffer_handle;
     state.render_area = render_area;
 
-    Record([renderpass, framebuffer_handle, render_area](vk::CommandBuffer cmdbuf) {
-        const VkRenderPassBeginInfo renderpass_bi{
-            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-            .pNext = nullptr,
-            .renderPass = renderpass,
-            .framebuffer = framebuffer_handle,
-            .renderArea =
-                {
-                    .offset = {.x = 0, .y = 0},
-                    .extent = render_area,
-                },
-            .clearValueCount = 0,
-            .pClearValues = nullptr,
-        };
-        cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
-    });
     num_renderpass_images = framebuffer->NumImages();
     renderpass_images = framebuffer->Images();
     renderpass_image_ranges = framebuffer->ImageRanges();
 }
 
+void Scheduler::MarkDrawStart(bool can_split) {
+    if (!recorder) {
+        return;
+    }
+    in_draw_setup = false;
+    draw_can_split = can_split;
+    if (state.renderpass) {
+        renderpass_splittable &= can_split;
+        if (renderpass_splittable && num_segment_draws >= DRAWS_PER_SEGMENT) {
+            // Start a new segment, rebinding all state so it can be recorded on its own
+            DispatchWork();
+            chunk->MarkSegmentBegin();
+            InvalidateState();
+            ++num_renderpass_segments;
+            num_segment_draws = 0;
+        }
+        ++num_segment_draws;
+    }
+    chunk->MarkDrawStart();
+    in_draw_setup = true;
+}
+
 void Scheduler::RequestOutsideRenderPassOperationContext() {
     EndRenderPass();
 }
@@ -145,6 +291,121 @@ bool Scheduler::UpdateRescaling(bool is_rescaling) {
     return true;
 }
 
+void Scheduler::ExecuteRenderPass() {
+    const RenderPassBegin begin = *renderpass_chunks.front()->GetRenderPassBegin();
+    const RenderPassEnd end = *renderpass_chunks.back()->GetRenderPassEnd();
+
+    // The first segment relies on state bound before the render pass, so it's recorded inline
+    auto it = renderpass_chunks.begin();
+    RecordBeginRenderPass(current_cmdbuf, begin.renderpass, begin.framebuffer, begin.render_area,
+                          VK_SUBPASS_CONTENTS_INLINE);
+    do {
+        (*it)->ExecuteRenderPassCommands(current_cmdbuf, current_upload_cmdbuf);
+        ++it;
+    } while (it != renderpass_chunks.end() && (!end.record_in_parallel || !(*it)->BeginsSegment()));
+
+    if (it != renderpass_chunks.end()) {
+        // Later segments bind all of their state, record them into secondary command buffers
+        // executed in a new instance of the render pass
+        RecordEndRenderPass(current_cmdbuf, end.num_images, end.images, end.ranges);
+        RecordBeginRenderPass(current_cmdbuf, begin.renderpass, begin.framebuffer,
+                              begin.render_area, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        RecordSegments(begin, std::span(it, renderpass_chunks.end()));
+        num_parallel_renderpasses.fetch_add(1, std::memory_order_relaxed);
+    }
+    RecordEndRenderPass(current_cmdbuf, end.num_images, end.images, end.ranges);
+
+    // Execute the commands recorded after the render pass ended, and recycle the chunks
+    for (const auto& renderpass_chunk : renderpass_chunks) {
+        renderpass_chunk->ExecuteAll(current_cmdbuf, current_upload_cmdbuf);
+    }
+    std::scoped_lock rl{reserve_mutex};
+    for (auto& renderpass_chunk : renderpass_chunks) {
+        chunk_reserve.emplace_back(std::move(renderpass_chunk));
+    }
+    renderpass_chunks.clear();
+}
+
+void Scheduler::RecordSegments(const RenderPassBegin& begin,
+                               std::span<const std::unique_ptr<CommandChunk>> chunks) {
+    std::vector<std::span<const std::unique_ptr<CommandChunk>>> segments;
+    for (size_t index = 0; index < chunks.size();) {
+        size_t segment_end = index + 1;
+        while (segment_end < chunks.size() && !chunks[segment_end]->BeginsSegment()) {
+            ++segment_end;
+        }
+        const auto segment = chunks.subspan(index, segment_end - index);
+        if (std::ranges::any_of(segment, &CommandChunk::HasRenderPassCommands)) {
+            segments.push_back(segment);
+        }
+        index = segment_end;
+    }
+    std::vector<VkCommandBuffer> cmdbufs(segments.size());
+    std::vector<VkCommandBuffer> upload_cmdbufs(segments.size());
+    for (size_t index = 0; index < segments.size(); ++index) {
+        recorder->QueueWork([this, &begin, &segments, &cmdbufs, &upload_cmdbufs,
+                             index](RecordingThread* thread) {
+            const auto start_time = std::chrono::steady_clock::now();
+            const VkCommandBufferInheritanceInfo inheritance{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+                .pNext = nullptr,
+                .renderPass = begin.renderpass,
+                .subpass = 0,
+                .framebuffer = begin.framebuffer,
+                .occlusionQueryEnable = VK_FALSE,
+                .queryFlags = 0,
+                .pipelineStatistics = 0,
+            };
+            const VkCommandBufferInheritanceInfo upload_inheritance{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+                .pNext = nullptr,
+                .renderPass = VK_NULL_HANDLE,
+                .subpass = 0,
+                .framebuffer = VK_NULL_HANDLE,
+                .occlusionQueryEnable = VK_FALSE,
+                .queryFlags = 0,
+                .pipelineStatistics = 0,
+            };
+            const vk::CommandBuffer cmdbuf(thread->command_pool->Commit(),
+                                           device.GetDispatchLoader());
+            cmdbuf.Begin({
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                .pNext = nullptr,
+                .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                         VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                .pInheritanceInfo = &inheritance,
+            });
+            const vk::CommandBuffer upload_cmdbuf(thread->command_pool->Commit(),
+                                                  device.GetDispatchLoader());
+            upload_cmdbuf.Begin({
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                .pNext = nullptr,
+                .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                .pInheritanceInfo = &upload_inheritance,
+            });
+            for (const auto& segment_chunk : segments[index]) {
+                segment_chunk->ExecuteRenderPassCommands(cmdbuf, upload_cmdbuf);
+            }
+            cmdbuf.End();
+            upload_cmdbuf.End();
+            cmdbufs[index] = *cmdbuf;
+            upload_cmdbufs[index] = *upload_cmdbuf;
+
+            const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start_time;
+            thread->statistics->segments.fetch_add(1, std::memory_order_relaxed);
+            thread->statistics->recording_ns.fetch_add(static_cast<u64>(elapsed.count()),
+                                                       std::memory_order_relaxed);
+        });
+    }
+    recorder->WaitForRequests();
+    if (segments.empty()) {
+        return;
+    }
+    // Uploads of the segments are executed in the upload command buffer, like the inline ones
+    current_upload_cmdbuf.ExecuteCommands(upload_cmdbufs);
+    current_cmdbuf.ExecuteCommands(cmdbufs);
+}
+
 void Scheduler::WorkerThread(std::stop_token stop_token) {
     Common::SetCurrentThreadName("VulkanWorker");
 
@@ -178,6 +439,16 @@ void Scheduler::WorkerThread(std::stop_token stop_token) {
             // to complete in the next step.
             std::exchange(lk, std::unique_lock{execution_mutex});
 
+            if (work->IsRenderPassPart()) {
+                // Segmented render passes are recorded once all of their chunks arrived
+                const bool ends_renderpass = work->GetRenderPassEnd().has_value();
+                renderpass_chunks.push_back(std::move(work));
+                if (ends_renderpass) {
+                    ExecuteRenderPass();
+                }
+                continue;
+            }
+
             // Perform the work, tracking whether the chunk was a submission
             // before executing.
             const bool has_submit = work->HasSubmit();
@@ -292,34 +563,31 @@ void Scheduler::EndRenderPass() {
     if (!state.renderpass) {
         return;
     }
+    if (recorder) {
+        // The worker ends segmented render passes itself, before the commands of a draw that
+        // started a new render pass
+        const bool record_in_parallel =
+            renderpass_splittable && num_renderpass_segments >= MIN_PARALLEL_SEGMENTS;
+        chunk->MarkRenderPassEnd(
+            {
+                .num_images = num_renderpass_images,
+                .images = renderpass_images,
+                .ranges = renderpass_image_ranges,
+                .record_in_parallel = record_in_parallel,
+            },
+            in_draw_setup);
+        state.renderpass = nullptr;
+        num_renderpass_images = 0;
+        DispatchWork();
+        if (record_in_parallel) {
+            // State bound in secondary command buffers is not inherited by the primary one
+            InvalidateState();
+        }
+        return;
+    }
     Record([num_images = num_renderpass_images, images = renderpass_images,
             ranges = renderpass_image_ranges](vk::CommandBuffer cmdbuf) {
-        std::array<VkImageMemoryBarrier, 9> barriers;
-        for (size_t i = 0; i < num_images; ++i) {
-            barriers[i] = VkImageMemoryBarrier{
-                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-                .pNext = nullptr,
-                .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
-                                 VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
-                                 VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
-                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
-                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
-                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .image = images[i],
-                .subresourceRange = ranges[i],
-            };
-        }
-        cmdbuf.EndRenderPass();
-        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
-                                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
-                                   VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, nullptr,
-                               vk::Span(barriers.data(), num_images));
+        RecordEndRenderPass(cmdbuf, num_images, images, ranges);
     });
     state.renderpass = nullptr;
     num_renderpass_images = 0;
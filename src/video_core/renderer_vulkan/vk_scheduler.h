@@ -3,17 +3,23 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <span>
 #include <thread>
 #include <utility>
 #include <queue>
+#include <vector>
 
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
+#include "common/thread_worker.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -55,6 +61,11 @@ public:
     /// Requests to begin a renderpass.
     void RequestRenderpass(const Framebuffer* framebuffer);
 
+    /// Marks the start of a draw or clear. With parallel recording, large render passes are split
+    /// into segments at these points. can_split is false when the draw relies on state spanning
+    /// several draws, like queries or transform feedback.
+    void MarkDrawStart(bool can_split);
+
     /// Requests the current execution context to be able to execute operations only allowed outside
     /// of a renderpass.
     void RequestOutsideRenderPassOperationContext();
@@ -160,10 +171,26 @@ private:
         T command;
     };
 
+    struct RenderPassBegin {
+        VkRenderPass renderpass;
+        VkFramebuffer framebuffer;
+        VkExtent2D render_area;
+    };
+
+    struct RenderPassEnd {
+        u32 num_images;
+        std::array<VkImage, 9> images;
+        std::array<VkImageSubresourceRange, 9> ranges;
+        bool record_in_parallel;
+    };
+
     class CommandChunk final {
     public:
         void ExecuteAll(vk::CommandBuffer cmdbuf, vk::CommandBuffer upload_cmdbuf);
 
+        /// Executes the commands recorded inside the render pass this chunk is part of
+        void ExecuteRenderPassCommands(vk::CommandBuffer cmdbuf, vk::CommandBuffer upload_cmdbuf);
+
         template <typename T>
         bool Record(T& command) {
             using FuncType = TypedCommand<T>;
@@ -197,12 +224,67 @@ private:
             return submit;
         }
 
+        void MarkRenderPassBegin(const RenderPassBegin& begin) {
+            renderpass_begin = begin;
+            is_renderpass_part = true;
+        }
+
+        void MarkRenderPassPart() {
+            is_renderpass_part = true;
+        }
+
+        void MarkSegmentBegin() {
+            begins_segment = true;
+        }
+
+        void MarkDrawStart() {
+            draw_start = last;
+            has_draw_start = true;
+        }
+
+        /// Ends the render pass after the commands of this chunk, or before the commands of the
+        /// last draw when that draw is what ends the render pass
+        void MarkRenderPassEnd(const RenderPassEnd& end, bool before_draw_start) {
+            renderpass_end = end;
+            if (before_draw_start && has_draw_start) {
+                renderpass_end_command = draw_start ? draw_start->GetNext() : first;
+            }
+        }
+
+        bool IsRenderPassPart() const {
+            return is_renderpass_part;
+        }
+
+        bool BeginsSegment() const {
+            return begins_segment;
+        }
+
+        bool HasRenderPassCommands() const {
+            return first != renderpass_end_command;
+        }
+
+        const std::optional<RenderPassBegin>& GetRenderPassBegin() const {
+            return renderpass_begin;
+        }
+
+        const std::optional<RenderPassEnd>& GetRenderPassEnd() const {
+            return renderpass_end;
+        }
+
     private:
         Command* first = nullptr;
         Command* last = nullptr;
 
         size_t command_offset = 0;
         bool submit = false;
+
+        std::optional<RenderPassBegin> renderpass_begin;
+        std::optional<RenderPassEnd> renderpass_end;
+        Command* renderpass_end_command = nullptr; ///< First command after the render pass ended
+        Command* draw_start = nullptr;             ///< Last command before the latest draw
+        bool has_draw_start = false;
+        bool is_renderpass_part = false;
+        bool begins_segment = false;
         alignas(std::max_align_t) std::array<u8, 0x8000> data{};
     };
 
@@ -215,8 +297,26 @@ private:
         bool rescaling_defined = false;
     };
 
+    /// Per thread statistics of the segments recorded in parallel
+    struct RecordingStatistics {
+        std::atomic<u64> segments{};
+        std::atomic<u64> recording_ns{};
+    };
+
+    struct RecordingThread {
+        std::unique_ptr<CommandPool> command_pool;
+        RecordingStatistics* statistics;
+    };
+
     void WorkerThread(std::stop_token stop_token);
 
+    /// Records a render pass split in segments, once all of its chunks have been received
+    void ExecuteRenderPass();
+
+    /// Records segments of a render pass in parallel into secondary command buffers
+    void RecordSegments(const RenderPassBegin& begin,
+                        std::span<const std::unique_ptr<CommandChunk>> chunks);
+
     void AllocateWorkerCommandBuffer();
 
     u64 SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_semaphore);
@@ -249,12 +349,26 @@ private:
     std::array<VkImage, 9> renderpass_images{};
     std::array<VkImageSubresourceRange, 9> renderpass_image_ranges{};
 
+    bool in_draw_setup = false;
+    bool draw_can_split = false;
+    bool renderpass_splittable = false;
+    u32 num_renderpass_segments = 0;
+    u32 num_segment_draws = 0;
+
     std::queue<std::unique_ptr<CommandChunk>> work_queue;
     std::vector<std::unique_ptr<CommandChunk>> chunk_reserve;
     std::mutex execution_mutex;
     std::mutex reserve_mutex;
     std::mutex queue_mutex;
     std::condition_variable_any event_cv;
+
+    static constexpr size_t MAX_RECORDING_THREADS = 4;
+    std::vector<std::unique_ptr<CommandChunk>> renderpass_chunks;
+    std::array<RecordingStatistics, MAX_RECORDING_THREADS> recording_statistics;
+    std::atomic<size_t> num_recording_threads{};
+    std::atomic<u64> num_parallel_renderpasses{};
+    std::unique_ptr<Common::StatefulThreadWorker<RecordingThread>> recorder;
+
     std::jthread worker_thread;
 };
 
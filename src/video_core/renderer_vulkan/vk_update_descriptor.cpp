@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
 #include <variant>
 #include <boost/container/static_vector.hpp>
 
 #include "common/logging/log.h"
+#include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/vulkan_common/vulkan_device.h"
@@ -12,15 +15,59 @@
 
 namespace Vulkan {
 
-UpdateDescriptorQueue::UpdateDescriptorQueue(const Device& device_, Scheduler& scheduler_)
-    : device{device_}, scheduler{scheduler_} {
+VkDescriptorSet DescriptorSetReuse::Find(const MasterSemaphore& master_semaphore,
+                                         std::span<const DescriptorUpdateEntry> data) {
+    std::scoped_lock lock{mutex};
+    if (!last_set || last_tick != master_semaphore.CurrentTick() ||
+        last_data.size() != data.size()) {
+        return VK_NULL_HANDLE;
+    }
+    if (std::memcmp(last_data.data(), data.data(), data.size_bytes()) != 0) {
+        return VK_NULL_HANDLE;
+    }
+    return last_set;
+}
+
+void DescriptorSetReuse::Remember(VkDescriptorSet set, u64 tick,
+                                  std::span<const DescriptorUpdateEntry> data) {
+    std::scoped_lock lock{mutex};
+    last_set = set;
+    last_tick = tick;
+    last_data.assign(data.begin(), data.end());
+}
+
+UpdateDescriptorQueue::UpdateDescriptorQueue(const Device& device_, Scheduler& scheduler_,
+                                             std::string_view name_)
+    : device{device_}, scheduler{scheduler_}, name{name_} {
     payload_start = payload.data();
     payload_cursor = payload.data();
 }
 
-UpdateDescriptorQueue::~UpdateDescriptorQueue() = default;
+UpdateDescriptorQueue::~UpdateDescriptorQueue() {
+    const auto load = [](const auto& counters, DescriptorWrite write) {
+        return counters[static_cast<size_t>(write)].load(std::memory_order_relaxed);
+    };
+    const u64 num_pushed = load(write_counts, DescriptorWrite::Push);
+    const u64 num_updated = load(write_counts, DescriptorWrite::Update);
+    const u64 num_reused = load(write_counts, DescriptorWrite::Reuse);
+    if (num_frames == 0 || num_pushed + num_updated + num_reused == 0) {
+        return;
+    }
+    const u64 written_bytes =
+        load(write_bytes, DescriptorWrite::Push) + load(write_bytes, DescriptorWrite::Update);
+    LOG_INFO(Render_Vulkan,
+             "{} descriptors: {} pushed, {} set updates, {} set reuses ({} KiB skipped), "
+             "{} KiB written per frame on average, {} KiB peak",
+             name, num_pushed, num_updated, num_reused,
+             load(write_bytes, DescriptorWrite::Reuse) / 1024, written_bytes / num_frames / 1024,
+             peak_frame_bytes / 1024);
+}
 
 void UpdateDescriptorQueue::TickFrame() {
+    const u64 bytes = frame_bytes.exchange(0, std::memory_order_relaxed);
+    peak_frame_bytes = std::max(peak_frame_bytes, bytes);
+    ++num_frames;
+
     if (++frame_index >= FRAMES_IN_FLIGHT) {
         frame_index = 0;
     }
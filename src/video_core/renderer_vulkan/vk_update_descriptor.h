@@ -4,21 +4,34 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <string_view>
 
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
 namespace Vulkan {
 
 class Device;
+class MasterSemaphore;
 class Scheduler;
 
 struct DescriptorUpdateEntry {
     struct Empty {};
 
+    // Unused bytes are zeroed so payloads can be compared bytewise
     DescriptorUpdateEntry() = default;
-    DescriptorUpdateEntry(VkDescriptorImageInfo image_) : image{image_} {}
+    DescriptorUpdateEntry(VkDescriptorImageInfo image_) : buffer{} {
+        image = image_;
+    }
     DescriptorUpdateEntry(VkDescriptorBufferInfo buffer_) : buffer{buffer_} {}
-    DescriptorUpdateEntry(VkBufferView texel_buffer_) : texel_buffer{texel_buffer_} {}
+    DescriptorUpdateEntry(VkBufferView texel_buffer_) : buffer{} {
+        texel_buffer = texel_buffer_;
+    }
 
     union {
         Empty empty{};
@@ -28,6 +41,37 @@ struct DescriptorUpdateEntry {
     };
 };
 
+/// How the descriptors of a draw or dispatch reached the device
+enum class DescriptorWrite {
+    Push,   ///< Pushed into the command buffer
+    Update, ///< Written to a newly committed descriptor set
+    Reuse,  ///< Bound a descriptor set written by a previous call
+};
+
+/**
+ * Remembers the last descriptor set committed by a pipeline.
+ *
+ * Consecutive draws often bind the same resources. When the payload of a draw matches the one
+ * written to the last set, that set can be bound again instead of allocating and updating another.
+ * Sets are only reused while the master semaphore is still on the tick read before committing, so
+ * they are never recycled by the allocator while a command buffer using them is pending.
+ */
+class DescriptorSetReuse {
+public:
+    /// Returns the last committed set if it holds the given payload, or null
+    [[nodiscard]] VkDescriptorSet Find(const MasterSemaphore& master_semaphore,
+                                       std::span<const DescriptorUpdateEntry> data);
+
+    /// Remembers a set written with the given payload, tick must be read before committing it
+    void Remember(VkDescriptorSet set, u64 tick, std::span<const DescriptorUpdateEntry> data);
+
+private:
+    std::mutex mutex; ///< Draws of the same pipeline may be recorded on different threads
+    VkDescriptorSet last_set{};
+    u64 last_tick{};
+    boost::container::small_vector<DescriptorUpdateEntry, 32> last_data;
+};
+
 class UpdateDescriptorQueue final {
     // This should be plenty for the vast majority of cases. Most desktop platforms only
     // provide up to 3 swapchain images.
@@ -36,7 +80,8 @@ class UpdateDescriptorQueue final {
     static constexpr size_t PAYLOAD_SIZE = FRAME_PAYLOAD_SIZE * FRAMES_IN_FLIGHT;
 
 public:
-    explicit UpdateDescriptorQueue(const Device& device_, Scheduler& scheduler_);
+    explicit UpdateDescriptorQueue(const Device& device_, Scheduler& scheduler_,
+                                   std::string_view name_);
     ~UpdateDescriptorQueue();
 
     void TickFrame();
@@ -47,6 +92,26 @@ public:
         return upload_start;
     }
 
+    /// Returns the payload pushed since the last call to Acquire
+    std::span<const DescriptorUpdateEntry> UpdateSpan() const noexcept {
+        return {upload_start, static_cast<size_t>(payload_cursor - upload_start)};
+    }
+
+    /// Counts the descriptors of a draw or dispatch, safe to call from recording threads
+    void CountWrite(DescriptorWrite write, size_t num_entries) noexcept {
+        const size_t bytes = num_entries * sizeof(DescriptorUpdateEntry);
+        write_counts[static_cast<size_t>(write)].fetch_add(1, std::memory_order_relaxed);
+        write_bytes[static_cast<size_t>(write)].fetch_add(bytes, std::memory_order_relaxed);
+        if (write != DescriptorWrite::Reuse) {
+            frame_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    /// Counts the payload since the last call to Acquire as written to a new descriptor set
+    void CountSetUpdate() noexcept {
+        CountWrite(DescriptorWrite::Update, UpdateSpan().size());
+    }
+
     void AddSampledImage(VkImageView image_view, VkSampler sampler) {
         *(payload_cursor++) = VkDescriptorImageInfo{
             .sampler = sampler,
@@ -76,14 +141,23 @@ public:
     }
 
 private:
+    static constexpr size_t NUM_WRITE_KINDS = 3;
+
     const Device& device;
     Scheduler& scheduler;
+    std::string_view name;
 
     size_t frame_index{0};
     DescriptorUpdateEntry* payload_cursor = nullptr;
     DescriptorUpdateEntry* payload_start = nullptr;
     const DescriptorUpdateEntry* upload_start = nullptr;
     std::array<DescriptorUpdateEntry, PAYLOAD_SIZE> payload;
+
+    std::array<std::atomic<u64>, NUM_WRITE_KINDS> write_counts{};
+    std::array<std::atomic<u64>, NUM_WRITE_KINDS> write_bytes{};
+    std::atomic<u64> frame_bytes{}; ///< Descriptor bytes written since the last frame
+    u64 num_frames{};
+    u64 peak_frame_bytes{};
 };
 
 // TODO: should these be separate classes instead?
@@ -20,9 +20,9 @@
 namespace VideoCommon {
 
 void ShaderCache::InvalidateRegion(VAddr addr, size_t size) {
+    // This can be called from CPU threads, freeing is left to the GPU thread between draws
     std::scoped_lock lock{invalidation_mutex};
     InvalidatePagesInRegion(addr, size);
-    RemovePendingShaders();
 }
 
 void ShaderCache::OnCacheInvalidation(VAddr addr, size_t size) {
@@ -31,14 +31,24 @@ void ShaderCache::OnCacheInvalidation(VAddr addr, size_t size) {
 }
 
 void ShaderCache::SyncGuestHost() {
-    std::scoped_lock lock{invalidation_mutex};
     RemovePendingShaders();
 }
 
+ShaderCacheStatistics ShaderCache::GetAndResetStatistics() noexcept {
+    return {
+        .lookups = num_lookups.exchange(0, std::memory_order_relaxed),
+        .lookup_misses = num_lookup_misses.exchange(0, std::memory_order_relaxed),
+        .invalidations = num_invalidations.exchange(0, std::memory_order_relaxed),
+        .false_invalidations = num_false_invalidations.exchange(0, std::memory_order_relaxed),
+    };
+}
+
 ShaderCache::ShaderCache(Tegra::MaxwellDeviceMemoryManager& device_memory_)
     : device_memory{device_memory_} {}
 
 bool ShaderCache::RefreshStages(std::array<u64, 6>& unique_hashes) {
+    RemovePendingShaders();
+
     auto& dirty{maxwell3d->dirty.flags};
     if (!dirty[VideoCommon::Dirty::Shaders]) {
         return last_shaders_valid;
@@ -79,6 +89,8 @@ bool ShaderCache::RefreshStages(std::array<u64, 6>& unique_hashes) {
 }
 
 const ShaderInfo* ShaderCache::ComputeShader() {
+    RemovePendingShaders();
+
     const GPUVAddr program_base{kepler_compute->regs.code_loc.Address()};
     const auto& qmd{kepler_compute->launch_description};
     const GPUVAddr shader_addr{program_base + qmd.program_start};
@@ -112,24 +124,25 @@ void ShaderCache::GetGraphicsEnvironments(GraphicsEnvironments& result,
 }
 
 ShaderInfo* ShaderCache::TryGet(VAddr addr) const {
-    std::scoped_lock lock{lookup_mutex};
+    num_lookups.fetch_add(1, std::memory_order_relaxed);
 
     const auto it = lookup_cache.find(addr);
-    if (it == lookup_cache.end()) {
+    if (it == lookup_cache.end() || it->second->is_invalidated.load(std::memory_order_acquire)) {
+        num_lookup_misses.fetch_add(1, std::memory_order_relaxed);
         return nullptr;
     }
     return it->second->data;
 }
 
 void ShaderCache::Register(std::unique_ptr<ShaderInfo> data, VAddr addr, size_t size) {
-    std::scoped_lock lock{invalidation_mutex, lookup_mutex};
+    std::scoped_lock lock{invalidation_mutex};
 
     const VAddr addr_end = addr + size;
     Entry* const entry = NewEntry(addr, addr_end, data.get());
 
     const u64 page_end = (addr_end + SUYU_PAGESIZE - 1) >> SUYU_PAGEBITS;
     for (u64 page = addr >> SUYU_PAGEBITS; page < page_end; ++page) {
-        invalidation_cache[page].push_back(entry);
+        invalidation_cache.Get(page).push_back(entry);
     }
 
     storage.push_back(std::move(data));
@@ -140,42 +153,63 @@ void ShaderCache::Register(std::unique_ptr<ShaderInfo> data, VAddr addr, size_t
 void ShaderCache::InvalidatePagesInRegion(VAddr addr, size_t size) {
     const VAddr addr_end = addr + size;
     const u64 page_end = (addr_end + SUYU_PAGESIZE - 1) >> SUYU_PAGEBITS;
+    bool is_shader_page = false;
+    size_t num_invalidated = 0;
     for (u64 page = addr >> SUYU_PAGEBITS; page < page_end; ++page) {
-        auto it = invalidation_cache.find(page);
-        if (it == invalidation_cache.end()) {
+        std::vector<Entry*>* const entries = invalidation_cache.Find(page);
+        if (!entries || entries->empty()) {
             continue;
         }
-        InvalidatePageEntries(it->second, addr, addr_end);
+        is_shader_page = true;
+        num_invalidated += InvalidatePageEntries(*entries, addr, addr_end);
+    }
+    if (num_invalidated != 0) {
+        num_invalidations.fetch_add(num_invalidated, std::memory_order_relaxed);
+        has_pending_removals.store(true, std::memory_order_release);
+    } else if (is_shader_page) {
+        num_false_invalidations.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
-void ShaderCache::RemovePendingShaders() {
-    if (marked_for_removal.empty()) {
-        return;
+bool ShaderCache::RemovePendingShaders() {
+    if (!has_pending_removals.load(std::memory_order_acquire)) {
+        return false;
+    }
+    {
+        // Take the whole batch, so CPU writes are not blocked while the shaders are freed
+        std::scoped_lock lock{invalidation_mutex};
+        removal_batch.swap(marked_for_removal);
+        has_pending_removals.store(false, std::memory_order_relaxed);
+    }
+    if (removal_batch.empty()) {
+        return false;
     }
-    // Remove duplicates
-    std::ranges::sort(marked_for_removal);
-    marked_for_removal.erase(std::unique(marked_for_removal.begin(), marked_for_removal.end()),
-                             marked_for_removal.end());
 
     boost::container::small_vector<ShaderInfo*, 16> removed_shaders;
-
-    std::scoped_lock lock{lookup_mutex};
-    for (Entry* const entry : marked_for_removal) {
+    for (Entry* const entry : removal_batch) {
         removed_shaders.push_back(entry->data);
 
+        // Entries replaced by a newer shader in the same address are owned by replaced_entries
         const auto it = lookup_cache.find(entry->addr_start);
-        ASSERT(it != lookup_cache.end());
-        lookup_cache.erase(it);
+        if (it != lookup_cache.end() && it->second.get() == entry) {
+            lookup_cache.erase(it);
+        }
     }
-    marked_for_removal.clear();
+    removal_batch.clear();
+    replaced_entries.clear();
+
+    RemoveShadersFromStorage(removed_shaders);
 
-    if (!removed_shaders.empty()) {
-        RemoveShadersFromStorage(removed_shaders);
+    // The shaders of the current stages might have been freed
+    if (maxwell3d) {
+        maxwell3d->dirty.flags[VideoCommon::Dirty::Shaders] = true;
     }
+    return true;
 }
 
-void ShaderCache::InvalidatePageEntries(std::vector<Entry*>& entries, VAddr addr, VAddr addr_end) {
+size_t ShaderCache::InvalidatePageEntries(std::vector<Entry*>& entries, VAddr addr,
+                                          VAddr addr_end) {
+    size_t num_invalidated = 0;
     size_t index = 0;
     while (index < entries.size()) {
         Entry* const entry = entries[index];
@@ -184,18 +218,21 @@ void ShaderCache::InvalidatePageEntries(std::vector<Entry*>& entries, VAddr addr
             continue;
         }
 
+        entry->is_invalidated.store(true, std::memory_order_release);
         UnmarkMemory(entry);
         RemoveEntryFromInvalidationCache(entry);
         marked_for_removal.push_back(entry);
+        ++num_invalidated;
     }
+    return num_invalidated;
 }
 
 void ShaderCache::RemoveEntryFromInvalidationCache(const Entry* entry) {
     const u64 page_end = (entry->addr_end + SUYU_PAGESIZE - 1) >> SUYU_PAGEBITS;
     for (u64 page = entry->addr_start >> SUYU_PAGEBITS; page < page_end; ++page) {
-        const auto entries_it = invalidation_cache.find(page);
-        ASSERT(entries_it != invalidation_cache.end());
-        std::vector<Entry*>& entries = entries_it->second;
+        std::vector<Entry*>* const entries_ptr = invalidation_cache.Find(page);
+        ASSERT(entries_ptr != nullptr);
+        std::vector<Entry*>& entries = *entries_ptr;
 
         const auto entry_it = std::ranges::find(entries, entry);
         ASSERT(entry_it != entries.end());
@@ -215,17 +252,27 @@ void ShaderCache::UnmarkMemory(Entry* entry) {
 }
 
 void ShaderCache::RemoveShadersFromStorage(std::span<ShaderInfo*> removed_shaders) {
-    // Remove them from the cache
+    // Remove them from the cache, a whole batch at once
+    std::ranges::sort(removed_shaders);
     std::erase_if(storage, [&removed_shaders](const std::unique_ptr<ShaderInfo>& shader) {
-        return std::ranges::find(removed_shaders, shader.get()) != removed_shaders.end();
+        return std::ranges::binary_search(removed_shaders, shader.get());
     });
 }
 
 ShaderCache::Entry* ShaderCache::NewEntry(VAddr addr, VAddr addr_end, ShaderInfo* data) {
-    auto entry = std::make_unique<Entry>(Entry{addr, addr_end, data});
+    auto entry = std::make_unique<Entry>();
+    entry->addr_start = addr;
+    entry->addr_end = addr_end;
+    entry->data = data;
     Entry* const entry_pointer = entry.get();
 
-    lookup_cache.emplace(addr, std::move(entry));
+    auto& slot = lookup_cache[addr];
+    if (slot) {
+        // Only an invalidated shader waiting to be removed can still be in the same address
+        ASSERT(slot->is_invalidated.load(std::memory_order_relaxed));
+        replaced_entries.push_back(std::move(slot));
+    }
+    slot = std::move(entry);
     return entry_pointer;
 }
 
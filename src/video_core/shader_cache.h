@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <span>
@@ -48,14 +49,51 @@ class ShaderCache : public VideoCommon::ChannelSetupCaches<VideoCommon::ChannelI
 
         bool is_memory_marked = true;
 
+        /// Set by invalidations, the entry is not returned by lookups anymore
+        std::atomic_bool is_invalidated{false};
+
         bool Overlaps(VAddr start, VAddr end) const noexcept {
             return start < addr_end && addr_start < end;
         }
     };
 
+    /// Flat table from page to the entries overlapping it, so invalidations don't hash
+    class PageEntries {
+        static constexpr u64 LEAF_BITS = 10;
+        static constexpr u64 LEAF_MASK = (u64(1) << LEAF_BITS) - 1;
+        static constexpr u64 NUM_PAGES = u64(1)
+                                         << (Tegra::MaxwellDeviceTraits::device_virtual_bits -
+                                             SUYU_PAGEBITS);
+
+        using Leaf = std::array<std::vector<Entry*>, u64(1) << LEAF_BITS>;
+
+    public:
+        /// Returns the entries of a page, or nullptr when the page never held any
+        std::vector<Entry*>* Find(u64 page) noexcept {
+            if (page >= NUM_PAGES) {
+                return nullptr;
+            }
+            Leaf* const leaf = leaves[page >> LEAF_BITS].get();
+            return leaf ? &(*leaf)[page & LEAF_MASK] : nullptr;
+        }
+
+        /// Returns the entries of a page, creating them when needed
+        std::vector<Entry*>& Get(u64 page) {
+            auto& leaf = leaves[page >> LEAF_BITS];
+            if (!leaf) {
+                leaf = std::make_unique<Leaf>();
+            }
+            return (*leaf)[page & LEAF_MASK];
+        }
+
+    private:
+        std::array<std::unique_ptr<Leaf>, (NUM_PAGES >> LEAF_BITS)> leaves;
+    };
+
 public:
     /// @brief Removes shaders inside a given region
     /// @note Checks for ranges
+    /// @note Lookups stop returning the shaders immediately, they are freed between draws
     /// @param addr Start address of the invalidation
     /// @param size Number of bytes of the invalidation
     void InvalidateRegion(VAddr addr, size_t size);
@@ -66,8 +104,12 @@ public:
     void OnCacheInvalidation(VAddr addr, size_t size);
 
     /// @brief Flushes delayed removal operations
+    /// @note Has to be called from the GPU thread
     void SyncGuestHost();
 
+    /// @brief Returns the lookup and invalidation counters since the last call and resets them
+    [[nodiscard]] ShaderCacheStatistics GetAndResetStatistics() noexcept;
+
 protected:
     struct GraphicsEnvironments {
         std::array<GraphicsEnvironment, NUM_PROGRAMS> envs;
@@ -99,6 +141,7 @@ protected:
 private:
     /// @brief Tries to obtain a cached shader starting in a given address
     /// @note Doesn't check for ranges, the given address has to be the start of the shader
+    /// @note Lock-free, lookups and removals both happen on the GPU thread
     /// @param addr Start address of the shader, this doesn't cache for region
     /// @return Pointer to a valid shader, nullptr when nothing is found
     ShaderInfo* TryGet(VAddr addr) const;
@@ -113,16 +156,17 @@ private:
     /// @pre invalidation_mutex is locked
     void InvalidatePagesInRegion(VAddr addr, size_t size);
 
-    /// @brief Remove shaders marked for deletion
-    /// @pre invalidation_mutex is locked
-    void RemovePendingShaders();
+    /// @brief Remove shaders marked for deletion, called between draws on the GPU thread
+    /// @return True when any shader was removed
+    bool RemovePendingShaders();
 
     /// @brief Invalidates entries in a given range for the passed page
     /// @param entries         Vector of entries in the page, it will be modified on overlaps
     /// @param addr            Start address of the invalidation
     /// @param addr_end        Non-inclusive end address of the invalidation
+    /// @return Number of invalidated entries
     /// @pre invalidation_mutex is locked
-    void InvalidatePageEntries(std::vector<Entry*>& entries, VAddr addr, VAddr addr_end);
+    size_t InvalidatePageEntries(std::vector<Entry*>& entries, VAddr addr, VAddr addr_end);
 
     /// @brief Removes all references to an entry in the invalidation cache
     /// @param entry Entry to remove from the invalidation cache
@@ -135,12 +179,10 @@ private:
 
     /// @brief Removes a vector of shaders from a list
     /// @param removed_shaders Shaders to be removed from the storage
-    /// @pre invalidation_mutex is locked
-    /// @pre lookup_mutex is locked
     void RemoveShadersFromStorage(std::span<ShaderInfo*> removed_shaders);
 
     /// @brief Creates a new entry in the lookup cache and returns its pointer
-    /// @pre lookup_mutex is locked
+    /// @pre invalidation_mutex is locked
     Entry* NewEntry(VAddr addr, VAddr addr_end, ShaderInfo* data);
 
     /// @brief Create a new shader entry and register it
@@ -148,13 +190,23 @@ private:
 
     Tegra::MaxwellDeviceMemoryManager& device_memory;
 
-    mutable std::mutex lookup_mutex;
     std::mutex invalidation_mutex;
 
+    /// Only accessed from the GPU thread
     std::unordered_map<u64, std::unique_ptr<Entry>> lookup_cache;
-    std::unordered_map<u64, std::vector<Entry*>> invalidation_cache;
     std::vector<std::unique_ptr<ShaderInfo>> storage;
+    std::vector<Entry*> removal_batch;
+    std::vector<std::unique_ptr<Entry>> replaced_entries;
+
+    /// Protected by invalidation_mutex
+    PageEntries invalidation_cache;
     std::vector<Entry*> marked_for_removal;
+    std::atomic_bool has_pending_removals{false};
+
+    mutable std::atomic<u64> num_lookups{};
+    mutable std::atomic<u64> num_lookup_misses{};
+    std::atomic<u64> num_invalidations{};
+    std::atomic<u64> num_false_invalidations{};
 };
 
 } // namespace VideoCommon
@@ -33,6 +33,7 @@
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/texture_cache/render_targets.h"
+#include "video_core/texture_cache/transcode_cache.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
 
@@ -131,6 +132,9 @@ class TextureCache : public VideoCommon::ChannelSetupCaches<TextureCacheChannelI
 public:
     explicit TextureCache(Runtime&, Tegra::MaxwellDeviceMemoryManager&);
 
+    /// Opens the disk cache of converted textures for a title
+    void LoadDiskResources(u64 title_id);
+
     /// Notify the cache that a new frame has been queued
     void TickFrame();
 
@@ -489,6 +493,7 @@ private:
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
+    TranscodeCache transcode_cache;
     Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
     std::vector<std::unique_ptr<AsyncDecodeContext>> async_decodes;
 
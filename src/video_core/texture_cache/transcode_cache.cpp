@@ -0,0 +1,280 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_funcs.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "common/zstd_compression.h"
+#include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/transcode_cache.h"
+#include "video_core/texture_cache/util.h"
+
+namespace VideoCommon {
+
+namespace {
+
+using namespace Common::Literals;
+
+constexpr u32 EntryMagic = Common::MakeMagic('S', 'T', 'X', 'C');
+
+// Bump when the output of ConvertImage changes, so stale entries are no longer found
+constexpr u32 EntryVersion = 1;
+
+// Conversions cheaper than this are not worth a file on disk
+constexpr size_t MinOutputSize = 64_KiB;
+
+struct EntryHeader {
+    u32 magic;
+    u32 version;
+    u32 num_copies;
+    INSERT_PADDING_BYTES(4);
+    u64 output_size;
+};
+static_assert(sizeof(EntryHeader) == 0x18, "EntryHeader has incorrect size.");
+
+std::optional<u128> ParseEntryName(const std::filesystem::path& path) {
+    if (path.extension() != ".bin") {
+        return std::nullopt;
+    }
+    const std::string stem = Common::FS::PathToUTF8String(path.stem());
+    if (stem.size() != 32) {
+        return std::nullopt;
+    }
+    u128 key{};
+    const char* const begin = stem.data();
+    const auto high = std::from_chars(begin, begin + 16, key[1], 16);
+    const auto low = std::from_chars(begin + 16, begin + 32, key[0], 16);
+    if (high.ec != std::errc{} || high.ptr != begin + 16 || low.ec != std::errc{} ||
+        low.ptr != begin + 32) {
+        return std::nullopt;
+    }
+    return key;
+}
+
+std::vector<u8> ReadEntry(const std::filesystem::path& path, size_t output_size,
+                          std::span<BufferImageCopy> copies) {
+    const Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                                  Common::FS::FileType::BinaryFile};
+    EntryHeader header{};
+    if (!file.IsOpen() || !file.ReadObject(header) || header.magic != EntryMagic ||
+        header.version != EntryVersion || header.num_copies != copies.size() ||
+        header.output_size != output_size || file.ReadSpan(copies) != copies.size()) {
+        return {};
+    }
+    std::vector<u8> compressed(file.GetSize() - static_cast<u64>(file.Tell()));
+    if (file.ReadSpan(std::span{compressed}) != compressed.size()) {
+        return {};
+    }
+    return Common::Compression::DecompressDataZSTD(compressed);
+}
+
+} // Anonymous namespace
+
+TranscodeCache::TranscodeCache() = default;
+
+TranscodeCache::~TranscodeCache() {
+    // Entries queued for storing would be lost otherwise
+    store_worker.WaitForRequests();
+}
+
+void TranscodeCache::Open(u64 title_id) {
+    if (!Settings::values.use_disk_texture_cache.GetValue() || title_id == 0) {
+        return;
+    }
+    cache_dir = Common::FS::GetSuyuPath(Common::FS::SuyuPath::CacheDir) / "transcoded_textures" /
+                fmt::format("{:016x}", title_id);
+    if (!Common::FS::CreateDirs(cache_dir)) {
+        LOG_ERROR(HW_GPU, "Failed to create disk texture cache directory {}",
+                  Common::FS::PathToUTF8String(cache_dir));
+        return;
+    }
+    size_limit = u64{Settings::values.disk_texture_cache_size.GetValue()} * 1_MiB;
+
+    // Files are touched when they are loaded, so their modification time orders them by last use
+    struct FoundEntry {
+        Key key;
+        u64 size;
+        std::filesystem::file_time_type time;
+    };
+    std::vector<FoundEntry> found;
+    Common::FS::IterateDirEntries(
+        cache_dir,
+        [&found](const std::filesystem::directory_entry& entry) {
+            std::error_code ec;
+            const auto key = ParseEntryName(entry.path());
+            const u64 size = entry.file_size(ec);
+            const auto time = entry.last_write_time(ec);
+            if (key && !ec) {
+                found.push_back({*key, size, time});
+            }
+            return true;
+        },
+        Common::FS::DirEntryFilter::File);
+    std::ranges::sort(found, {}, &FoundEntry::time);
+
+    std::scoped_lock lk{mutex};
+    entries.clear();
+    total_size = 0;
+    use_counter = 0;
+    for (const FoundEntry& entry : found) {
+        entries.insert_or_assign(entry.key, EntryInfo{entry.size, ++use_counter});
+        total_size += entry.size;
+    }
+    TrimLocked();
+    is_enabled = true;
+
+    LOG_INFO(HW_GPU, "Disk texture cache has {} entries, {} MiB", entries.size(),
+             total_size / 1_MiB);
+}
+
+void TranscodeCache::ConvertImage(std::span<const u8> input, const ImageInfo& info,
+                                  std::span<u8> output, std::span<BufferImageCopy> copies) {
+    if (!is_enabled || output.size() < MinOutputSize) {
+        VideoCommon::ConvertImage(input, info, output, copies);
+        return;
+    }
+    const Key key = MakeKey(input, info);
+    if (Load(key, output, copies)) {
+        return;
+    }
+    VideoCommon::ConvertImage(input, info, output, copies);
+    Store(key, output, copies);
+}
+
+TranscodeCache::Key TranscodeCache::MakeKey(std::span<const u8> input, const ImageInfo& info) {
+    // Everything besides the guest data that the output of ConvertImage depends on
+    const std::array<u32, 10> parameters{
+        static_cast<u32>(info.format),
+        static_cast<u32>(info.type),
+        info.size.width,
+        info.size.height,
+        info.size.depth,
+        static_cast<u32>(info.resources.levels),
+        static_cast<u32>(info.resources.layers),
+        static_cast<u32>(Settings::values.astc_recompression.GetValue()),
+        static_cast<u32>(Settings::values.astc_recompression_quality.GetValue()),
+        EntryVersion,
+    };
+    const Key seed =
+        Common::CityHash128(reinterpret_cast<const char*>(parameters.data()), sizeof(parameters));
+    return Common::CityHash128WithSeed(reinterpret_cast<const char*>(input.data()), input.size(),
+                                       seed);
+}
+
+std::filesystem::path TranscodeCache::EntryPath(const Key& key) const {
+    return cache_dir / fmt::format("{:016x}{:016x}.bin", key[1], key[0]);
+}
+
+bool TranscodeCache::Load(const Key& key, std::span<u8> output,
+                          std::span<BufferImageCopy> copies) {
+    {
+        std::scoped_lock lk{mutex};
+        const auto it = entries.find(key);
+        if (it == entries.end()) {
+            return false;
+        }
+        it->second.last_use = ++use_counter;
+    }
+    const auto path = EntryPath(key);
+    // Copies are only updated on success, ConvertImage depends on them otherwise
+    std::vector<BufferImageCopy> stored_copies(copies.size());
+    const std::vector<u8> decompressed = ReadEntry(path, output.size(), stored_copies);
+    if (decompressed.size() != output.size()) {
+        LOG_WARNING(HW_GPU, "Invalid disk texture cache entry {}",
+                    Common::FS::PathToUTF8String(path));
+        std::scoped_lock lk{mutex};
+        if (const auto it = entries.find(key); it != entries.end()) {
+            total_size -= it->second.size;
+            entries.erase(it);
+        }
+        Common::FS::RemoveFile(path);
+        return false;
+    }
+    std::ranges::copy(decompressed, output.begin());
+    std::ranges::copy(stored_copies, copies.begin());
+
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+void TranscodeCache::Store(const Key& key, std::span<const u8> output,
+                           std::span<const BufferImageCopy> copies) {
+    // Compressing and writing is left to a worker, the image only has to be converted once
+    store_worker.QueueWork([this, key, output = std::vector<u8>(output.begin(), output.end()),
+                            copies = std::vector<BufferImageCopy>(copies.begin(), copies.end())] {
+        const std::vector<u8> compressed =
+            Common::Compression::CompressDataZSTDDefault(output.data(), output.size());
+        const EntryHeader header{
+            .magic = EntryMagic,
+            .version = EntryVersion,
+            .num_copies = static_cast<u32>(copies.size()),
+            .output_size = output.size(),
+        };
+        const auto path = EntryPath(key);
+        {
+            const Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                                          Common::FS::FileType::BinaryFile};
+            if (!file.IsOpen() || !file.WriteObject(header) ||
+                file.WriteSpan(std::span{copies}) != copies.size() ||
+                file.WriteSpan(std::span{compressed}) != compressed.size()) {
+                LOG_ERROR(HW_GPU, "Failed to write disk texture cache entry {}",
+                          Common::FS::PathToUTF8String(path));
+                return;
+            }
+        }
+        const u64 size = sizeof(EntryHeader) + copies.size() * sizeof(BufferImageCopy) +
+                         compressed.size();
+
+        std::scoped_lock lk{mutex};
+        const auto [it, is_new] = entries.try_emplace(key, EntryInfo{size, ++use_counter});
+        if (!is_new) {
+            total_size -= it->second.size;
+            it->second.size = size;
+        }
+        total_size += size;
+        TrimLocked();
+    });
+}
+
+void TranscodeCache::TrimLocked() {
+    if (total_size <= size_limit) {
+        return;
+    }
+    // Trim further than the limit, so the cache is not trimmed again on every store
+    const u64 target_size = size_limit / 4 * 3;
+
+    std::vector<std::pair<u64, Key>> by_use;
+    by_use.reserve(entries.size());
+    for (const auto& [key, entry] : entries) {
+        by_use.emplace_back(entry.last_use, key);
+    }
+    std::ranges::sort(by_use);
+
+    for (const auto& [last_use, key] : by_use) {
+        if (total_size <= target_size) {
+            break;
+        }
+        const auto it = entries.find(key);
+        total_size -= it->second.size;
+        entries.erase(it);
+        Common::FS::RemoveFile(EntryPath(key));
+    }
+    LOG_DEBUG(HW_GPU, "Trimmed disk texture cache to {} MiB", total_size / 1_MiB);
+}
+
+} // namespace VideoCommon
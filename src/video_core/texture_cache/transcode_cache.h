@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: Copyright 2024 suyu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <span>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+struct ImageInfo;
+
+/**
+ * Per-title disk cache of converted textures.
+ *
+ * Decoding ASTC and recompressing it to BCn is by far the most expensive part of uploading a
+ * converted image. The result only depends on the unswizzled guest data and a few image
+ * parameters, so it is stored compressed on disk and loaded back on following boots.
+ * The least recently used entries are removed when the cache grows past its size limit.
+ */
+class TranscodeCache {
+public:
+    TranscodeCache();
+    ~TranscodeCache();
+
+    /// Opens the cache of a title, does nothing when the disk texture cache is disabled
+    void Open(u64 title_id);
+
+    /// Returns true when a title's cache is open
+    [[nodiscard]] bool IsEnabled() const noexcept {
+        return is_enabled;
+    }
+
+    /**
+     * Same as VideoCommon::ConvertImage, but loads the converted image from disk when it was
+     * converted before, and stores it when it was not.
+     */
+    void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
+                      std::span<BufferImageCopy> copies);
+
+private:
+    using Key = u128;
+
+    struct EntryInfo {
+        u64 size;
+        u64 last_use;
+    };
+
+    [[nodiscard]] static Key MakeKey(std::span<const u8> input, const ImageInfo& info);
+
+    [[nodiscard]] std::filesystem::path EntryPath(const Key& key) const;
+
+    [[nodiscard]] bool Load(const Key& key, std::span<u8> output,
+                            std::span<BufferImageCopy> copies);
+
+    void Store(const Key& key, std::span<const u8> output, std::span<const BufferImageCopy> copies);
+
+    void TrimLocked();
+
+    bool is_enabled{false};
+    std::filesystem::path cache_dir;
+    u64 size_limit{};
+
+    std::mutex mutex;
+    std::map<Key, EntryInfo> entries;
+    u64 total_size{};
+    u64 use_counter{};
+
+    Common::ThreadWorker store_worker{1, "TextureDiskCache"};
+};
+
+} // namespace VideoCommon
@@ -1,22 +1,58 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
 #include <stb_dxt.h>
 #include <string.h>
 #include "common/alignment.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
 #include "video_core/textures/bcn.h"
 #include "video_core/textures/workers.h"
 
 namespace Tegra::Texture::BCN {
 
-using BCNCompressor = void(u8* block_output, const u8* block_input, bool any_alpha);
+namespace {
 
-template <u32 BytesPerBlock, bool ThresholdAlpha = false>
+using namespace Common::Literals;
+
+// The running totals are logged every time this much more memory has been saved
+constexpr u64 StatisticsLogInterval = 256_MiB;
+
+std::atomic<u64> total_texels;
+std::atomic<u64> total_input_bytes;
+std::atomic<u64> total_output_bytes;
+std::atomic<u64> total_encode_ns;
+
+void RecordStatistics(u64 texels, u64 output_bytes, std::chrono::nanoseconds elapsed) {
+    constexpr u64 bytes_per_px = 4;
+    const u64 input_bytes = texels * bytes_per_px;
+    total_texels += texels;
+    total_encode_ns += static_cast<u64>(elapsed.count());
+    const u64 saved_before = total_input_bytes.fetch_add(input_bytes) -
+                             total_output_bytes.fetch_add(output_bytes);
+    const u64 saved_after = saved_before + input_bytes - output_bytes;
+    if (saved_before / StatisticsLogInterval != saved_after / StatisticsLogInterval) {
+        const CompressionStatistics stats = GetCompressionStatistics();
+        LOG_INFO(HW_GPU, "ASTC recompression saved {} MiB of VRAM, encoding at {:.1f} MTexel/s",
+                 stats.SavedBytes() / 1_MiB, stats.MegaTexelsPerSecond());
+    }
+}
+
+} // Anonymous namespace
+
+template <u32 BytesPerBlock, bool ThresholdAlpha = false, typename Compressor>
 void CompressBCN(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                 std::span<uint8_t> output, BCNCompressor f) {
+                 std::span<uint8_t> output, Compressor f) {
     constexpr u8 alpha_threshold = 128;
     constexpr u32 bytes_per_px = 4;
     const u32 plane_dim = width * height;
+    const auto start = std::chrono::steady_clock::now();
 
     Common::ThreadWorker& workers{GetThreadWorkers()};
 
@@ -64,23 +100,371 @@ void CompressBCN(std::span<const uint8_t> data, uint32_t width, uint32_t height,
         }
         workers.WaitForRequests();
     }
+
+    const u64 num_blocks = u64{Common::DivideUp(width, 4U)} * Common::DivideUp(height, 4U) * depth;
+    RecordStatistics(u64{plane_dim} * depth, num_blocks * BytesPerBlock,
+                     std::chrono::steady_clock::now() - start);
+}
+
+namespace BC7 {
+
+// BC7 mode 6: a single subset with 7 bit RGBA endpoints, a p-bit per endpoint and 4 bit indices.
+// It is the mode that handles arbitrary RGBA blocks best on its own.
+
+constexpr std::array<s32, 16> Weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+using Texel = std::array<s32, 4>;
+using Color = std::array<float, 4>;
+using Block = std::array<Texel, 16>;
+
+struct Mode6Block {
+    std::array<std::array<u8, 4>, 2> endpoints;
+    std::array<u8, 2> pbits;
+    std::array<u8, 16> indices;
+    u32 error = std::numeric_limits<u32>::max();
+};
+
+Texel Unquantize(const std::array<u8, 4>& endpoint, u8 pbit) {
+    Texel texel;
+    for (size_t c = 0; c < 4; c++) {
+        texel[c] = (endpoint[c] << 1) | pbit;
+    }
+    return texel;
+}
+
+u32 Distance(const Texel& lhs, const Texel& rhs) {
+    u32 distance = 0;
+    for (size_t c = 0; c < 4; c++) {
+        const s32 delta = lhs[c] - rhs[c];
+        distance += static_cast<u32>(delta * delta);
+    }
+    return distance;
+}
+
+/// Quantizes an endpoint with the given p-bit, returns the squared error
+u32 QuantizeEndpoint(const Color& color, u8 pbit, std::array<u8, 4>& endpoint) {
+    float error = 0.0f;
+    for (size_t c = 0; c < 4; c++) {
+        const float value = std::clamp(color[c], 0.0f, 255.0f);
+        endpoint[c] = static_cast<u8>(std::clamp(std::lround((value - pbit) * 0.5f), 0L, 127L));
+        const float delta = static_cast<float>((endpoint[c] << 1) | pbit) - value;
+        error += delta * delta;
+    }
+    return static_cast<u32>(error);
+}
+
+/// Picks the indices of a block whose endpoints are already quantized and computes its error
+void AssignIndices(const Block& texels, bool refine_indices, Mode6Block& block) {
+    const Texel low = Unquantize(block.endpoints[0], block.pbits[0]);
+    const Texel high = Unquantize(block.endpoints[1], block.pbits[1]);
+
+    std::array<Texel, 16> palette;
+    for (size_t i = 0; i < palette.size(); i++) {
+        for (size_t c = 0; c < 4; c++) {
+            palette[i][c] = ((64 - Weights[i]) * low[c] + Weights[i] * high[c] + 32) >> 6;
+        }
+    }
+
+    Texel axis;
+    s32 axis_length = 0;
+    for (size_t c = 0; c < 4; c++) {
+        axis[c] = high[c] - low[c];
+        axis_length += axis[c] * axis[c];
+    }
+
+    block.error = 0;
+    for (size_t i = 0; i < texels.size(); i++) {
+        // Weights are close enough to evenly spaced to project onto the endpoint axis
+        s32 projected = 0;
+        if (axis_length > 0) {
+            s32 dot = 0;
+            for (size_t c = 0; c < 4; c++) {
+                dot += (texels[i][c] - low[c]) * axis[c];
+            }
+            projected = std::clamp((dot * 15 + axis_length / 2) / axis_length, 0, 15);
+        }
+        u8 best_index = static_cast<u8>(projected);
+        u32 best_distance = Distance(texels[i], palette[best_index]);
+        if (refine_indices) {
+            // Rounding or quantized endpoints can move the closest entry to a neighbour
+            for (const s32 index : {projected - 1, projected + 1}) {
+                if (index < 0 || index > 15) {
+                    continue;
+                }
+                const u32 distance = Distance(texels[i], palette[index]);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_index = static_cast<u8>(index);
+                }
+            }
+        }
+        block.indices[i] = best_index;
+        block.error += best_distance;
+    }
+}
+
+/// Quantizes a pair of endpoints and picks the indices that go with them
+Mode6Block Evaluate(const Block& texels, const Color& low, const Color& high, bool refine_indices,
+                    bool search_pbits) {
+    Mode6Block best;
+    if (search_pbits) {
+        for (u8 pbits = 0; pbits < 4; pbits++) {
+            Mode6Block block;
+            block.pbits = {static_cast<u8>(pbits & 1), static_cast<u8>(pbits >> 1)};
+            QuantizeEndpoint(low, block.pbits[0], block.endpoints[0]);
+            QuantizeEndpoint(high, block.pbits[1], block.endpoints[1]);
+            AssignIndices(texels, refine_indices, block);
+            if (block.error < best.error) {
+                best = block;
+            }
+        }
+        return best;
+    }
+
+    // Choose each p-bit on its own by the quantization error of its endpoint
+    const std::array<Color, 2> colors{low, high};
+    for (size_t i = 0; i < colors.size(); i++) {
+        std::array<u8, 4> even;
+        std::array<u8, 4> odd;
+        const bool use_odd =
+            QuantizeEndpoint(colors[i], 1, odd) < QuantizeEndpoint(colors[i], 0, even);
+        best.endpoints[i] = use_odd ? odd : even;
+        best.pbits[i] = use_odd ? 1 : 0;
+    }
+    AssignIndices(texels, refine_indices, best);
+    return best;
+}
+
+std::pair<Color, Color> BoundingBox(const Block& texels) {
+    Color low{255.0f, 255.0f, 255.0f, 255.0f};
+    Color high{};
+    for (const Texel& texel : texels) {
+        for (size_t c = 0; c < 4; c++) {
+            low[c] = std::min(low[c], static_cast<float>(texel[c]));
+            high[c] = std::max(high[c], static_cast<float>(texel[c]));
+        }
+    }
+    return {low, high};
+}
+
+/// Endpoints along the principal axis of the block, through its mean
+std::pair<Color, Color> PrincipalAxis(const Block& texels) {
+    Color mean{};
+    for (const Texel& texel : texels) {
+        for (size_t c = 0; c < 4; c++) {
+            mean[c] += static_cast<float>(texel[c]) / texels.size();
+        }
+    }
+    std::array<std::array<float, 4>, 4> covariance{};
+    for (const Texel& texel : texels) {
+        for (size_t a = 0; a < 4; a++) {
+            for (size_t b = 0; b < 4; b++) {
+                covariance[a][b] += (texel[a] - mean[a]) * (texel[b] - mean[b]);
+            }
+        }
+    }
+
+    // Power iteration, starting from the diagonal of the bounding box
+    const auto [box_low, box_high] = BoundingBox(texels);
+    Color axis;
+    for (size_t c = 0; c < 4; c++) {
+        axis[c] = box_high[c] - box_low[c];
+    }
+    for (u32 iteration = 0; iteration < 8; iteration++) {
+        Color next{};
+        float length = 0.0f;
+        for (size_t a = 0; a < 4; a++) {
+            for (size_t b = 0; b < 4; b++) {
+                next[a] += covariance[a][b] * axis[b];
+            }
+            length = std::max(length, std::abs(next[a]));
+        }
+        if (length == 0.0f) {
+            return {box_low, box_high};
+        }
+        for (size_t c = 0; c < 4; c++) {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    float min_t = std::numeric_limits<float>::max();
+    float max_t = std::numeric_limits<float>::lowest();
+    float axis_length = 0.0f;
+    for (size_t c = 0; c < 4; c++) {
+        axis_length += axis[c] * axis[c];
+    }
+    for (const Texel& texel : texels) {
+        float t = 0.0f;
+        for (size_t c = 0; c < 4; c++) {
+            t += (texel[c] - mean[c]) * axis[c];
+        }
+        min_t = std::min(min_t, t / axis_length);
+        max_t = std::max(max_t, t / axis_length);
+    }
+    Color low;
+    Color high;
+    for (size_t c = 0; c < 4; c++) {
+        low[c] = mean[c] + axis[c] * min_t;
+        high[c] = mean[c] + axis[c] * max_t;
+    }
+    return {low, high};
+}
+
+/// Least squares fit of the endpoints to the indices of a block
+bool RefineEndpoints(const Block& texels, const Mode6Block& block, Color& low, Color& high) {
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    Color low_sum{};
+    Color high_sum{};
+    for (size_t i = 0; i < texels.size(); i++) {
+        const float weight = Weights[block.indices[i]] / 64.0f;
+        const float inverse = 1.0f - weight;
+        aa += inverse * inverse;
+        ab += inverse * weight;
+        bb += weight * weight;
+        for (size_t c = 0; c < 4; c++) {
+            low_sum[c] += inverse * texels[i][c];
+            high_sum[c] += weight * texels[i][c];
+        }
+    }
+    const float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f) {
+        return false;
+    }
+    for (size_t c = 0; c < 4; c++) {
+        low[c] = (bb * low_sum[c] - ab * high_sum[c]) / determinant;
+        high[c] = (aa * high_sum[c] - ab * low_sum[c]) / determinant;
+    }
+    return true;
+}
+
+void Pack(Mode6Block block, u8* output) {
+    // The most significant bit of the first index is implicitly zero
+    if (block.indices[0] & 8) {
+        std::swap(block.endpoints[0], block.endpoints[1]);
+        std::swap(block.pbits[0], block.pbits[1]);
+        for (u8& index : block.indices) {
+            index = 15 - index;
+        }
+    }
+
+    std::array<u64, 2> bits{};
+    u32 position = 0;
+    const auto put = [&bits, &position](u64 value, u32 count) {
+        if (position < 64) {
+            bits[0] |= value << position;
+            if (position + count > 64) {
+                bits[1] |= value >> (64 - position);
+            }
+        } else {
+            bits[1] |= value << (position - 64);
+        }
+        position += count;
+    };
+
+    put(1 << 6, 7);
+    for (size_t c = 0; c < 4; c++) {
+        put(block.endpoints[0][c], 7);
+        put(block.endpoints[1][c], 7);
+    }
+    put(block.pbits[0], 1);
+    put(block.pbits[1], 1);
+    put(block.indices[0], 3);
+    for (size_t i = 1; i < block.indices.size(); i++) {
+        put(block.indices[i], 4);
+    }
+    memcpy(output, bits.data(), sizeof(bits));
+}
+
+template <Quality quality>
+void CompressBlock(u8* block_output, const u8* block_input) {
+    Block texels;
+    for (size_t i = 0; i < texels.size(); i++) {
+        for (size_t c = 0; c < 4; c++) {
+            texels[i][c] = block_input[i * 4 + c];
+        }
+    }
+
+    if constexpr (quality == Quality::Fast) {
+        const auto [low, high] = BoundingBox(texels);
+        Pack(Evaluate(texels, low, high, false, false), block_output);
+        return;
+    }
+
+    constexpr bool search_pbits = quality == Quality::High;
+    constexpr u32 refine_passes = quality == Quality::High ? 3 : 1;
+
+    auto [low, high] = PrincipalAxis(texels);
+    Mode6Block best = Evaluate(texels, low, high, true, search_pbits);
+    if constexpr (quality == Quality::High) {
+        const auto [box_low, box_high] = BoundingBox(texels);
+        const Mode6Block box = Evaluate(texels, box_low, box_high, true, search_pbits);
+        if (box.error < best.error) {
+            best = box;
+        }
+    }
+    for (u32 pass = 0; pass < refine_passes && best.error > 0; pass++) {
+        if (!RefineEndpoints(texels, best, low, high)) {
+            break;
+        }
+        const Mode6Block refined = Evaluate(texels, low, high, true, search_pbits);
+        if (refined.error >= best.error) {
+            break;
+        }
+        best = refined;
+    }
+    Pack(best, block_output);
 }
 
+} // namespace BC7
+
 void CompressBC1(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                 std::span<uint8_t> output) {
+                 std::span<uint8_t> output, Quality quality) {
+    const int mode = quality == Quality::High ? STB_DXT_HIGHQUAL : STB_DXT_NORMAL;
     CompressBCN<8, true>(data, width, height, depth, output,
-                         [](u8* block_output, const u8* block_input, bool any_alpha) {
-                             stb_compress_bc1_block(block_output, block_input, any_alpha,
-                                                    STB_DXT_NORMAL);
+                         [mode](u8* block_output, const u8* block_input, bool any_alpha) {
+                             stb_compress_bc1_block(block_output, block_input, any_alpha, mode);
                          });
 }
 
 void CompressBC3(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                 std::span<uint8_t> output) {
+                 std::span<uint8_t> output, Quality quality) {
+    const int mode = quality == Quality::High ? STB_DXT_HIGHQUAL : STB_DXT_NORMAL;
     CompressBCN<16, false>(data, width, height, depth, output,
-                           [](u8* block_output, const u8* block_input, bool any_alpha) {
-                               stb_compress_bc3_block(block_output, block_input, STB_DXT_NORMAL);
+                           [mode](u8* block_output, const u8* block_input, bool any_alpha) {
+                               stb_compress_bc3_block(block_output, block_input, mode);
                            });
 }
 
+void CompressBC7(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
+                 std::span<uint8_t> output, Quality quality) {
+    const auto compress = [&]<Quality q>() {
+        CompressBCN<16, false>(data, width, height, depth, output,
+                               [](u8* block_output, const u8* block_input, bool) {
+                                   BC7::CompressBlock<q>(block_output, block_input);
+                               });
+    };
+    switch (quality) {
+    case Quality::Fast:
+        compress.template operator()<Quality::Fast>();
+        break;
+    case Quality::High:
+        compress.template operator()<Quality::High>();
+        break;
+    default:
+        compress.template operator()<Quality::Balanced>();
+        break;
+    }
+}
+
+CompressionStatistics GetCompressionStatistics() {
+    return {
+        .texels = total_texels.load(std::memory_order_relaxed),
+        .input_bytes = total_input_bytes.load(std::memory_order_relaxed),
+        .output_bytes = total_output_bytes.load(std::memory_order_relaxed),
+        .encode_ns = total_encode_ns.load(std::memory_order_relaxed),
+    };
+}
+
 } // namespace Tegra::Texture::BCN
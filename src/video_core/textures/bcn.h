@@ -6,11 +6,39 @@
 #include <span>
 
 #include "common/common_types.h"
+#include "common/settings_enums.h"
 
 namespace Tegra::Texture::BCN {
 
-void CompressBC1(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output);
+using Quality = Settings::AstcRecompressionQuality;
 
-void CompressBC3(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output);
+/// Totals over every texture compressed so far
+struct CompressionStatistics {
+    u64 texels;
+    u64 input_bytes;
+    u64 output_bytes;
+    u64 encode_ns;
+
+    /// Video memory saved compared to keeping the uncompressed RGBA8 data
+    [[nodiscard]] u64 SavedBytes() const noexcept {
+        return input_bytes - output_bytes;
+    }
+
+    /// Encoded texels per second, in millions
+    [[nodiscard]] double MegaTexelsPerSecond() const noexcept {
+        return encode_ns == 0 ? 0.0 : static_cast<double>(texels) * 1000.0 / encode_ns;
+    }
+};
+
+void CompressBC1(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output,
+                 Quality quality = Quality::Fast);
+
+void CompressBC3(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output,
+                 Quality quality = Quality::Fast);
+
+void CompressBC7(std::span<const u8> data, u32 width, u32 height, u32 depth, std::span<u8> output,
+                 Quality quality = Quality::Balanced);
+
+[[nodiscard]] CompressionStatistics GetCompressionStatistics();
 
 } // namespace Tegra::Texture::BCN